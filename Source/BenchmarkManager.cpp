@@ -0,0 +1,606 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmarkmanager.cpp
+// ============
+// manage the performance measurements of the 3D scene code
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BenchmarkManager.h"
+#include "CameraPath.h"
+#include "CullingKernel.h"
+#include "SceneManager.h"
+#include "TransformCache.h"
+#include "ViewManager.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// declaration of global variables
+namespace
+{
+	// transformation values of one benchmark object
+	struct BENCH_TRANSFORM
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+	};
+
+	// get the elapsed milliseconds since the passed in time
+	double ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		std::chrono::duration<double, std::milli> elapsed =
+			std::chrono::steady_clock::now() - start;
+		return(elapsed.count());
+	}
+
+	// render one frame of the scene the way the main loop does,
+	// into the bound offscreen framebuffer without a window
+	void RenderBenchmarkFrame(
+		SceneManager* pSceneManager,
+		ViewManager* pViewManager,
+		GLFWwindow* pWindow)
+	{
+		glEnable(GL_DEPTH_TEST);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// the camera is only placed by the benchmark and never
+		// stepped, so the frame is viewed from its pose
+		pViewManager->PrepareSceneView(1.0f);
+		pSceneManager->RenderScene();
+
+		if (NULL != pWindow)
+		{
+			glfwSwapBuffers(pWindow);
+			glfwPollEvents();
+		}
+	}
+
+	// get a percentile of sorted times, as the smallest time
+	// that the passed in percent of the times are not above
+	double Percentile(const std::vector<double>& sorted, double percent)
+	{
+		if (sorted.empty() == true)
+		{
+			return(0.0);
+		}
+		int rank = (int)ceil(percent / 100.0 * sorted.size()) - 1;
+		rank = std::min(std::max(rank, 0), (int)sorted.size() - 1);
+		return(sorted[rank]);
+	}
+
+	// read a number of a benchmark result file, found by its key
+	// after the passed in object name - enough for the files
+	// written by the path benchmark, not for any JSON
+	bool ReadResultNumber(
+		const std::string& text,
+		const char* objectName,
+		const char* key,
+		double& value)
+	{
+		size_t position = 0;
+		if (NULL != objectName)
+		{
+			position = text.find(std::string("\"") + objectName + "\"");
+			if (position == std::string::npos)
+			{
+				return(false);
+			}
+		}
+		position = text.find(std::string("\"") + key + "\"", position);
+		if (position == std::string::npos)
+		{
+			return(false);
+		}
+		position = text.find(':', position);
+		if (position == std::string::npos)
+		{
+			return(false);
+		}
+
+		const char* pStart = text.c_str() + position + 1;
+		char* pEnd = NULL;
+		value = strtod(pStart, &pEnd);
+		return(pEnd != pStart);
+	}
+}
+
+/***********************************************************
+ *  BenchmarkManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BenchmarkManager::BenchmarkManager()
+{
+}
+
+/***********************************************************
+ *  ~BenchmarkManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+BenchmarkManager::~BenchmarkManager()
+{
+}
+
+/***********************************************************
+ *  RunTransformBenchmark()
+ *
+ *  This method is used for measuring the per-frame matrix
+ *  work for the passed in number of objects.  The first
+ *  measurement rebuilds every matrix each frame, the way
+ *  SetTransformations() does, and the others use the
+ *  transform cache with a static scene and with one percent
+ *  of the objects moving every frame.
+ ***********************************************************/
+void BenchmarkManager::RunTransformBenchmark(int objectCount, int frameCount)
+{
+	std::vector<BENCH_TRANSFORM> objects(objectCount);
+	std::mt19937 random(330);
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	TransformCache cache;
+	float checksum = 0.0f;
+
+	// create the same set of objects for every measurement
+	for (int i = 0; i < objectCount; i++)
+	{
+		objects[i].scaleXYZ = glm::vec3(scale(random), scale(random), scale(random));
+		objects[i].rotationDegrees = glm::vec3(angle(random), angle(random), angle(random));
+		objects[i].positionXYZ = glm::vec3(position(random), position(random), position(random));
+		cache.AddTransform(
+			objects[i].scaleXYZ,
+			objects[i].rotationDegrees.x,
+			objects[i].rotationDegrees.y,
+			objects[i].rotationDegrees.z,
+			objects[i].positionXYZ);
+	}
+
+	// rebuild every matrix on every frame
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		for (int i = 0; i < objectCount; i++)
+		{
+			glm::mat4 model = TransformCache::ComputeMatrix(
+				objects[i].scaleXYZ,
+				objects[i].rotationDegrees.x,
+				objects[i].rotationDegrees.y,
+				objects[i].rotationDegrees.z,
+				objects[i].positionXYZ);
+			checksum += model[3][0];
+		}
+	}
+	double rebuildMs = ElapsedMilliseconds(start) / frameCount;
+
+	// the first update calculates every matrix a single time
+	start = std::chrono::steady_clock::now();
+	cache.UpdateTransforms();
+	double firstUpdateMs = ElapsedMilliseconds(start);
+
+	// nothing moves, so only the cached matrices are read
+	start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		cache.UpdateTransforms();
+		for (int i = 0; i < objectCount; i++)
+		{
+			checksum += cache.GetWorldMatrix(i)[3][0];
+		}
+	}
+	double staticMs = ElapsedMilliseconds(start) / frameCount;
+
+	// one percent of the objects move every frame
+	int movingCount = objectCount / 100;
+	start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		for (int i = 0; i < movingCount; i++)
+		{
+			int index = (frame * movingCount + i) % objectCount;
+			cache.SetPosition(index, objects[index].positionXYZ + glm::vec3(0.0f, 0.01f * frame, 0.0f));
+		}
+		cache.UpdateTransforms();
+		for (int i = 0; i < objectCount; i++)
+		{
+			checksum += cache.GetWorldMatrix(i)[3][0];
+		}
+	}
+	double movingMs = ElapsedMilliseconds(start) / frameCount;
+
+	std::cout << "Transform benchmark: " << objectCount << " objects, " << frameCount << " frames" << std::endl;
+	std::cout << "  rebuild every frame:      " << rebuildMs << " ms/frame" << std::endl;
+	std::cout << "  cache first update:       " << firstUpdateMs << " ms" << std::endl;
+	std::cout << "  cache, static scene:      " << staticMs << " ms/frame" << std::endl;
+	std::cout << "  cache, " << movingCount << " moving objects: " << movingMs << " ms/frame" << std::endl;
+	if (staticMs > 0.0)
+	{
+		std::cout << "  static scene speedup:     " << rebuildMs / staticMs << "x" << std::endl;
+	}
+	// printing the checksum keeps the compiler from removing the work
+	std::cout << "  checksum: " << checksum << std::endl;
+}
+
+/***********************************************************
+ *  RunCullingBenchmark()
+ *
+ *  This method is used for measuring how many bounding boxes
+ *  each culling kernel tests per microsecond, from 100 000 to
+ *  1 000 000 boxes spread around a camera.  Each measurement
+ *  keeps the fastest of the repeats, and the box by box test
+ *  of the Frustum class is measured as the reference.
+ ***********************************************************/
+void BenchmarkManager::RunCullingBenchmark(int repeatCount)
+{
+	const int objectCounts[] = { 100000, 250000, 500000, 1000000 };
+	const int sizeCount = sizeof(objectCounts) / sizeof(objectCounts[0]);
+	std::mt19937 random(330);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> size(0.5f, 4.0f);
+	CullingKernel kernel;
+	CullingKernel::KERNEL_TYPE bestKernel = CullingKernel::DetectBestKernel();
+	Frustum frustum;
+
+	// the camera sits in the middle of the boxes, so roughly one
+	// box in eight is inside the view
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	frustum.ExtractPlanes(projection * view);
+
+	std::cout << "Culling benchmark: best of " << repeatCount << " runs, "
+		<< CullingKernel::GetKernelName(bestKernel) << " is the fastest supported kernel" << std::endl;
+
+	for (int s = 0; s < sizeCount; s++)
+	{
+		int objectCount = objectCounts[s];
+		std::vector<BOUNDING_BOX> boxes(objectCount);
+		CullingKernel::BOUNDS_SOA bounds;
+		std::vector<unsigned char> visible(objectCount);
+
+		CullingKernel::ResizeBounds(bounds, objectCount);
+		for (int i = 0; i < objectCount; i++)
+		{
+			glm::vec3 center(position(random), position(random), position(random));
+			glm::vec3 extent(size(random), size(random), size(random));
+			boxes[i].minimum = center - extent;
+			boxes[i].maximum = center + extent;
+			CullingKernel::SetBounds(bounds, i, boxes[i]);
+		}
+
+		std::cout << "  " << objectCount << " objects:" << std::endl;
+
+		// the reference tests one box at a time
+		int referenceCount = 0;
+		double bestMs = 0.0;
+		for (int r = 0; r < repeatCount; r++)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			referenceCount = 0;
+			for (int i = 0; i < objectCount; i++)
+			{
+				if (frustum.TestBox(boxes[i]) != Frustum::CULL_OUTSIDE)
+				{
+					referenceCount++;
+				}
+			}
+			double elapsedMs = ElapsedMilliseconds(start);
+			if ((r == 0) || (elapsedMs < bestMs))
+			{
+				bestMs = elapsedMs;
+			}
+		}
+		std::cout << "    Frustum::TestBox: " << objectCount / (bestMs * 1000.0)
+			<< " objects/us, " << referenceCount << " visible" << std::endl;
+
+		for (int k = CullingKernel::KERNEL_SCALAR; k <= bestKernel; k++)
+		{
+			int visibleCount = 0;
+
+			kernel.SetKernel((CullingKernel::KERNEL_TYPE)k);
+			for (int r = 0; r < repeatCount; r++)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				visibleCount = kernel.Cull(frustum, bounds, 0, objectCount, &visible[0]);
+				double elapsedMs = ElapsedMilliseconds(start);
+				if ((r == 0) || (elapsedMs < bestMs))
+				{
+					bestMs = elapsedMs;
+				}
+			}
+
+			std::cout << "    " << CullingKernel::GetKernelName(kernel.GetKernel()) << " kernel: "
+				<< objectCount / (bestMs * 1000.0) << " objects/us, " << visibleCount << " visible";
+			if (visibleCount != referenceCount)
+			{
+				std::cout << " - does not match the reference";
+			}
+			std::cout << std::endl;
+		}
+	}
+}
+
+/***********************************************************
+ *  RunShadowBenchmark()
+ *
+ *  This method is used for rendering the scene for the passed
+ *  in number of frames with each shadow setting, from no
+ *  shadows up to four cascades of large shadow maps.  The
+ *  shadow pass is reported on its own, both as the CPU time
+ *  spent submitting it and as the GPU time measured with its
+ *  timer queries, next to the time of the whole frame.  The
+ *  swap interval is set to 0 so the display does not limit
+ *  the frame rate.
+ ***********************************************************/
+void BenchmarkManager::RunShadowBenchmark(
+	SceneManager* pSceneManager,
+	ViewManager* pViewManager,
+	GLFWwindow* pWindow,
+	int frameCount)
+{
+	const int resolutions[] = { 1024, 2048, 4096 };
+	const int resolutionCount = sizeof(resolutions) / sizeof(resolutions[0]);
+	// frames rendered before measuring, so the shadow maps are
+	// created and the timer query results have arrived
+	const int warmupFrames = 30;
+
+	if ((NULL == pSceneManager) || (NULL == pViewManager) || (NULL == pWindow) || (frameCount <= 0))
+	{
+		return;
+	}
+
+	glfwSwapInterval(0);
+	std::cout << "Shadow benchmark: " << frameCount << " frames per setting" << std::endl;
+
+	// the first setting has no shadows at all, as the reference
+	for (int cascadeCount = 0; cascadeCount <= ShadowCascades::MAX_CASCADES; cascadeCount++)
+	{
+		for (int r = 0; r < resolutionCount; r++)
+		{
+			if ((cascadeCount == 0) && (r > 0))
+			{
+				break;
+			}
+
+			pSceneManager->SetShadowSettings(resolutions[r], cascadeCount);
+			for (int frame = 0; frame < warmupFrames; frame++)
+			{
+				RenderBenchmarkFrame(pSceneManager, pViewManager, pWindow);
+			}
+
+			double shadowCpuMs = 0.0;
+			double shadowGpuMs = 0.0;
+			int shadowDrawCalls = 0;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int frame = 0; frame < frameCount; frame++)
+			{
+				RenderBenchmarkFrame(pSceneManager, pViewManager, pWindow);
+
+				const SceneManager::RENDER_STATS& stats = pSceneManager->GetRenderStats();
+				shadowCpuMs += stats.shadowPassCpuMs;
+				shadowGpuMs += stats.shadowPassGpuMs;
+				shadowDrawCalls += stats.shadowDrawCalls;
+			}
+			double frameMs = ElapsedMilliseconds(start) / frameCount;
+
+			if (cascadeCount == 0)
+			{
+				std::cout << "  no shadows: ";
+			}
+			else
+			{
+				std::cout << "  " << cascadeCount << " x " << resolutions[r] << " shadow maps: ";
+			}
+			std::cout << frameMs << " ms/frame, shadow pass "
+				<< shadowCpuMs / frameCount << " ms CPU, "
+				<< shadowGpuMs / frameCount << " ms GPU, "
+				<< shadowDrawCalls / frameCount << " draw calls" << std::endl;
+
+			if (glfwWindowShouldClose(pWindow))
+			{
+				return;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  RunPathBenchmark()
+ *
+ *  This method is used for replaying a camera path over the
+ *  passed in number of frames and measuring the time of each
+ *  frame, with the scene simulation taking one fixed step per
+ *  frame so every run renders the same frames.  Each frame
+ *  waits for the GPU to finish, so its time covers the whole
+ *  frame and not only the CPU work of submitting it.
+ *
+ *  The percentiles of the frame times are written as JSON to
+ *  the output file.  When a baseline file from an earlier run
+ *  is passed in, the average, p50, p95 and p99 are checked
+ *  against it, and any of them more than the threshold
+ *  percent above the baseline fails the benchmark.
+ ***********************************************************/
+bool BenchmarkManager::RunPathBenchmark(
+	SceneManager* pSceneManager,
+	ViewManager* pViewManager,
+	GLFWwindow* pWindow,
+	const CameraPath& cameraPath,
+	int frameCount,
+	const char* outputFile,
+	const char* baselineFile,
+	float thresholdPercent)
+{
+	// frames rendered before measuring, so the GPU resources are
+	// created and the caches are warm
+	const int warmupFrames = 60;
+	const char* checkedMetrics[] = { "avg", "p50", "p95", "p99" };
+	const int checkedMetricCount = sizeof(checkedMetrics) / sizeof(checkedMetrics[0]);
+
+	if ((NULL == pSceneManager) || (NULL == pViewManager) || (frameCount <= 0))
+	{
+		return(false);
+	}
+
+	if (NULL != pWindow)
+	{
+		glfwSwapInterval(0);
+	}
+	std::cout << "Path benchmark: " << frameCount << " frames, "
+		<< pSceneManager->GetRenderItemCount() << " objects, "
+		<< cameraPath.GetKeyCount() << " camera keys" << std::endl;
+
+	glm::vec3 position;
+	glm::vec3 target;
+	cameraPath.GetPose(0, frameCount, position, target);
+	pViewManager->SetCameraPose(position, target);
+	for (int frame = 0; frame < warmupFrames; frame++)
+	{
+		RenderBenchmarkFrame(pSceneManager, pViewManager, pWindow);
+	}
+	glFinish();
+
+	std::vector<double> frameTimes;
+	double drawCalls = 0.0;
+	frameTimes.reserve(frameCount);
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		cameraPath.GetPose(frame, frameCount, position, target);
+		pViewManager->SetCameraPose(position, target);
+		RenderBenchmarkFrame(pSceneManager, pViewManager, pWindow);
+		glFinish();
+
+		frameTimes.push_back(ElapsedMilliseconds(start));
+		drawCalls += pSceneManager->GetRenderStats().drawCalls;
+
+		if ((NULL != pWindow) && (glfwWindowShouldClose(pWindow)))
+		{
+			std::cout << "Path benchmark stopped early" << std::endl;
+			return(false);
+		}
+	}
+
+	std::vector<double> sorted = frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+	double totalMs = 0.0;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		totalMs += sorted[i];
+	}
+
+	double values[] = {
+		totalMs / frameCount,
+		Percentile(sorted, 50.0),
+		Percentile(sorted, 95.0),
+		Percentile(sorted, 99.0) };
+
+	// compare with the baseline, when there is one
+	bool bPassed = true;
+	std::ostringstream checks;
+	bool bBaseline = (NULL != baselineFile) && (baselineFile[0] != '\0');
+	if (bBaseline == true)
+	{
+		std::ifstream file(baselineFile);
+		if (file.is_open() == false)
+		{
+			std::cout << "Could not open baseline:" << baselineFile << std::endl;
+		}
+		std::stringstream baseline;
+		baseline << file.rdbuf();
+		std::string baselineText = baseline.str();
+
+		double baselineObjects = 0.0;
+		if ((ReadResultNumber(baselineText, NULL, "scene_objects", baselineObjects) == true) &&
+			((int)baselineObjects != pSceneManager->GetRenderItemCount()))
+		{
+			std::cout << "WARNING: the baseline was measured with " << (int)baselineObjects << " objects" << std::endl;
+		}
+
+		for (int m = 0; m < checkedMetricCount; m++)
+		{
+			double baselineMs = 0.0;
+			if (ReadResultNumber(baselineText, "frame_ms", checkedMetrics[m], baselineMs) == false)
+			{
+				std::cout << "Could not read " << checkedMetrics[m] << " from baseline:" << baselineFile << std::endl;
+				bPassed = false;
+				continue;
+			}
+
+			double limitMs = baselineMs * (1.0 + thresholdPercent / 100.0);
+			bool bCheckPassed = (values[m] <= limitMs);
+			bPassed = bPassed && bCheckPassed;
+
+			if (checks.tellp() > 0)
+			{
+				checks << ",\n";
+			}
+			checks << "    {\"metric\": \"" << checkedMetrics[m]
+				<< "\", \"value\": " << values[m]
+				<< ", \"baseline\": " << baselineMs
+				<< ", \"limit\": " << limitMs
+				<< ", \"pass\": " << ((bCheckPassed == true) ? "true" : "false") << "}";
+			std::cout << "  " << checkedMetrics[m] << ": " << values[m] << " ms, baseline "
+				<< baselineMs << " ms, limit " << limitMs << " ms - "
+				<< ((bCheckPassed == true) ? "pass" : "FAIL") << std::endl;
+		}
+	}
+
+	std::ostringstream result;
+	result << "{\n"
+		<< "  \"benchmark\": \"camera_path\",\n"
+		<< "  \"scene_objects\": " << pSceneManager->GetRenderItemCount() << ",\n"
+		<< "  \"camera_keys\": " << cameraPath.GetKeyCount() << ",\n"
+		<< "  \"frames\": " << frameCount << ",\n"
+		<< "  \"warmup_frames\": " << warmupFrames << ",\n"
+		<< "  \"frame_ms\": {\"min\": " << sorted.front()
+		<< ", \"avg\": " << values[0]
+		<< ", \"p50\": " << values[1]
+		<< ", \"p90\": " << Percentile(sorted, 90.0)
+		<< ", \"p95\": " << values[2]
+		<< ", \"p99\": " << values[3]
+		<< ", \"max\": " << sorted.back() << "},\n"
+		<< "  \"avg_fps\": " << 1000.0 / values[0] << ",\n"
+		<< "  \"avg_draw_calls\": " << drawCalls / frameCount << ",\n"
+		<< "  \"threshold_percent\": " << thresholdPercent << ",\n"
+		<< "  \"checks\": [\n" << checks.str() << ((checks.tellp() > 0) ? "\n" : "") << "  ],\n"
+		<< "  \"pass\": " << ((bPassed == true) ? "true" : "false") << "\n"
+		<< "}\n";
+
+	std::cout << "  frame times: avg " << values[0] << " ms, p50 " << values[1]
+		<< " ms, p95 " << values[2] << " ms, p99 " << values[3] << " ms" << std::endl;
+
+	if ((NULL != outputFile) && (outputFile[0] != '\0'))
+	{
+		std::ofstream file(outputFile);
+		if (file.is_open() == false)
+		{
+			std::cout << "Could not write benchmark result:" << outputFile << std::endl;
+			return(false);
+		}
+		file << result.str();
+		std::cout << "INFO: wrote benchmark result to " << outputFile << std::endl;
+	}
+
+	if (bBaseline == true)
+	{
+		std::cout << "Path benchmark " << ((bPassed == true) ? "passed" : "FAILED")
+			<< " against baseline " << baselineFile << std::endl;
+	}
+
+	return(bPassed);
+}
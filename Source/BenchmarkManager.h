@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmarkmanager.h
+// ============
+// manage the performance measurements of the 3D scene code
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class SceneManager;
+class ViewManager;
+class CameraPath;
+struct GLFWwindow;
+
+/***********************************************************
+ *  BenchmarkManager
+ *
+ *  This class contains the code for measuring the cost of
+ *  the CPU side scene work, so that changes to the render
+ *  code can be compared before and after.
+ ***********************************************************/
+class BenchmarkManager
+{
+public:
+	// constructor
+	BenchmarkManager();
+	// destructor
+	~BenchmarkManager();
+
+	// compare the per-frame matrix work with and without
+	// the transform cache
+	void RunTransformBenchmark(int objectCount, int frameCount);
+	// compare the frustum culling kernels over growing numbers
+	// of bounding boxes
+	void RunCullingBenchmark(int repeatCount);
+	// compare the time of the shadow pass and of the whole frame
+	// over a range of shadow map sizes and cascade counts
+	void RunShadowBenchmark(
+		SceneManager* pSceneManager,
+		ViewManager* pViewManager,
+		GLFWwindow* pWindow,
+		int frameCount);
+	// replay a camera path over the scene and measure the frame
+	// times, comparing their percentiles with a stored baseline -
+	// returns false when one is over its threshold
+	bool RunPathBenchmark(
+		SceneManager* pSceneManager,
+		ViewManager* pViewManager,
+		GLFWwindow* pWindow,
+		const CameraPath& cameraPath,
+		int frameCount,
+		const char* outputFile,
+		const char* baselineFile,
+		float thresholdPercent);
+};
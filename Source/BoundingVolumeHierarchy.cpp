@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumehierarchy.cpp
+// ============
+// organize the bounds of the scene objects for fast culling
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// a node holding this many objects or fewer is a leaf - the
+	// objects of a leaf are tested by the culling kernel, which
+	// handles 8 boxes at a time
+	const int g_MaxLeafObjects = 16;
+
+	// orders object indices by the center of their bounds
+	// along one axis
+	struct CENTER_ORDER
+	{
+		const std::vector<glm::vec3>* pCenters;
+		int axis;
+
+		bool operator()(int a, int b) const
+		{
+			return((*pCenters)[a][axis] < (*pCenters)[b][axis]);
+		}
+	};
+
+	// grow a box so that it also holds another box
+	void GrowBox(BOUNDING_BOX& box, const BOUNDING_BOX& other)
+	{
+		box.minimum = glm::min(box.minimum, other.minimum);
+		box.maximum = glm::max(box.maximum, other.maximum);
+	}
+}
+
+/***********************************************************
+ *  BoundingVolumeHierarchy()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+{
+}
+
+/***********************************************************
+ *  ~BoundingVolumeHierarchy()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for building the tree over the passed
+ *  in object bounds.  The index of each bounds is the object
+ *  index that is marked when culling.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Build(const std::vector<BOUNDING_BOX>& bounds)
+{
+	std::vector<glm::vec3> centers(bounds.size());
+
+	Clear();
+	if (bounds.empty() == true)
+	{
+		return;
+	}
+
+	m_objectIndices.resize(bounds.size());
+	for (size_t i = 0; i < bounds.size(); i++)
+	{
+		m_objectIndices[i] = (int)i;
+		centers[i] = (bounds[i].minimum + bounds[i].maximum) * 0.5f;
+	}
+
+	// a binary tree never has more than twice as many nodes as
+	// it has objects
+	m_nodes.reserve(bounds.size() * 2);
+	BuildNode(bounds, centers, 0, (int)bounds.size());
+
+	StoreObjectBounds(bounds);
+}
+
+/***********************************************************
+ *  BuildNode()
+ *
+ *  This method is used for building the node for a range of
+ *  the object index list.  The range is split in half along
+ *  the axis where the object centers are spread the most.
+ ***********************************************************/
+int BoundingVolumeHierarchy::BuildNode(
+	const std::vector<BOUNDING_BOX>& bounds,
+	const std::vector<glm::vec3>& centers,
+	int firstObject,
+	int objectCount)
+{
+	BVH_NODE node;
+	glm::vec3 centerMinimum = centers[m_objectIndices[firstObject]];
+	glm::vec3 centerMaximum = centerMinimum;
+
+	node.bounds = bounds[m_objectIndices[firstObject]];
+	for (int i = firstObject + 1; i < firstObject + objectCount; i++)
+	{
+		GrowBox(node.bounds, bounds[m_objectIndices[i]]);
+		centerMinimum = glm::min(centerMinimum, centers[m_objectIndices[i]]);
+		centerMaximum = glm::max(centerMaximum, centers[m_objectIndices[i]]);
+	}
+	node.rightChild = -1;
+	node.firstObject = firstObject;
+	node.objectCount = objectCount;
+
+	int nodeIndex = (int)m_nodes.size();
+	m_nodes.push_back(node);
+
+	if (objectCount <= g_MaxLeafObjects)
+	{
+		return(nodeIndex);
+	}
+
+	glm::vec3 spread = centerMaximum - centerMinimum;
+	CENTER_ORDER order;
+	order.pCenters = &centers;
+	order.axis = 0;
+	if (spread.y > spread[order.axis])
+	{
+		order.axis = 1;
+	}
+	if (spread.z > spread[order.axis])
+	{
+		order.axis = 2;
+	}
+
+	int leftCount = objectCount / 2;
+	std::nth_element(
+		m_objectIndices.begin() + firstObject,
+		m_objectIndices.begin() + firstObject + leftCount,
+		m_objectIndices.begin() + firstObject + objectCount,
+		order);
+
+	BuildNode(bounds, centers, firstObject, leftCount);
+	int rightChild = BuildNode(bounds, centers, firstObject + leftCount, objectCount - leftCount);
+
+	// the node vector may have grown, so the node is found again
+	m_nodes[nodeIndex].rightChild = rightChild;
+	m_nodes[nodeIndex].objectCount = 0;
+
+	return(nodeIndex);
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used for updating the bounds of every node
+ *  after objects have moved, without changing the shape of
+ *  the tree.  Children are always stored after their parent,
+ *  so walking the nodes backwards visits children first.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Refit(const std::vector<BOUNDING_BOX>& bounds)
+{
+	StoreObjectBounds(bounds);
+
+	for (int n = (int)m_nodes.size() - 1; n >= 0; n--)
+	{
+		BVH_NODE& node = m_nodes[n];
+
+		if (node.rightChild < 0)
+		{
+			node.bounds = bounds[m_objectIndices[node.firstObject]];
+			for (int i = node.firstObject + 1; i < node.firstObject + node.objectCount; i++)
+			{
+				GrowBox(node.bounds, bounds[m_objectIndices[i]]);
+			}
+		}
+		else
+		{
+			node.bounds = m_nodes[n + 1].bounds;
+			GrowBox(node.bounds, m_nodes[node.rightChild].bounds);
+		}
+	}
+}
+
+/***********************************************************
+ *  Cull()
+ *
+ *  This method is used for marking the objects that are at
+ *  least partly inside the frustum as visible.  The visible
+ *  list must be cleared by the caller and hold one entry for
+ *  every object.  The objects are tested with the bounds
+ *  passed to the last Build() or Refit().
+ ***********************************************************/
+void BoundingVolumeHierarchy::Cull(
+	const Frustum& frustum,
+	std::vector<char>& visible) const
+{
+	if (m_nodes.empty() == true)
+	{
+		return;
+	}
+
+	int stack[64];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		int n = stack[--stackSize];
+		const BVH_NODE& node = m_nodes[n];
+		Frustum::CULL_RESULT result = frustum.TestBox(node.bounds);
+
+		if (result == Frustum::CULL_OUTSIDE)
+		{
+			continue;
+		}
+		if (result == Frustum::CULL_INSIDE)
+		{
+			MarkVisible(n, visible);
+			continue;
+		}
+
+		if (node.rightChild < 0)
+		{
+			unsigned char leafVisible[g_MaxLeafObjects];
+
+			m_cullingKernel.Cull(frustum, m_objectBounds, node.firstObject, node.objectCount, leafVisible);
+			for (int i = 0; i < node.objectCount; i++)
+			{
+				if (leafVisible[i] != 0)
+				{
+					visible[m_objectIndices[node.firstObject + i]] = 1;
+				}
+			}
+		}
+		else
+		{
+			// the tree is balanced, so its depth is far below the
+			// size of the stack
+			stack[stackSize++] = node.rightChild;
+			stack[stackSize++] = n + 1;
+		}
+	}
+}
+
+/***********************************************************
+ *  MarkVisible()
+ *
+ *  This method is used for marking every object below a node
+ *  as visible.  The objects of a subtree are one continuous
+ *  range of the object index list.
+ ***********************************************************/
+void BoundingVolumeHierarchy::MarkVisible(int node, std::vector<char>& visible) const
+{
+	int first = node;
+	int last = node;
+
+	// the leftmost and rightmost leaves bound the range
+	while (m_nodes[first].rightChild >= 0)
+	{
+		first = first + 1;
+	}
+	while (m_nodes[last].rightChild >= 0)
+	{
+		last = m_nodes[last].rightChild;
+	}
+
+	int endObject = m_nodes[last].firstObject + m_nodes[last].objectCount;
+	for (int i = m_nodes[first].firstObject; i < endObject; i++)
+	{
+		visible[m_objectIndices[i]] = 1;
+	}
+}
+
+/***********************************************************
+ *  StoreObjectBounds()
+ *
+ *  This method is used for copying the object bounds into the
+ *  arrays tested by the culling kernel, in the order of the
+ *  object index list.
+ ***********************************************************/
+void BoundingVolumeHierarchy::StoreObjectBounds(const std::vector<BOUNDING_BOX>& bounds)
+{
+	CullingKernel::ResizeBounds(m_objectBounds, (int)m_objectIndices.size());
+	for (size_t i = 0; i < m_objectIndices.size(); i++)
+	{
+		CullingKernel::SetBounds(m_objectBounds, (int)i, bounds[m_objectIndices[i]]);
+	}
+}
+
+/***********************************************************
+ *  GetNodeCount()
+ *
+ *  This method is used for getting the number of nodes in
+ *  the tree.
+ ***********************************************************/
+int BoundingVolumeHierarchy::GetNodeCount() const
+{
+	return((int)m_nodes.size());
+}
+
+/***********************************************************
+ *  GetCullingKernel()
+ *
+ *  This method is used for getting the kernel that tests the
+ *  objects of a leaf, so a different kernel can be chosen.
+ ***********************************************************/
+CullingKernel& BoundingVolumeHierarchy::GetCullingKernel()
+{
+	return(m_cullingKernel);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing the tree.
+ ***********************************************************/
+void BoundingVolumeHierarchy::Clear()
+{
+	m_nodes.clear();
+	m_objectIndices.clear();
+	CullingKernel::ResizeBounds(m_objectBounds, 0);
+}
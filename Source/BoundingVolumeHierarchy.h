@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// boundingvolumehierarchy.h
+// ============
+// organize the bounds of the scene objects for fast culling
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CullingKernel.h"
+#include "Frustum.h"
+
+#include <vector>
+
+/***********************************************************
+ *  BoundingVolumeHierarchy
+ *
+ *  This class builds a tree of bounding boxes over the bounds
+ *  of the scene objects.  Culling walks the tree from the top,
+ *  so a whole group of objects outside of the view frustum is
+ *  rejected with a single test, and a group entirely inside is
+ *  accepted without testing its objects.
+ ***********************************************************/
+class BoundingVolumeHierarchy
+{
+public:
+	// constructor
+	BoundingVolumeHierarchy();
+	// destructor
+	~BoundingVolumeHierarchy();
+
+private:
+	// one node of the tree - the nodes are stored depth first,
+	// so the left child of a node always directly follows it
+	struct BVH_NODE
+	{
+		BOUNDING_BOX bounds;
+		// index of the right child, -1 for a leaf
+		int rightChild;
+		// range of the leaf objects in the object index list
+		int firstObject;
+		int objectCount;
+	};
+
+	// nodes of the tree, the root first
+	std::vector<BVH_NODE> m_nodes;
+	// object indices, ordered so each leaf owns a range
+	std::vector<int> m_objectIndices;
+	// object bounds in the order of the object index list, so
+	// the objects of a leaf are tested together by the kernel
+	CullingKernel::BOUNDS_SOA m_objectBounds;
+	// vector kernel used for testing the objects of a leaf
+	CullingKernel m_cullingKernel;
+
+	// build the node for a range of the object index list
+	int BuildNode(
+		const std::vector<BOUNDING_BOX>& bounds,
+		const std::vector<glm::vec3>& centers,
+		int firstObject,
+		int objectCount);
+	// mark every object below a node as visible
+	void MarkVisible(int node, std::vector<char>& visible) const;
+	// copy the object bounds into the kernel arrays
+	void StoreObjectBounds(const std::vector<BOUNDING_BOX>& bounds);
+
+public:
+	// build the tree over the passed in object bounds
+	void Build(const std::vector<BOUNDING_BOX>& bounds);
+	// update the node bounds after objects have moved
+	void Refit(const std::vector<BOUNDING_BOX>& bounds);
+	// mark the objects that are inside the frustum as visible
+	void Cull(
+		const Frustum& frustum,
+		std::vector<char>& visible) const;
+
+	// get the number of nodes in the tree
+	int GetNodeCount() const;
+	// get the kernel used for testing the objects of a leaf
+	CullingKernel& GetCullingKernel();
+	// remove the tree
+	void Clear();
+};
@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerapath.cpp
+// ============
+// record, load and replay the path of the scene camera
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraPath.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// declaration of global variables
+namespace
+{
+	// orbit used as the camera path when no keys are loaded
+	const glm::vec3 g_OrbitTarget(0.0f, 1.5f, 2.0f);
+	const float g_OrbitRadius = 14.0f;
+	const float g_OrbitHeight = 6.0f;
+}
+
+/***********************************************************
+ *  CameraPath()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CameraPath::CameraPath()
+{
+}
+
+/***********************************************************
+ *  ~CameraPath()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+CameraPath::~CameraPath()
+{
+	m_keys.clear();
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading the camera path from a
+ *  text file.  Every line holds one key as six numbers, the
+ *  position followed by the target of the camera, and lines
+ *  starting with # are comments.
+ ***********************************************************/
+bool CameraPath::Load(const char* filename)
+{
+	std::ifstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not open camera path:" << filename << std::endl;
+		return(false);
+	}
+
+	m_keys.clear();
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if ((line.empty() == true) || (line[0] == '#'))
+		{
+			continue;
+		}
+
+		std::istringstream values(line);
+		CAMERA_KEY key;
+		if (values >> key.position.x >> key.position.y >> key.position.z
+			>> key.target.x >> key.target.y >> key.target.z)
+		{
+			m_keys.push_back(key);
+		}
+	}
+
+	if (m_keys.empty() == true)
+	{
+		std::cout << "No camera keys in camera path:" << filename << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing the camera path to a text
+ *  file in the format read by Load().
+ ***********************************************************/
+bool CameraPath::Save(const char* filename) const
+{
+	std::ofstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not write camera path:" << filename << std::endl;
+		return(false);
+	}
+
+	file << "# position x y z, target x y z" << std::endl;
+	for (size_t i = 0; i < m_keys.size(); i++)
+	{
+		const CAMERA_KEY& key = m_keys[i];
+		file << key.position.x << " " << key.position.y << " " << key.position.z << " "
+			<< key.target.x << " " << key.target.y << " " << key.target.z << std::endl;
+	}
+
+	std::cout << "INFO: wrote " << m_keys.size() << " camera keys to " << filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddKey()
+ *
+ *  This method is used for adding a key to the end of the
+ *  camera path, such as for recording the camera every frame.
+ ***********************************************************/
+void CameraPath::AddKey(const glm::vec3& position, const glm::vec3& target)
+{
+	CAMERA_KEY key;
+	key.position = position;
+	key.target = target;
+	m_keys.push_back(key);
+}
+
+/***********************************************************
+ *  GetKeyCount()
+ *
+ *  This method is used for getting the number of keys of the
+ *  camera path.
+ ***********************************************************/
+int CameraPath::GetKeyCount() const
+{
+	return((int)m_keys.size());
+}
+
+/***********************************************************
+ *  GetPose()
+ *
+ *  This method is used for getting the camera position and
+ *  target of a frame.  The keys of the camera path are spread
+ *  evenly over the frames, and the frames between two keys
+ *  blend them linearly.  Without keys the camera circles the
+ *  scene once over all the frames.
+ ***********************************************************/
+void CameraPath::GetPose(int frame, int frameCount, glm::vec3& position, glm::vec3& target) const
+{
+	float progress = 0.0f;
+	if (frameCount > 1)
+	{
+		progress = (float)frame / (frameCount - 1);
+	}
+
+	if (m_keys.empty() == true)
+	{
+		float angle = progress * 2.0f * 3.14159265f;
+		position = g_OrbitTarget + glm::vec3(
+			g_OrbitRadius * sinf(angle),
+			g_OrbitHeight,
+			g_OrbitRadius * cosf(angle));
+		target = g_OrbitTarget;
+		return;
+	}
+
+	float keyPosition = progress * (m_keys.size() - 1);
+	int key = (int)keyPosition;
+	if (key >= (int)m_keys.size() - 1)
+	{
+		position = m_keys.back().position;
+		target = m_keys.back().target;
+		return;
+	}
+
+	float blend = keyPosition - key;
+	position = glm::mix(m_keys[key].position, m_keys[key + 1].position, blend);
+	target = glm::mix(m_keys[key].target, m_keys[key + 1].target, blend);
+}
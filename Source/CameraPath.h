@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerapath.h
+// ============
+// record, load and replay the path of the scene camera
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  CameraPath
+ *
+ *  This class holds a list of camera keys, each one a camera
+ *  position and the point it looks at.  A path is replayed
+ *  over any number of frames by spreading the keys evenly
+ *  over them, so a path recorded while flying the camera by
+ *  hand or written by hand gives the same views every run.
+ *  A path without keys circles the scene.
+ ***********************************************************/
+class CameraPath
+{
+public:
+	// constructor
+	CameraPath();
+	// destructor
+	~CameraPath();
+
+	// one key of the camera path
+	struct CAMERA_KEY
+	{
+		glm::vec3 position;
+		glm::vec3 target;
+	};
+
+private:
+	// keys the camera moves through
+	std::vector<CAMERA_KEY> m_keys;
+
+public:
+	// read the keys from a text file with one key per line, as
+	// the position and the target of the camera
+	bool Load(const char* filename);
+	// write the keys to a text file that Load() can read
+	bool Save(const char* filename) const;
+
+	// add a key to the end of the path
+	void AddKey(const glm::vec3& position, const glm::vec3& target);
+	// get the number of keys, 0 for the orbit around the scene
+	int GetKeyCount() const;
+
+	// get the camera pose of a frame when the path is replayed
+	// over the passed in number of frames
+	void GetPose(int frame, int frameCount, glm::vec3& position, glm::vec3& target) const;
+};
@@ -0,0 +1,409 @@
+///////////////////////////////////////////////////////////////////////////////
+// clusteredlighting.cpp
+// ============
+// assign the scene point lights to clusters of the view frustum
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ClusteredLighting.h"
+
+#include <cmath>
+
+// declaration of global variables
+namespace
+{
+	// shader storage bindings of the buffers, matching the
+	// binding layouts of the fragment shader
+	const GLuint g_PointLightBinding = 2;
+	const GLuint g_ClusterBinding = 3;
+	const GLuint g_LightIndexBinding = 4;
+
+	// get the depth slice of a positive view space depth - the
+	// slices grow with the distance, like the size of the tiles
+	int DepthSlice(float depth, float depthScale, float depthBias)
+	{
+		int slice = (int)floorf(logf(depth) * depthScale + depthBias);
+
+		if (slice < 0)
+		{
+			return(0);
+		}
+		if (slice >= ClusteredLighting::CLUSTER_COUNT_Z)
+		{
+			return(ClusteredLighting::CLUSTER_COUNT_Z - 1);
+		}
+		return(slice);
+	}
+
+	// get the tile of a normalized device coordinate
+	int ScreenTile(float ndc, int tileCount)
+	{
+		int tile = (int)floorf((ndc * 0.5f + 0.5f) * tileCount);
+
+		if (tile < 0)
+		{
+			return(0);
+		}
+		if (tile >= tileCount)
+		{
+			return(tileCount - 1);
+		}
+		return(tile);
+	}
+}
+
+/***********************************************************
+ *  ClusteredLighting()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ClusteredLighting::ClusteredLighting()
+{
+	m_bLightsChanged = true;
+	m_lightBuffer = 0;
+	m_clusterBuffer = 0;
+	m_indexBuffer = 0;
+	m_pUniformCache = NULL;
+	m_useClusteredLightsHandle.location = -1;
+	m_tileSizeHandle.location = -1;
+	m_depthScaleHandle.location = -1;
+	m_depthBiasHandle.location = -1;
+}
+
+/***********************************************************
+ *  ~ClusteredLighting()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ClusteredLighting::~ClusteredLighting()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for adding a point light to the scene.
+ ***********************************************************/
+int ClusteredLighting::AddLight(const POINT_LIGHT& light)
+{
+	m_lights.push_back(light);
+	m_lights.back().padding = 0.0f;
+	m_bLightsChanged = true;
+
+	return((int)m_lights.size() - 1);
+}
+
+/***********************************************************
+ *  SetLightPosition()
+ *
+ *  This method is used for moving a point light.
+ ***********************************************************/
+void ClusteredLighting::SetLightPosition(int light, const glm::vec3& position)
+{
+	if ((light < 0) || (light >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	m_lights[light].position = position;
+	m_bLightsChanged = true;
+}
+
+/***********************************************************
+ *  GetLightCount()
+ *
+ *  This method is used for getting the number of point lights.
+ ***********************************************************/
+int ClusteredLighting::GetLightCount() const
+{
+	return((int)m_lights.size());
+}
+
+/***********************************************************
+ *  GetAssignmentCount()
+ *
+ *  This method is used for getting the number of light
+ *  entries in all the clusters of the last update.
+ ***********************************************************/
+int ClusteredLighting::GetAssignmentCount() const
+{
+	return((int)m_lightIndices.size());
+}
+
+/***********************************************************
+ *  SetUniformCache()
+ *
+ *  This method is used for setting the cached uniform
+ *  locations of the shader and resolving the handles of the
+ *  cluster values that are set every frame.
+ ***********************************************************/
+void ClusteredLighting::SetUniformCache(UniformCache* pUniformCache)
+{
+	m_pUniformCache = pUniformCache;
+
+	if (NULL != m_pUniformCache)
+	{
+		m_useClusteredLightsHandle = m_pUniformCache->GetHandle("bUseClusteredLights");
+		m_tileSizeHandle = m_pUniformCache->GetHandle("clusterTileSize");
+		m_depthScaleHandle = m_pUniformCache->GetHandle("clusterDepthScale");
+		m_depthBiasHandle = m_pUniformCache->GetHandle("clusterDepthBias");
+	}
+}
+
+/***********************************************************
+ *  FindClusterExtent()
+ *
+ *  This method is used for finding the range of clusters that
+ *  a light's sphere of influence touches.  The depth range
+ *  comes from the view space depth of the sphere, and the
+ *  screen range from projecting the corners of the view space
+ *  box around the sphere.  A box reaching behind the camera
+ *  covers the whole screen.
+ ***********************************************************/
+bool ClusteredLighting::FindClusterExtent(
+	const POINT_LIGHT& light,
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane,
+	float depthScale,
+	float depthBias,
+	CLUSTER_EXTENT& extent) const
+{
+	glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+	float depth = -center.z;
+
+	if ((depth + light.radius < nearPlane) || (depth - light.radius > farPlane))
+	{
+		return(false);
+	}
+
+	extent.minimumZ = DepthSlice(glm::max(depth - light.radius, nearPlane), depthScale, depthBias);
+	extent.maximumZ = DepthSlice(glm::min(depth + light.radius, farPlane), depthScale, depthBias);
+
+	glm::vec2 ndcMinimum(-1.0f, -1.0f);
+	glm::vec2 ndcMaximum(1.0f, 1.0f);
+	bool bBehindCamera = false;
+	for (int corner = 0; (corner < 8) && (bBehindCamera == false); corner++)
+	{
+		glm::vec3 offset(
+			(corner & 1) ? light.radius : -light.radius,
+			(corner & 2) ? light.radius : -light.radius,
+			(corner & 4) ? light.radius : -light.radius);
+		glm::vec4 clip = projection * glm::vec4(center + offset, 1.0f);
+
+		if (clip.w <= 0.0001f)
+		{
+			bBehindCamera = true;
+		}
+		else
+		{
+			glm::vec2 ndc(clip.x / clip.w, clip.y / clip.w);
+			if (corner == 0)
+			{
+				ndcMinimum = ndc;
+				ndcMaximum = ndc;
+			}
+			else
+			{
+				ndcMinimum = glm::min(ndcMinimum, ndc);
+				ndcMaximum = glm::max(ndcMaximum, ndc);
+			}
+		}
+	}
+	if (bBehindCamera == true)
+	{
+		ndcMinimum = glm::vec2(-1.0f, -1.0f);
+		ndcMaximum = glm::vec2(1.0f, 1.0f);
+	}
+
+	if ((ndcMaximum.x < -1.0f) || (ndcMinimum.x > 1.0f) ||
+		(ndcMaximum.y < -1.0f) || (ndcMinimum.y > 1.0f))
+	{
+		return(false);
+	}
+
+	extent.minimumX = ScreenTile(ndcMinimum.x, CLUSTER_COUNT_X);
+	extent.maximumX = ScreenTile(ndcMaximum.x, CLUSTER_COUNT_X);
+	extent.minimumY = ScreenTile(ndcMinimum.y, CLUSTER_COUNT_Y);
+	extent.maximumY = ScreenTile(ndcMaximum.y, CLUSTER_COUNT_Y);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for listing every light in the clusters
+ *  it touches for the current view.  The lights are counted
+ *  per cluster first, so that the lists of all the clusters
+ *  can be packed into one index buffer with a single pass.
+ ***********************************************************/
+void ClusteredLighting::Update(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	int viewportWidth,
+	int viewportHeight)
+{
+	if ((NULL == m_pUniformCache) || (m_lights.empty() == true) ||
+		(viewportWidth <= 0) || (viewportHeight <= 0))
+	{
+		if (NULL != m_pUniformCache)
+		{
+			m_pUniformCache->SetBool(m_useClusteredLightsHandle, false);
+		}
+		m_lightIndices.clear();
+		return;
+	}
+
+	// the near and far planes are taken from the projection, for
+	// both the perspective and the orthographic projection
+	float nearPlane = 0.0f;
+	float farPlane = 0.0f;
+	if (projection[2][3] != 0.0f)
+	{
+		nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+		farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+	}
+	else
+	{
+		nearPlane = (projection[3][2] + 1.0f) / projection[2][2];
+		farPlane = (projection[3][2] - 1.0f) / projection[2][2];
+	}
+	nearPlane = glm::max(nearPlane, 0.01f);
+	farPlane = glm::max(farPlane, nearPlane + 0.01f);
+
+	// slice = log(depth) * scale + bias puts the near plane at
+	// slice 0 and the far plane at the last slice
+	float depthScale = CLUSTER_COUNT_Z / logf(farPlane / nearPlane);
+	float depthBias = -logf(nearPlane) * depthScale;
+
+	// count the lights of each cluster
+	CLUSTER_RANGE emptyRange;
+	emptyRange.offset = 0;
+	emptyRange.count = 0;
+	m_clusters.assign(CLUSTER_COUNT, emptyRange);
+	m_lightExtents.resize(m_lights.size());
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		CLUSTER_EXTENT& extent = m_lightExtents[i];
+
+		if (FindClusterExtent(m_lights[i], view, projection, nearPlane, farPlane, depthScale, depthBias, extent) == false)
+		{
+			extent.minimumX = -1;
+			continue;
+		}
+
+		for (int z = extent.minimumZ; z <= extent.maximumZ; z++)
+		{
+			for (int y = extent.minimumY; y <= extent.maximumY; y++)
+			{
+				for (int x = extent.minimumX; x <= extent.maximumX; x++)
+				{
+					m_clusters[(z * CLUSTER_COUNT_Y + y) * CLUSTER_COUNT_X + x].count++;
+				}
+			}
+		}
+	}
+
+	// give every cluster its range of the index list
+	GLuint totalCount = 0;
+	for (int c = 0; c < CLUSTER_COUNT; c++)
+	{
+		m_clusters[c].offset = totalCount;
+		totalCount += m_clusters[c].count;
+		m_clusters[c].count = 0;
+	}
+
+	// fill the ranges, counting again as each light is listed
+	m_lightIndices.resize(totalCount);
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		const CLUSTER_EXTENT& extent = m_lightExtents[i];
+
+		if (extent.minimumX < 0)
+		{
+			continue;
+		}
+
+		for (int z = extent.minimumZ; z <= extent.maximumZ; z++)
+		{
+			for (int y = extent.minimumY; y <= extent.maximumY; y++)
+			{
+				for (int x = extent.minimumX; x <= extent.maximumX; x++)
+				{
+					CLUSTER_RANGE& cluster = m_clusters[(z * CLUSTER_COUNT_Y + y) * CLUSTER_COUNT_X + x];
+					m_lightIndices[cluster.offset + cluster.count] = (GLuint)i;
+					cluster.count++;
+				}
+			}
+		}
+	}
+
+	// the lights are only uploaded after they have changed
+	if (m_lightBuffer == 0)
+	{
+		glGenBuffers(1, &m_lightBuffer);
+		glGenBuffers(1, &m_clusterBuffer);
+		glGenBuffers(1, &m_indexBuffer);
+	}
+	if (m_bLightsChanged == true)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_lightBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_lights.size() * sizeof(POINT_LIGHT), m_lights.data(), GL_DYNAMIC_DRAW);
+		m_bLightsChanged = false;
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_clusterBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_clusters.size() * sizeof(CLUSTER_RANGE), m_clusters.data(), GL_STREAM_DRAW);
+	// an empty buffer cannot be bound, so it always holds one index
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indexBuffer);
+	if (m_lightIndices.empty() == true)
+	{
+		GLuint unusedIndex = 0;
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), &unusedIndex, GL_STREAM_DRAW);
+	}
+	else
+	{
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_lightIndices.size() * sizeof(GLuint), m_lightIndices.data(), GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_PointLightBinding, m_lightBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_ClusterBinding, m_clusterBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_LightIndexBinding, m_indexBuffer);
+
+	m_pUniformCache->SetBool(m_useClusteredLightsHandle, true);
+	m_pUniformCache->SetVec2(m_tileSizeHandle, glm::vec2(
+		(float)viewportWidth / CLUSTER_COUNT_X,
+		(float)viewportHeight / CLUSTER_COUNT_Y));
+	m_pUniformCache->SetFloat(m_depthScaleHandle, depthScale);
+	m_pUniformCache->SetFloat(m_depthBiasHandle, depthBias);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for removing the lights and freeing
+ *  the shader storage buffers.
+ ***********************************************************/
+void ClusteredLighting::Destroy()
+{
+	if (m_lightBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_lightBuffer);
+		glDeleteBuffers(1, &m_clusterBuffer);
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_lightBuffer = 0;
+		m_clusterBuffer = 0;
+		m_indexBuffer = 0;
+	}
+
+	m_lights.clear();
+	m_clusters.clear();
+	m_lightIndices.clear();
+	m_lightExtents.clear();
+	m_bLightsChanged = true;
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// clusteredlighting.h
+// ============
+// assign the scene point lights to clusters of the view frustum
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "UniformCache.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  ClusteredLighting
+ *
+ *  This class keeps the point lights of the scene in a shader
+ *  storage buffer.  Every frame the view frustum is split into
+ *  a grid of clusters - screen tiles cut into slices by view
+ *  depth - and each light is listed in the clusters its sphere
+ *  of influence touches.  A pixel then only shades the lights
+ *  listed for its own cluster, so the cost of a pixel depends
+ *  on the lights near it, not on every light in the scene.
+ ***********************************************************/
+class ClusteredLighting
+{
+public:
+	// constructor
+	ClusteredLighting();
+	// destructor
+	~ClusteredLighting();
+
+	// size of the cluster grid, which must match the defines of
+	// the fragment shader
+	static const int CLUSTER_COUNT_X = 16;
+	static const int CLUSTER_COUNT_Y = 9;
+	static const int CLUSTER_COUNT_Z = 24;
+	static const int CLUSTER_COUNT = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z;
+
+	// std430 layout of one point light, shared with the
+	// PointLight struct of the fragment shader
+	struct POINT_LIGHT
+	{
+		glm::vec3 position;
+		// distance at which the light has faded out completely
+		float radius;
+		glm::vec3 ambientColor;
+		float focalStrength;
+		glm::vec3 diffuseColor;
+		float specularIntensity;
+		glm::vec3 specularColor;
+		float padding;
+	};
+
+private:
+	// range of the light index list owned by one cluster
+	struct CLUSTER_RANGE
+	{
+		GLuint offset;
+		GLuint count;
+	};
+
+	// range of clusters touched by one light
+	struct CLUSTER_EXTENT
+	{
+		int minimumX;
+		int maximumX;
+		int minimumY;
+		int maximumY;
+		int minimumZ;
+		int maximumZ;
+	};
+
+	// point lights of the scene
+	std::vector<POINT_LIGHT> m_lights;
+	// true when the light buffer needs to be uploaded again
+	bool m_bLightsChanged;
+	// lights listed in each cluster, for the current frame
+	std::vector<CLUSTER_RANGE> m_clusters;
+	std::vector<GLuint> m_lightIndices;
+	// clusters touched by each light, -1 in minimumX for none
+	std::vector<CLUSTER_EXTENT> m_lightExtents;
+
+	// shader storage buffers read by the fragment shader
+	GLuint m_lightBuffer;
+	GLuint m_clusterBuffer;
+	GLuint m_indexBuffer;
+
+	// pointer to the cached uniform locations of the shader
+	UniformCache* m_pUniformCache;
+	// pre-resolved handles of the cluster uniforms
+	UniformCache::UNIFORM_HANDLE m_useClusteredLightsHandle;
+	UniformCache::UNIFORM_HANDLE m_tileSizeHandle;
+	UniformCache::UNIFORM_HANDLE m_depthScaleHandle;
+	UniformCache::UNIFORM_HANDLE m_depthBiasHandle;
+
+	// find the clusters touched by a light, false when none are
+	bool FindClusterExtent(
+		const POINT_LIGHT& light,
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane,
+		float depthScale,
+		float depthBias,
+		CLUSTER_EXTENT& extent) const;
+
+public:
+	// add a point light and return its index
+	int AddLight(const POINT_LIGHT& light);
+	// move a point light, for example one attached to a vehicle
+	void SetLightPosition(int light, const glm::vec3& position);
+	// get the number of point lights
+	int GetLightCount() const;
+	// get the number of light entries in all the clusters
+	int GetAssignmentCount() const;
+
+	// set the cached uniform locations used for the cluster values
+	void SetUniformCache(UniformCache* pUniformCache);
+
+	// assign the lights to the clusters of the current view and
+	// upload the buffers used by the fragment shader
+	void Update(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		int viewportWidth,
+		int viewportHeight);
+
+	// free the lights and the shader storage buffers
+	void Destroy();
+};
@@ -0,0 +1,390 @@
+///////////////////////////////////////////////////////////////////////////////
+// cullingkernel.cpp
+// ============
+// test many bounding boxes against the view frustum at once
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CullingKernel.h"
+
+// the vector kernels are only built for x86 processors
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CULLING_KERNEL_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SSE_FUNCTION
+#define AVX2_FUNCTION
+#else
+#define SSE_FUNCTION __attribute__((target("sse2")))
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+// declaration of global variables
+namespace
+{
+	// the frustum planes split into components, along with the
+	// absolute normal values used for projecting box extents
+	struct PLANE_SET
+	{
+		float normalX[Frustum::PLANE_COUNT];
+		float normalY[Frustum::PLANE_COUNT];
+		float normalZ[Frustum::PLANE_COUNT];
+		float distance[Frustum::PLANE_COUNT];
+		float absoluteX[Frustum::PLANE_COUNT];
+		float absoluteY[Frustum::PLANE_COUNT];
+		float absoluteZ[Frustum::PLANE_COUNT];
+	};
+
+	void MakePlaneSet(const Frustum& frustum, PLANE_SET& planes)
+	{
+		for (int p = 0; p < Frustum::PLANE_COUNT; p++)
+		{
+			const glm::vec4& plane = frustum.GetPlane(p);
+
+			planes.normalX[p] = plane.x;
+			planes.normalY[p] = plane.y;
+			planes.normalZ[p] = plane.z;
+			planes.distance[p] = plane.w;
+			planes.absoluteX[p] = (plane.x < 0.0f) ? -plane.x : plane.x;
+			planes.absoluteY[p] = (plane.y < 0.0f) ? -plane.y : plane.y;
+			planes.absoluteZ[p] = (plane.z < 0.0f) ? -plane.z : plane.z;
+		}
+	}
+
+	// a box is outside when its center is farther behind a plane
+	// than the box reaches along the plane normal
+	int CullScalar(
+		const PLANE_SET& planes,
+		const CullingKernel::BOUNDS_SOA& bounds,
+		int first,
+		int count,
+		unsigned char* visible)
+	{
+		int visibleCount = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			int box = first + i;
+			unsigned char bInside = 1;
+
+			for (int p = 0; (p < Frustum::PLANE_COUNT) && (bInside == 1); p++)
+			{
+				float d = planes.normalX[p] * bounds.centerX[box] +
+					planes.normalY[p] * bounds.centerY[box] +
+					planes.normalZ[p] * bounds.centerZ[box] +
+					planes.distance[p];
+				float r = planes.absoluteX[p] * bounds.extentX[box] +
+					planes.absoluteY[p] * bounds.extentY[box] +
+					planes.absoluteZ[p] * bounds.extentZ[box];
+
+				if (d + r < 0.0f)
+				{
+					bInside = 0;
+				}
+			}
+
+			visible[i] = bInside;
+			visibleCount += bInside;
+		}
+
+		return(visibleCount);
+	}
+
+#ifdef CULLING_KERNEL_X86
+	// 4 boxes per iteration with SSE
+	SSE_FUNCTION int CullSSE(
+		const PLANE_SET& planes,
+		const CullingKernel::BOUNDS_SOA& bounds,
+		int first,
+		int count,
+		unsigned char* visible)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		int visibleCount = 0;
+		int i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			int box = first + i;
+			__m128 centerX = _mm_loadu_ps(&bounds.centerX[box]);
+			__m128 centerY = _mm_loadu_ps(&bounds.centerY[box]);
+			__m128 centerZ = _mm_loadu_ps(&bounds.centerZ[box]);
+			__m128 extentX = _mm_loadu_ps(&bounds.extentX[box]);
+			__m128 extentY = _mm_loadu_ps(&bounds.extentY[box]);
+			__m128 extentZ = _mm_loadu_ps(&bounds.extentZ[box]);
+			__m128 outside = zero;
+
+			for (int p = 0; p < Frustum::PLANE_COUNT; p++)
+			{
+				__m128 d = _mm_add_ps(
+					_mm_add_ps(
+						_mm_add_ps(
+							_mm_mul_ps(_mm_set1_ps(planes.normalX[p]), centerX),
+							_mm_mul_ps(_mm_set1_ps(planes.normalY[p]), centerY)),
+						_mm_mul_ps(_mm_set1_ps(planes.normalZ[p]), centerZ)),
+					_mm_set1_ps(planes.distance[p]));
+				__m128 r = _mm_add_ps(
+					_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(planes.absoluteX[p]), extentX),
+						_mm_mul_ps(_mm_set1_ps(planes.absoluteY[p]), extentY)),
+					_mm_mul_ps(_mm_set1_ps(planes.absoluteZ[p]), extentZ));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+			}
+
+			int outsideMask = _mm_movemask_ps(outside);
+			for (int k = 0; k < 4; k++)
+			{
+				unsigned char bInside = (unsigned char)(((outsideMask >> k) & 1) ^ 1);
+				visible[i + k] = bInside;
+				visibleCount += bInside;
+			}
+		}
+
+		// the boxes left over after the last full group
+		return(visibleCount + CullScalar(planes, bounds, first + i, count - i, visible + i));
+	}
+
+	// 8 boxes per iteration with AVX2
+	AVX2_FUNCTION int CullAVX2(
+		const PLANE_SET& planes,
+		const CullingKernel::BOUNDS_SOA& bounds,
+		int first,
+		int count,
+		unsigned char* visible)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		int visibleCount = 0;
+		int i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			int box = first + i;
+			__m256 centerX = _mm256_loadu_ps(&bounds.centerX[box]);
+			__m256 centerY = _mm256_loadu_ps(&bounds.centerY[box]);
+			__m256 centerZ = _mm256_loadu_ps(&bounds.centerZ[box]);
+			__m256 extentX = _mm256_loadu_ps(&bounds.extentX[box]);
+			__m256 extentY = _mm256_loadu_ps(&bounds.extentY[box]);
+			__m256 extentZ = _mm256_loadu_ps(&bounds.extentZ[box]);
+			__m256 outside = zero;
+
+			for (int p = 0; p < Frustum::PLANE_COUNT; p++)
+			{
+				__m256 d = _mm256_add_ps(
+					_mm256_add_ps(
+						_mm256_add_ps(
+							_mm256_mul_ps(_mm256_set1_ps(planes.normalX[p]), centerX),
+							_mm256_mul_ps(_mm256_set1_ps(planes.normalY[p]), centerY)),
+						_mm256_mul_ps(_mm256_set1_ps(planes.normalZ[p]), centerZ)),
+					_mm256_set1_ps(planes.distance[p]));
+				__m256 r = _mm256_add_ps(
+					_mm256_add_ps(
+						_mm256_mul_ps(_mm256_set1_ps(planes.absoluteX[p]), extentX),
+						_mm256_mul_ps(_mm256_set1_ps(planes.absoluteY[p]), extentY)),
+					_mm256_mul_ps(_mm256_set1_ps(planes.absoluteZ[p]), extentZ));
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), zero, _CMP_LT_OQ));
+			}
+
+			int outsideMask = _mm256_movemask_ps(outside);
+			for (int k = 0; k < 8; k++)
+			{
+				unsigned char bInside = (unsigned char)(((outsideMask >> k) & 1) ^ 1);
+				visible[i + k] = bInside;
+				visibleCount += bInside;
+			}
+		}
+
+		// the boxes left over after the last full group
+		return(visibleCount + CullScalar(planes, bounds, first + i, count - i, visible + i));
+	}
+#endif
+}
+
+/***********************************************************
+ *  CullingKernel()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CullingKernel::CullingKernel()
+{
+	m_kernel = DetectBestKernel();
+}
+
+/***********************************************************
+ *  ~CullingKernel()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+CullingKernel::~CullingKernel()
+{
+}
+
+/***********************************************************
+ *  DetectBestKernel()
+ *
+ *  This method is used for asking the processor which vector
+ *  instructions it supports.  AVX2 also needs the operating
+ *  system to save the wider registers, which is checked too.
+ ***********************************************************/
+CullingKernel::KERNEL_TYPE CullingKernel::DetectBestKernel()
+{
+#ifdef CULLING_KERNEL_X86
+#ifdef _MSC_VER
+	int info[4] = { 0, 0, 0, 0 };
+	bool bOsSavesAvx = false;
+
+	__cpuid(info, 1);
+	bool bSse2 = ((info[3] & (1 << 26)) != 0);
+	bool bOsxsave = ((info[2] & (1 << 27)) != 0);
+	bool bAvx = ((info[2] & (1 << 28)) != 0);
+	if ((bOsxsave == true) && (bAvx == true))
+	{
+		bOsSavesAvx = ((_xgetbv(0) & 0x6) == 0x6);
+	}
+
+	__cpuid(info, 0);
+	bool bAvx2 = false;
+	if (info[0] >= 7)
+	{
+		__cpuidex(info, 7, 0);
+		bAvx2 = ((info[1] & (1 << 5)) != 0);
+	}
+
+	if ((bAvx2 == true) && (bOsSavesAvx == true))
+	{
+		return(KERNEL_AVX2);
+	}
+	if (bSse2 == true)
+	{
+		return(KERNEL_SSE);
+	}
+#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return(KERNEL_AVX2);
+	}
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return(KERNEL_SSE);
+	}
+#endif
+#endif
+
+	return(KERNEL_SCALAR);
+}
+
+/***********************************************************
+ *  GetKernelName()
+ *
+ *  This method is used for getting the printable name of a
+ *  kernel.
+ ***********************************************************/
+const char* CullingKernel::GetKernelName(KERNEL_TYPE kernel)
+{
+	switch (kernel)
+	{
+	case KERNEL_AVX2:
+		return("AVX2");
+	case KERNEL_SSE:
+		return("SSE");
+	default:
+		return("scalar");
+	}
+}
+
+/***********************************************************
+ *  SetBounds()
+ *
+ *  This method is used for storing a bounding box in the
+ *  arrays as its center and extent.
+ ***********************************************************/
+void CullingKernel::SetBounds(BOUNDS_SOA& bounds, int index, const BOUNDING_BOX& box)
+{
+	glm::vec3 center = (box.minimum + box.maximum) * 0.5f;
+	glm::vec3 extent = (box.maximum - box.minimum) * 0.5f;
+
+	bounds.centerX[index] = center.x;
+	bounds.centerY[index] = center.y;
+	bounds.centerZ[index] = center.z;
+	bounds.extentX[index] = extent.x;
+	bounds.extentY[index] = extent.y;
+	bounds.extentZ[index] = extent.z;
+}
+
+/***********************************************************
+ *  ResizeBounds()
+ *
+ *  This method is used for resizing every array of the
+ *  bounds to the passed in number of boxes.
+ ***********************************************************/
+void CullingKernel::ResizeBounds(BOUNDS_SOA& bounds, int count)
+{
+	bounds.centerX.resize(count);
+	bounds.centerY.resize(count);
+	bounds.centerZ.resize(count);
+	bounds.extentX.resize(count);
+	bounds.extentY.resize(count);
+	bounds.extentZ.resize(count);
+}
+
+/***********************************************************
+ *  SetKernel()
+ *
+ *  This method is used for choosing the kernel used by
+ *  Cull().  A kernel the processor does not support is
+ *  replaced by the fastest one it does.
+ ***********************************************************/
+void CullingKernel::SetKernel(KERNEL_TYPE kernel)
+{
+	KERNEL_TYPE bestKernel = DetectBestKernel();
+
+	m_kernel = (kernel > bestKernel) ? bestKernel : kernel;
+}
+
+/***********************************************************
+ *  GetKernel()
+ *
+ *  This method is used for getting the kernel used by Cull().
+ ***********************************************************/
+CullingKernel::KERNEL_TYPE CullingKernel::GetKernel() const
+{
+	return(m_kernel);
+}
+
+/***********************************************************
+ *  Cull()
+ *
+ *  This method is used for testing the boxes from first to
+ *  first + count - 1 against the frustum with the chosen
+ *  kernel.  visible[0] receives the result of the first box.
+ ***********************************************************/
+int CullingKernel::Cull(
+	const Frustum& frustum,
+	const BOUNDS_SOA& bounds,
+	int first,
+	int count,
+	unsigned char* visible) const
+{
+	PLANE_SET planes;
+
+	MakePlaneSet(frustum, planes);
+
+#ifdef CULLING_KERNEL_X86
+	if (m_kernel == KERNEL_AVX2)
+	{
+		return(CullAVX2(planes, bounds, first, count, visible));
+	}
+	if (m_kernel == KERNEL_SSE)
+	{
+		return(CullSSE(planes, bounds, first, count, visible));
+	}
+#endif
+
+	return(CullScalar(planes, bounds, first, count, visible));
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// cullingkernel.h
+// ============
+// test many bounding boxes against the view frustum at once
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Frustum.h"
+
+#include <vector>
+
+/***********************************************************
+ *  CullingKernel
+ *
+ *  This class tests a range of bounding boxes against the six
+ *  frustum planes.  The boxes are stored as separate arrays of
+ *  centers and extents, so the SSE kernel tests 4 boxes and
+ *  the AVX2 kernel tests 8 boxes with each instruction.  The
+ *  fastest kernel the processor supports is chosen when the
+ *  program runs, with a plain C++ kernel as the fallback.
+ ***********************************************************/
+class CullingKernel
+{
+public:
+	// constructor
+	CullingKernel();
+	// destructor
+	~CullingKernel();
+
+	// available kernels, from slowest to fastest
+	enum KERNEL_TYPE
+	{
+		KERNEL_SCALAR = 0,
+		KERNEL_SSE,
+		KERNEL_AVX2
+	};
+
+	// bounding boxes stored as one array per component
+	struct BOUNDS_SOA
+	{
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+		std::vector<float> extentX;
+		std::vector<float> extentY;
+		std::vector<float> extentZ;
+	};
+
+private:
+	// kernel used by Cull()
+	KERNEL_TYPE m_kernel;
+
+public:
+	// get the fastest kernel the processor supports
+	static KERNEL_TYPE DetectBestKernel();
+	// get the printable name of a kernel
+	static const char* GetKernelName(KERNEL_TYPE kernel);
+
+	// store a bounding box in the arrays
+	static void SetBounds(BOUNDS_SOA& bounds, int index, const BOUNDING_BOX& box);
+	// resize the arrays to hold the passed in number of boxes
+	static void ResizeBounds(BOUNDS_SOA& bounds, int count);
+
+	// choose the kernel, limited to the ones that are supported
+	void SetKernel(KERNEL_TYPE kernel);
+	KERNEL_TYPE GetKernel() const;
+
+	// test a range of boxes and write 1 into the visible list
+	// for each box that is at least partly inside the frustum,
+	// and 0 otherwise - the number of visible boxes is returned
+	int Cull(
+		const Frustum& frustum,
+		const BOUNDS_SOA& bounds,
+		int first,
+		int count,
+		unsigned char* visible) const;
+};
@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.cpp
+// ============
+// pace the rendered frames and step the scene simulation
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FramePacer.h"
+
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+// declaration of global variables
+namespace
+{
+	// simulation steps per second used until another step is set
+	const double g_DefaultStepRate = 60.0;
+	// longest frame time handed to the simulation, so a stall,
+	// such as dragging the window, does not cause a long burst
+	// of catch-up steps
+	const double g_MaxFrameDeltaTime = 0.25;
+	// length of one sleep of the limiter
+	const std::chrono::microseconds g_SleepSlice(1000);
+	// smallest and largest spin margin of the limiter
+	const std::chrono::microseconds g_MinimumSpinMargin(500);
+	const std::chrono::microseconds g_MaximumSpinMargin(4000);
+	// amount the spin margin shrinks after each slice that wakes
+	// on time, so one oversleep does not keep it large
+	const std::chrono::microseconds g_SpinMarginDecay(50);
+}
+
+/***********************************************************
+ *  FramePacer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FramePacer::FramePacer()
+{
+	m_pWindow = NULL;
+	m_vsyncMode = VSYNC_ON;
+	m_targetFrameRate = 0.0;
+	m_fixedTimestep = 1.0 / g_DefaultStepRate;
+	m_bStarted = false;
+	m_bPresentScheduled = false;
+	m_spinMargin = g_MinimumSpinMargin;
+	m_frameDeltaTime = 0.0;
+	m_accumulatedTime = 0.0;
+	m_stepCount = 0;
+
+#ifdef _WIN32
+	// the default Windows timer only wakes a sleep every 15.6 ms
+	timeBeginPeriod(1);
+#endif
+}
+
+/***********************************************************
+ *  ~FramePacer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FramePacer::~FramePacer()
+{
+	m_pWindow = NULL;
+
+#ifdef _WIN32
+	timeEndPeriod(1);
+#endif
+}
+
+/***********************************************************
+ *  SetWindow()
+ *
+ *  This method is used for setting the window whose swap
+ *  interval is controlled, and applying the vsync mode to it.
+ *  The OpenGL context of the window must be current.
+ ***********************************************************/
+void FramePacer::SetWindow(GLFWwindow* pWindow)
+{
+	m_pWindow = pWindow;
+	SetVSyncMode(m_vsyncMode);
+}
+
+/***********************************************************
+ *  SetVSyncMode()
+ *
+ *  This method is used for setting how the buffer swaps wait
+ *  for the display.  Adaptive vsync needs the swap control
+ *  tear extension, and falls back to waiting for every
+ *  vertical blank without it.
+ ***********************************************************/
+void FramePacer::SetVSyncMode(VSYNC_MODE mode)
+{
+	m_vsyncMode = mode;
+
+	if (NULL == m_pWindow)
+	{
+		return;
+	}
+
+	if ((m_vsyncMode == VSYNC_ADAPTIVE) &&
+		(glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_FALSE) &&
+		(glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_FALSE))
+	{
+		std::cout << "INFO: adaptive vsync is not supported, using vsync on" << std::endl;
+		m_vsyncMode = VSYNC_ON;
+	}
+
+	switch (m_vsyncMode)
+	{
+	case VSYNC_OFF:
+		glfwSwapInterval(0);
+		break;
+	case VSYNC_ADAPTIVE:
+		// a negative interval lets a late frame swap at once
+		glfwSwapInterval(-1);
+		break;
+	default:
+		glfwSwapInterval(1);
+		break;
+	}
+}
+
+/***********************************************************
+ *  GetVSyncMode()
+ *
+ *  This method is used for getting the vsync mode in use.
+ ***********************************************************/
+FramePacer::VSYNC_MODE FramePacer::GetVSyncMode() const
+{
+	return(m_vsyncMode);
+}
+
+/***********************************************************
+ *  SetTargetFrameRate()
+ *
+ *  This method is used for setting the number of frames per
+ *  second the limiter holds the main loop to.  A rate of 0
+ *  leaves the frames unlimited.
+ ***********************************************************/
+void FramePacer::SetTargetFrameRate(double framesPerSecond)
+{
+	m_targetFrameRate = framesPerSecond;
+	if (m_targetFrameRate < 0.0)
+	{
+		m_targetFrameRate = 0.0;
+	}
+	m_bPresentScheduled = false;
+}
+
+/***********************************************************
+ *  SetFixedTimestep()
+ *
+ *  This method is used for setting the time simulated by
+ *  each simulation step.
+ ***********************************************************/
+void FramePacer::SetFixedTimestep(double seconds)
+{
+	if (seconds > 0.0)
+	{
+		m_fixedTimestep = seconds;
+	}
+}
+
+/***********************************************************
+ *  GetFixedTimestep()
+ *
+ *  This method is used for getting the time simulated by
+ *  each simulation step.
+ ***********************************************************/
+double FramePacer::GetFixedTimestep() const
+{
+	return(m_fixedTimestep);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for measuring the time since the last
+ *  frame began, and adding it to the time waiting to be
+ *  simulated.  The first frame has no elapsed time.
+ ***********************************************************/
+void FramePacer::BeginFrame()
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	if (m_bStarted == false)
+	{
+		m_frameStart = now;
+		m_bStarted = true;
+	}
+
+	std::chrono::duration<double> elapsed = now - m_frameStart;
+	m_frameStart = now;
+
+	m_frameDeltaTime = elapsed.count();
+	if (m_frameDeltaTime > g_MaxFrameDeltaTime)
+	{
+		m_frameDeltaTime = g_MaxFrameDeltaTime;
+	}
+	m_accumulatedTime += m_frameDeltaTime;
+	m_stepCount = 0;
+}
+
+/***********************************************************
+ *  StepSimulation()
+ *
+ *  This method is used for taking one fixed simulation step
+ *  from the waiting time.  It is called in a loop until it
+ *  returns false, so a slow frame takes several steps and a
+ *  fast frame may take none.
+ ***********************************************************/
+bool FramePacer::StepSimulation()
+{
+	if (m_accumulatedTime < m_fixedTimestep)
+	{
+		return(false);
+	}
+
+	m_accumulatedTime -= m_fixedTimestep;
+	m_stepCount++;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetFrameDeltaTime()
+ *
+ *  This method is used for getting the seconds between the
+ *  start of the previous frame and the current one.
+ ***********************************************************/
+double FramePacer::GetFrameDeltaTime() const
+{
+	return(m_frameDeltaTime);
+}
+
+/***********************************************************
+ *  GetInterpolationAlpha()
+ *
+ *  This method is used for getting the fraction of a step
+ *  that is still waiting to be simulated, which places the
+ *  current frame between the last two simulation steps.
+ ***********************************************************/
+double FramePacer::GetInterpolationAlpha() const
+{
+	return(m_accumulatedTime / m_fixedTimestep);
+}
+
+/***********************************************************
+ *  GetStepCount()
+ *
+ *  This method is used for getting the number of simulation
+ *  steps taken during the current frame.
+ ***********************************************************/
+int FramePacer::GetStepCount() const
+{
+	return(m_stepCount);
+}
+
+/***********************************************************
+ *  WaitForPresent()
+ *
+ *  This method is used for holding the frame back until the
+ *  time of its present under the frame rate limit.  The wait
+ *  sleeps in short slices, which saves power, until the
+ *  present is within the spin margin, and then spins for the
+ *  rest, which keeps the frame times even.  A slice that
+ *  oversleeps grows the margin, and slices that wake on time
+ *  shrink it back toward its minimum.  The presents are scheduled
+ *  one period apart rather than one period after the wait
+ *  ends, so the rate does not drift.
+ ***********************************************************/
+void FramePacer::WaitForPresent()
+{
+	if (m_targetFrameRate <= 0.0)
+	{
+		return;
+	}
+
+	std::chrono::steady_clock::duration period =
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(1.0 / m_targetFrameRate));
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	if (m_bPresentScheduled == false)
+	{
+		m_nextPresent = now + period;
+		m_bPresentScheduled = true;
+		return;
+	}
+
+	while (m_nextPresent - now > m_spinMargin)
+	{
+		std::chrono::steady_clock::time_point sleepStart = now;
+		std::this_thread::sleep_for(g_SleepSlice);
+		now = std::chrono::steady_clock::now();
+
+		std::chrono::steady_clock::duration overslept = (now - sleepStart) - g_SleepSlice;
+		if ((overslept > m_spinMargin) && (overslept < g_MaximumSpinMargin))
+		{
+			m_spinMargin = overslept;
+		}
+		else if (m_spinMargin - g_SpinMarginDecay > g_MinimumSpinMargin)
+		{
+			m_spinMargin -= g_SpinMarginDecay;
+		}
+		else
+		{
+			m_spinMargin = g_MinimumSpinMargin;
+		}
+	}
+	while (now < m_nextPresent)
+	{
+		std::this_thread::yield();
+		now = std::chrono::steady_clock::now();
+	}
+
+	// a frame that ran later than a whole period starts a new
+	// schedule instead of rushing the following frames
+	if (now - m_nextPresent > period)
+	{
+		m_nextPresent = now + period;
+	}
+	else
+	{
+		m_nextPresent += period;
+	}
+}
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.h
+// ============
+// pace the rendered frames and step the scene simulation
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// GLFW library
+#include "GLFW/glfw3.h"
+
+#include <chrono>
+
+/***********************************************************
+ *  FramePacer
+ *
+ *  This class controls when the frames of the main loop are
+ *  presented.  It sets the swap interval of the window for
+ *  the chosen vsync mode, holds each frame back to a target
+ *  frame rate, and splits the elapsed time into fixed steps
+ *  for the scene simulation, so the simulation runs the same
+ *  no matter how fast the frames are rendered.
+ ***********************************************************/
+class FramePacer
+{
+public:
+	// constructor
+	FramePacer();
+	// destructor
+	~FramePacer();
+
+	// ways of waiting for the display when swapping buffers
+	enum VSYNC_MODE
+	{
+		// swap at once, which may tear
+		VSYNC_OFF = 0,
+		// wait for every vertical blank
+		VSYNC_ON,
+		// wait for the vertical blank, unless the frame is late
+		VSYNC_ADAPTIVE
+	};
+
+private:
+	// window whose swap interval is set
+	GLFWwindow* m_pWindow;
+	// vsync mode in use
+	VSYNC_MODE m_vsyncMode;
+	// frames per second the limiter holds the loop to, 0 when
+	// the frames are not limited
+	double m_targetFrameRate;
+	// time in seconds simulated by each simulation step
+	double m_fixedTimestep;
+
+	// true once the first frame has begun
+	bool m_bStarted;
+	// start time of the current frame
+	std::chrono::steady_clock::time_point m_frameStart;
+	// time at which the limiter lets the next frame be presented
+	std::chrono::steady_clock::time_point m_nextPresent;
+	// true when the time of the next present has been set
+	bool m_bPresentScheduled;
+	// time left before the present at which the limiter stops
+	// sleeping and spins, which grows when a sleep oversleeps
+	std::chrono::steady_clock::duration m_spinMargin;
+
+	// seconds since the previous frame began
+	double m_frameDeltaTime;
+	// time not yet consumed by the simulation steps
+	double m_accumulatedTime;
+	// simulation steps taken during the current frame
+	int m_stepCount;
+
+public:
+	// set the window whose swap interval is controlled
+	void SetWindow(GLFWwindow* pWindow);
+	// set how the buffer swaps wait for the display
+	void SetVSyncMode(VSYNC_MODE mode);
+	VSYNC_MODE GetVSyncMode() const;
+	// set the frame rate limit, 0 for no limit
+	void SetTargetFrameRate(double framesPerSecond);
+	// set the time simulated by each simulation step
+	void SetFixedTimestep(double seconds);
+	double GetFixedTimestep() const;
+
+	// measure the time since the last frame and add it to the
+	// time waiting to be simulated
+	void BeginFrame();
+	// take one simulation step when enough time is waiting, and
+	// return false once the simulation has caught up
+	bool StepSimulation();
+	// get the seconds since the previous frame began
+	double GetFrameDeltaTime() const;
+	// get how far the current frame lies between the last and
+	// the next simulation step, from 0 to 1
+	double GetInterpolationAlpha() const;
+	// get the number of simulation steps of the current frame
+	int GetStepCount() const;
+
+	// wait until the frame may be presented under the frame rate
+	// limit - called right before swapping the buffers
+	void WaitForPresent();
+};
@@ -0,0 +1,633 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// measure the CPU and GPU time of named sections of each frame
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// name returned for a section index that does not exist
+	const std::string g_UnknownSection = "";
+	// trace thread ids of the CPU and the GPU sections
+	const int g_CpuTraceThread = 0;
+	const int g_GpuTraceThread = 1;
+}
+
+/***********************************************************
+ *  FrameProfiler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameProfiler::FrameProfiler()
+{
+	m_bInitialized = false;
+	m_bEnabled = true;
+	m_currentFrame = 0;
+	m_droppedGpuFrames = 0;
+	m_gpuEpochNs = 0;
+	m_nextTraceEvent = 0;
+
+	for (int frame = 0; frame < QUERY_FRAMES; frame++)
+	{
+		memset(m_frames[frame].queries, 0, sizeof(m_frames[frame].queries));
+		m_frames[frame].eventCount = 0;
+		m_frames[frame].lastQuery = -1;
+		m_frames[frame].bPending = false;
+	}
+}
+
+/***********************************************************
+ *  ~FrameProfiler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameProfiler::~FrameProfiler()
+{
+	if (m_bInitialized == true)
+	{
+		for (int frame = 0; frame < QUERY_FRAMES; frame++)
+		{
+			glDeleteQueries(MAX_EVENTS_PER_FRAME * 2, m_frames[frame].queries);
+		}
+		m_bInitialized = false;
+	}
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the timestamp queries of
+ *  every frame slot, and taking the CPU and GPU times that
+ *  the trace is measured from.  The sections measured before
+ *  the first call to BeginFrame(), such as loading the
+ *  shaders, count as the first frame.
+ ***********************************************************/
+void FrameProfiler::Initialize()
+{
+	if (m_bInitialized == true)
+	{
+		return;
+	}
+
+	for (int frame = 0; frame < QUERY_FRAMES; frame++)
+	{
+		glGenQueries(MAX_EVENTS_PER_FRAME * 2, m_frames[frame].queries);
+	}
+
+	m_cpuEpoch = std::chrono::steady_clock::now();
+	glGetInteger64v(GL_TIMESTAMP, &m_gpuEpochNs);
+	m_traceEvents.reserve(MAX_TRACE_EVENTS);
+	m_currentFrame = 0;
+	m_bInitialized = true;
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for switching the measuring of the
+ *  sections on or off.  Sections already begun still end.
+ ***********************************************************/
+void FrameProfiler::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  IsEnabled()
+ *
+ *  This method is used for checking whether the sections are
+ *  measured.
+ ***********************************************************/
+bool FrameProfiler::IsEnabled() const
+{
+	return(m_bEnabled);
+}
+
+/***********************************************************
+ *  GetCpuMicroseconds()
+ *
+ *  This method is used for getting the microseconds since the
+ *  profiler was initialized, from the monotonic clock.
+ ***********************************************************/
+double FrameProfiler::GetCpuMicroseconds() const
+{
+	std::chrono::duration<double, std::micro> elapsed =
+		std::chrono::steady_clock::now() - m_cpuEpoch;
+	return(elapsed.count());
+}
+
+/***********************************************************
+ *  FindSection()
+ *
+ *  This method is used for getting the index of a named
+ *  section.  A name seen for the first time adds a section,
+ *  until there are MAX_SECTIONS of them.
+ ***********************************************************/
+int FrameProfiler::FindSection(const char* name)
+{
+	for (size_t i = 0; i < m_sectionNames.size(); i++)
+	{
+		if (m_sectionNames[i] == name)
+		{
+			return((int)i);
+		}
+	}
+
+	if ((int)m_sectionNames.size() >= MAX_SECTIONS)
+	{
+		return(-1);
+	}
+
+	SECTION_HISTORY history;
+	history.cpuCount = 0;
+	history.gpuCount = 0;
+	history.cpuNext = 0;
+	history.gpuNext = 0;
+	m_sectionNames.push_back(name);
+	m_history.push_back(history);
+
+	return((int)m_sectionNames.size() - 1);
+}
+
+/***********************************************************
+ *  BeginSection()
+ *
+ *  This method is used for starting to measure a section.
+ *  The CPU start time is taken at once, and a timestamp query
+ *  is issued for when the GPU reaches this point.
+ ***********************************************************/
+int FrameProfiler::BeginSection(const char* name)
+{
+	if ((m_bInitialized == false) || (m_bEnabled == false))
+	{
+		return(-1);
+	}
+
+	FRAME_SLOT& slot = m_frames[m_currentFrame];
+	if (slot.eventCount >= MAX_EVENTS_PER_FRAME)
+	{
+		return(-1);
+	}
+
+	int section = FindSection(name);
+	if (section < 0)
+	{
+		return(-1);
+	}
+
+	int event = slot.eventCount++;
+	slot.events[event].section = section;
+	slot.events[event].bEnded = false;
+	slot.lastQuery = event * 2;
+	glQueryCounter(slot.queries[event * 2], GL_TIMESTAMP);
+	slot.events[event].cpuStartUs = GetCpuMicroseconds();
+
+	return(event);
+}
+
+/***********************************************************
+ *  EndSection()
+ *
+ *  This method is used for ending the measuring of a section
+ *  begun by BeginSection().
+ ***********************************************************/
+void FrameProfiler::EndSection(int event)
+{
+	FRAME_SLOT& slot = m_frames[m_currentFrame];
+	if ((event < 0) || (event >= slot.eventCount) || (slot.events[event].bEnded == true))
+	{
+		return;
+	}
+
+	slot.events[event].cpuEndUs = GetCpuMicroseconds();
+	slot.events[event].bEnded = true;
+	slot.lastQuery = event * 2 + 1;
+	glQueryCounter(slot.queries[event * 2 + 1], GL_TIMESTAMP);
+}
+
+/***********************************************************
+ *  AddSample()
+ *
+ *  This method is used for adding the time of a section in
+ *  one frame to its history, replacing the oldest time once
+ *  the history is full.
+ ***********************************************************/
+void FrameProfiler::AddSample(int section, bool bGpu, float milliseconds)
+{
+	SECTION_HISTORY& history = m_history[section];
+
+	if (bGpu == true)
+	{
+		history.gpuMs[history.gpuNext] = milliseconds;
+		history.gpuNext = (history.gpuNext + 1) % HISTORY_FRAMES;
+		history.gpuCount = std::min(history.gpuCount + 1, (int)HISTORY_FRAMES);
+	}
+	else
+	{
+		history.cpuMs[history.cpuNext] = milliseconds;
+		history.cpuNext = (history.cpuNext + 1) % HISTORY_FRAMES;
+		history.cpuCount = std::min(history.cpuCount + 1, (int)HISTORY_FRAMES);
+	}
+}
+
+/***********************************************************
+ *  AddTraceEvent()
+ *
+ *  This method is used for saving a section for the trace
+ *  file.  Once MAX_TRACE_EVENTS are saved, the oldest ones
+ *  are replaced.
+ ***********************************************************/
+void FrameProfiler::AddTraceEvent(int section, bool bGpu, double startUs, double durationUs)
+{
+	TRACE_EVENT traceEvent;
+	traceEvent.section = section;
+	traceEvent.bGpu = bGpu;
+	traceEvent.startUs = startUs;
+	traceEvent.durationUs = durationUs;
+
+	if ((int)m_traceEvents.size() < MAX_TRACE_EVENTS)
+	{
+		m_traceEvents.push_back(traceEvent);
+	}
+	else
+	{
+		m_traceEvents[m_nextTraceEvent] = traceEvent;
+	}
+	m_nextTraceEvent = (m_nextTraceEvent + 1) % MAX_TRACE_EVENTS;
+}
+
+/***********************************************************
+ *  CloseFrame()
+ *
+ *  This method is used for adding the CPU times of the
+ *  current frame to the history and the trace.  A section
+ *  measured several times in a frame adds up to one time.
+ ***********************************************************/
+void FrameProfiler::CloseFrame()
+{
+	FRAME_SLOT& slot = m_frames[m_currentFrame];
+	float frameMs[MAX_SECTIONS];
+	bool bMeasured[MAX_SECTIONS];
+
+	for (int section = 0; section < MAX_SECTIONS; section++)
+	{
+		frameMs[section] = 0.0f;
+		bMeasured[section] = false;
+	}
+
+	for (int event = 0; event < slot.eventCount; event++)
+	{
+		const PROFILE_EVENT& profileEvent = slot.events[event];
+		if (profileEvent.bEnded == false)
+		{
+			continue;
+		}
+
+		double durationUs = profileEvent.cpuEndUs - profileEvent.cpuStartUs;
+		frameMs[profileEvent.section] += (float)(durationUs / 1000.0);
+		bMeasured[profileEvent.section] = true;
+		AddTraceEvent(profileEvent.section, false, profileEvent.cpuStartUs, durationUs);
+	}
+
+	for (int section = 0; section < (int)m_sectionNames.size(); section++)
+	{
+		if (bMeasured[section] == true)
+		{
+			AddSample(section, false, frameMs[section]);
+		}
+	}
+
+	slot.bPending = (slot.eventCount > 0);
+}
+
+/***********************************************************
+ *  ResolveFrame()
+ *
+ *  This method is used for reading the timestamp queries of
+ *  a frame slot, and adding the GPU times to the history and
+ *  the trace.  The GPU runs the queries in order, so when the
+ *  last one is finished they all are.  Without waiting, a
+ *  frame whose queries are not finished loses its GPU times
+ *  rather than stalling the CPU.
+ ***********************************************************/
+void FrameProfiler::ResolveFrame(int frame, bool bWait)
+{
+	FRAME_SLOT& slot = m_frames[frame];
+	if (slot.bPending == false)
+	{
+		return;
+	}
+	slot.bPending = false;
+
+	if (bWait == false)
+	{
+		GLuint available = 0;
+		glGetQueryObjectuiv(slot.queries[slot.lastQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == 0)
+		{
+			m_droppedGpuFrames++;
+			return;
+		}
+	}
+
+	float frameMs[MAX_SECTIONS];
+	bool bMeasured[MAX_SECTIONS];
+	for (int section = 0; section < MAX_SECTIONS; section++)
+	{
+		frameMs[section] = 0.0f;
+		bMeasured[section] = false;
+	}
+
+	for (int event = 0; event < slot.eventCount; event++)
+	{
+		const PROFILE_EVENT& profileEvent = slot.events[event];
+		if (profileEvent.bEnded == false)
+		{
+			continue;
+		}
+
+		GLuint64 startNs = 0;
+		GLuint64 endNs = 0;
+		glGetQueryObjectui64v(slot.queries[event * 2], GL_QUERY_RESULT, &startNs);
+		glGetQueryObjectui64v(slot.queries[event * 2 + 1], GL_QUERY_RESULT, &endNs);
+
+		double durationUs = 0.0;
+		if (endNs > startNs)
+		{
+			durationUs = (double)(endNs - startNs) / 1000.0;
+		}
+		double startUs = ((double)startNs - (double)m_gpuEpochNs) / 1000.0;
+
+		frameMs[profileEvent.section] += (float)(durationUs / 1000.0);
+		bMeasured[profileEvent.section] = true;
+		AddTraceEvent(profileEvent.section, true, startUs, durationUs);
+	}
+
+	for (int section = 0; section < (int)m_sectionNames.size(); section++)
+	{
+		if (bMeasured[section] == true)
+		{
+			AddSample(section, true, frameMs[section]);
+		}
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for closing the current frame and
+ *  starting the next one in the other frame slot.  The queries
+ *  left in that slot were issued two frames ago, and are read
+ *  before the slot is reused.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	if (m_bInitialized == false)
+	{
+		return;
+	}
+
+	CloseFrame();
+
+	m_currentFrame = (m_currentFrame + 1) % QUERY_FRAMES;
+	ResolveFrame(m_currentFrame, false);
+	m_frames[m_currentFrame].eventCount = 0;
+	m_frames[m_currentFrame].lastQuery = -1;
+}
+
+/***********************************************************
+ *  Finish()
+ *
+ *  This method is used for closing the last frame and reading
+ *  every query still in flight, oldest first, waiting for the
+ *  GPU if needed.  It is called once the rendering is done.
+ ***********************************************************/
+void FrameProfiler::Finish()
+{
+	if (m_bInitialized == false)
+	{
+		return;
+	}
+
+	CloseFrame();
+
+	for (int i = 1; i <= QUERY_FRAMES; i++)
+	{
+		ResolveFrame((m_currentFrame + i) % QUERY_FRAMES, true);
+	}
+	m_frames[m_currentFrame].eventCount = 0;
+	m_frames[m_currentFrame].lastQuery = -1;
+}
+
+/***********************************************************
+ *  GetSectionCount()
+ *
+ *  This method is used for getting the number of named
+ *  sections measured so far.
+ ***********************************************************/
+int FrameProfiler::GetSectionCount() const
+{
+	return((int)m_sectionNames.size());
+}
+
+/***********************************************************
+ *  GetSectionName()
+ *
+ *  This method is used for getting the name of a section.
+ ***********************************************************/
+const std::string& FrameProfiler::GetSectionName(int section) const
+{
+	if ((section < 0) || (section >= (int)m_sectionNames.size()))
+	{
+		return(g_UnknownSection);
+	}
+	return(m_sectionNames[section]);
+}
+
+/***********************************************************
+ *  CalculateStats()
+ *
+ *  This method is used for calculating the minimum, average
+ *  and 99th percentile of a list of times.  The percentile is
+ *  the smallest time that at least 99% of the times are not
+ *  above.
+ ***********************************************************/
+FrameProfiler::SECTION_STATS FrameProfiler::CalculateStats(const float* pSamples, int count)
+{
+	SECTION_STATS stats;
+	stats.minMs = 0.0f;
+	stats.avgMs = 0.0f;
+	stats.p99Ms = 0.0f;
+	stats.samples = count;
+
+	if (count <= 0)
+	{
+		return(stats);
+	}
+
+	std::vector<float> sorted(pSamples, pSamples + count);
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0.0;
+	for (int i = 0; i < count; i++)
+	{
+		total += sorted[i];
+	}
+
+	int percentile = (count * 99 + 99) / 100 - 1;
+	stats.minMs = sorted[0];
+	stats.avgMs = (float)(total / count);
+	stats.p99Ms = sorted[std::min(std::max(percentile, 0), count - 1)];
+
+	return(stats);
+}
+
+/***********************************************************
+ *  GetCpuStats()
+ *
+ *  This method is used for getting the statistics of the CPU
+ *  time of a section over the last frames.
+ ***********************************************************/
+FrameProfiler::SECTION_STATS FrameProfiler::GetCpuStats(int section) const
+{
+	if ((section < 0) || (section >= (int)m_history.size()))
+	{
+		return(CalculateStats(NULL, 0));
+	}
+	return(CalculateStats(m_history[section].cpuMs, m_history[section].cpuCount));
+}
+
+/***********************************************************
+ *  GetGpuStats()
+ *
+ *  This method is used for getting the statistics of the GPU
+ *  time of a section over the last frames.
+ ***********************************************************/
+FrameProfiler::SECTION_STATS FrameProfiler::GetGpuStats(int section) const
+{
+	if ((section < 0) || (section >= (int)m_history.size()))
+	{
+		return(CalculateStats(NULL, 0));
+	}
+	return(CalculateStats(m_history[section].gpuMs, m_history[section].gpuCount));
+}
+
+/***********************************************************
+ *  PrintStats()
+ *
+ *  This method is used for printing the minimum, average and
+ *  99th percentile of the CPU and GPU time of every section
+ *  to the console.
+ ***********************************************************/
+void FrameProfiler::PrintStats() const
+{
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "INFO: profile over the last " << HISTORY_FRAMES
+		<< " frames (min / avg / p99 ms), GPU frames dropped: " << m_droppedGpuFrames << std::endl;
+
+	for (int section = 0; section < (int)m_sectionNames.size(); section++)
+	{
+		SECTION_STATS cpuStats = GetCpuStats(section);
+		SECTION_STATS gpuStats = GetGpuStats(section);
+		std::cout << "INFO:   " << std::left << std::setw(24) << m_sectionNames[section] << std::right
+			<< " CPU " << cpuStats.minMs << " / " << cpuStats.avgMs << " / " << cpuStats.p99Ms
+			<< "  GPU " << gpuStats.minMs << " / " << gpuStats.avgMs << " / " << gpuStats.p99Ms
+			<< std::endl;
+	}
+	std::cout.unsetf(std::ios::floatfield);
+	std::cout << std::setprecision(6);
+}
+
+/***********************************************************
+ *  WriteChromeTrace()
+ *
+ *  This method is used for saving the traced sections in the
+ *  Chrome trace event format.  Every section is a complete
+ *  event, with the CPU sections on one track and the GPU
+ *  sections on another, in microseconds since the profiler
+ *  was initialized.
+ ***********************************************************/
+bool FrameProfiler::WriteChromeTrace(const char* filename) const
+{
+	std::ofstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not write profile trace:" << filename << std::endl;
+		return(false);
+	}
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << g_CpuTraceThread
+		<< ",\"args\":{\"name\":\"CPU\"}},\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << g_GpuTraceThread
+		<< ",\"args\":{\"name\":\"GPU\"}}";
+
+	// once the ring is full, the oldest event is the next one
+	// to be replaced
+	int count = (int)m_traceEvents.size();
+	int first = 0;
+	if (count == MAX_TRACE_EVENTS)
+	{
+		first = m_nextTraceEvent;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		const TRACE_EVENT& traceEvent = m_traceEvents[(first + i) % count];
+		file << ",\n{\"name\":\"" << m_sectionNames[traceEvent.section]
+			<< "\",\"cat\":\"" << ((traceEvent.bGpu == true) ? "gpu" : "cpu")
+			<< "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+			<< ((traceEvent.bGpu == true) ? g_GpuTraceThread : g_CpuTraceThread)
+			<< ",\"ts\":" << traceEvent.startUs
+			<< ",\"dur\":" << traceEvent.durationUs << "}";
+	}
+	file << "\n]}\n";
+
+	std::cout << "INFO: wrote " << count << " profile events to " << filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  ProfileScope()
+ *
+ *  The constructor for the class, which begins measuring the
+ *  named section.
+ ***********************************************************/
+ProfileScope::ProfileScope(FrameProfiler* pProfiler, const char* name)
+{
+	m_pProfiler = pProfiler;
+	m_event = -1;
+	if (NULL != m_pProfiler)
+	{
+		m_event = m_pProfiler->BeginSection(name);
+	}
+}
+
+/***********************************************************
+ *  ~ProfileScope()
+ *
+ *  The destructor for the class, which ends measuring the
+ *  section.
+ ***********************************************************/
+ProfileScope::~ProfileScope()
+{
+	if (NULL != m_pProfiler)
+	{
+		m_pProfiler->EndSection(m_event);
+	}
+}
@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// measure the CPU and GPU time of named sections of each frame
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FrameProfiler
+ *
+ *  This class measures where the time of a frame goes.  Each
+ *  named section records its CPU time with a steady clock,
+ *  and its GPU time with a pair of timestamp queries.  The
+ *  queries of a frame are read two frames later, when the
+ *  GPU has long finished them, so reading them never stalls.
+ *  The times of the last frames are kept for the minimum,
+ *  average and 99th percentile of every section, and the
+ *  sections can be saved as a Chrome trace file.
+ ***********************************************************/
+class FrameProfiler
+{
+public:
+	// constructor
+	FrameProfiler();
+	// destructor
+	~FrameProfiler();
+
+	// largest number of different section names
+	static const int MAX_SECTIONS = 32;
+	// largest number of sections measured in one frame
+	static const int MAX_EVENTS_PER_FRAME = 64;
+	// frames whose queries are in flight before being read
+	static const int QUERY_FRAMES = 2;
+	// frames the statistics are calculated over
+	static const int HISTORY_FRAMES = 240;
+	// largest number of sections kept for the trace file
+	static const int MAX_TRACE_EVENTS = 100000;
+
+	// time statistics of a section over the last frames
+	struct SECTION_STATS
+	{
+		float minMs;
+		float avgMs;
+		float p99Ms;
+		int samples;
+	};
+
+private:
+	// one measured section of a frame
+	struct PROFILE_EVENT
+	{
+		int section;
+		double cpuStartUs;
+		double cpuEndUs;
+		bool bEnded;
+	};
+
+	// the sections of one frame and their timestamp queries,
+	// two per section
+	struct FRAME_SLOT
+	{
+		PROFILE_EVENT events[MAX_EVENTS_PER_FRAME];
+		GLuint queries[MAX_EVENTS_PER_FRAME * 2];
+		int eventCount;
+		// query issued last, which finishes after all the others
+		int lastQuery;
+		// true while the queries of the slot are not yet read
+		bool bPending;
+	};
+
+	// one section saved for the trace file
+	struct TRACE_EVENT
+	{
+		int section;
+		bool bGpu;
+		double startUs;
+		double durationUs;
+	};
+
+	// times of one section in the last frames
+	struct SECTION_HISTORY
+	{
+		float cpuMs[HISTORY_FRAMES];
+		float gpuMs[HISTORY_FRAMES];
+		int cpuCount;
+		int gpuCount;
+		int cpuNext;
+		int gpuNext;
+	};
+
+	// true once the queries are created
+	bool m_bInitialized;
+	// false when the sections are not measured
+	bool m_bEnabled;
+	// names of the sections, indexed by section
+	std::vector<std::string> m_sectionNames;
+	// times of the sections, indexed by section
+	std::vector<SECTION_HISTORY> m_history;
+
+	// frames whose sections are measured in turn
+	FRAME_SLOT m_frames[QUERY_FRAMES];
+	int m_currentFrame;
+	// number of frames whose GPU times were lost because their
+	// queries were not finished in time
+	int m_droppedGpuFrames;
+
+	// CPU and GPU time at which the profiler was initialized,
+	// which the trace times are measured from
+	std::chrono::steady_clock::time_point m_cpuEpoch;
+	GLint64 m_gpuEpochNs;
+
+	// sections saved for the trace file, as a ring holding the
+	// most recent ones
+	std::vector<TRACE_EVENT> m_traceEvents;
+	int m_nextTraceEvent;
+
+	// get the microseconds since the profiler was initialized
+	double GetCpuMicroseconds() const;
+	// get the index of a named section, adding it when new
+	int FindSection(const char* name);
+	// add the time of a section to its history
+	void AddSample(int section, bool bGpu, float milliseconds);
+	// add a section to the trace
+	void AddTraceEvent(int section, bool bGpu, double startUs, double durationUs);
+	// add the CPU times of the current frame to the history
+	void CloseFrame();
+	// read the GPU times of a frame slot, optionally waiting for
+	// the queries to finish
+	void ResolveFrame(int frame, bool bWait);
+	// calculate the statistics of a list of times
+	static SECTION_STATS CalculateStats(const float* pSamples, int count);
+
+public:
+	// create the timestamp queries - the OpenGL context must be
+	// current, and the startup sections count as the first frame
+	void Initialize();
+	// switch the measuring on or off
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const;
+
+	// close the current frame and start measuring the next one
+	void BeginFrame();
+	// close the last frame and read all queries still in flight
+	void Finish();
+
+	// start measuring a section, returning the index used to
+	// end it, or -1 when the section is not measured
+	int BeginSection(const char* name);
+	// end measuring a section
+	void EndSection(int event);
+
+	// get the number of named sections
+	int GetSectionCount() const;
+	// get the name of a section
+	const std::string& GetSectionName(int section) const;
+	// get the CPU and GPU time statistics of a section
+	SECTION_STATS GetCpuStats(int section) const;
+	SECTION_STATS GetGpuStats(int section) const;
+	// print the statistics of every section to the console
+	void PrintStats() const;
+
+	// save the traced sections as Chrome trace JSON, which can
+	// be opened with chrome://tracing or Perfetto
+	bool WriteChromeTrace(const char* filename) const;
+};
+
+/***********************************************************
+ *  ProfileScope
+ *
+ *  This class measures a section for as long as the object
+ *  lives, so a section ends on every return of the block it
+ *  is declared in.  A NULL profiler measures nothing.
+ ***********************************************************/
+class ProfileScope
+{
+public:
+	// constructor, which begins the section
+	ProfileScope(FrameProfiler* pProfiler, const char* name);
+	// destructor, which ends the section
+	~ProfileScope();
+
+private:
+	FrameProfiler* m_pProfiler;
+	int m_event;
+};
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustum.cpp
+// ============
+// test bounding volumes against the planes of the view frustum
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Frustum.h"
+
+/***********************************************************
+ *  Frustum()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+Frustum::Frustum()
+{
+	// until planes are extracted nothing is culled
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		m_planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+/***********************************************************
+ *  ~Frustum()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+Frustum::~Frustum()
+{
+}
+
+/***********************************************************
+ *  ExtractPlanes()
+ *
+ *  This method is used for taking the six frustum planes from
+ *  the combined projection * view matrix.  Each plane is the
+ *  sum or difference of the fourth row of the matrix and one
+ *  of the other rows, normalized so that plane distances are
+ *  in world units.
+ ***********************************************************/
+void Frustum::ExtractPlanes(const glm::mat4& viewProjection)
+{
+	// glm matrices are indexed by column, so the rows are built
+	glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+	glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+	glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+	glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+	m_planes[0] = row3 + row0;
+	m_planes[1] = row3 - row0;
+	m_planes[2] = row3 + row1;
+	m_planes[3] = row3 - row1;
+	m_planes[4] = row3 + row2;
+	m_planes[5] = row3 - row2;
+
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		float length = glm::length(glm::vec3(m_planes[i]));
+		if (length > 0.0f)
+		{
+			m_planes[i] /= length;
+		}
+	}
+}
+
+/***********************************************************
+ *  TestBox()
+ *
+ *  This method is used for testing a bounding box against the
+ *  frustum.  For each plane only the box corner farthest along
+ *  the plane normal is needed to find a box that is entirely
+ *  outside, and the nearest corner to find one that is not
+ *  entirely inside.
+ ***********************************************************/
+Frustum::CULL_RESULT Frustum::TestBox(const BOUNDING_BOX& box) const
+{
+	CULL_RESULT result = CULL_INSIDE;
+
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		const glm::vec4& plane = m_planes[i];
+		glm::vec3 farCorner(
+			(plane.x >= 0.0f) ? box.maximum.x : box.minimum.x,
+			(plane.y >= 0.0f) ? box.maximum.y : box.minimum.y,
+			(plane.z >= 0.0f) ? box.maximum.z : box.minimum.z);
+		glm::vec3 nearCorner(
+			(plane.x >= 0.0f) ? box.minimum.x : box.maximum.x,
+			(plane.y >= 0.0f) ? box.minimum.y : box.maximum.y,
+			(plane.z >= 0.0f) ? box.minimum.z : box.maximum.z);
+
+		if (glm::dot(glm::vec3(plane), farCorner) + plane.w < 0.0f)
+		{
+			return(CULL_OUTSIDE);
+		}
+		if (glm::dot(glm::vec3(plane), nearCorner) + plane.w < 0.0f)
+		{
+			result = CULL_INTERSECTING;
+		}
+	}
+
+	return(result);
+}
+
+/***********************************************************
+ *  TestSphere()
+ *
+ *  This method is used for testing whether a bounding sphere
+ *  is at least partly inside the frustum.
+ ***********************************************************/
+bool Frustum::TestSphere(const glm::vec3& center, float radius) const
+{
+	for (int i = 0; i < PLANE_COUNT; i++)
+	{
+		if (glm::dot(glm::vec3(m_planes[i]), center) + m_planes[i].w < -radius)
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetPlane()
+ *
+ *  This method is used for getting one of the frustum planes.
+ ***********************************************************/
+const glm::vec4& Frustum::GetPlane(int plane) const
+{
+	return(m_planes[plane]);
+}
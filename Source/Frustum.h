@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustum.h
+// ============
+// test bounding volumes against the planes of the view frustum
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+// axis-aligned bounding box in world space
+struct BOUNDING_BOX
+{
+	glm::vec3 minimum;
+	glm::vec3 maximum;
+};
+
+/***********************************************************
+ *  Frustum
+ *
+ *  This class holds the six planes of the view frustum, taken
+ *  from the combined projection and view matrix, and tests
+ *  bounding volumes against them.
+ ***********************************************************/
+class Frustum
+{
+public:
+	// constructor
+	Frustum();
+	// destructor
+	~Frustum();
+
+	// number of frustum planes - left, right, bottom, top, near, far
+	static const int PLANE_COUNT = 6;
+
+	// result of testing a bounding volume against the frustum
+	enum CULL_RESULT
+	{
+		CULL_OUTSIDE = 0,
+		CULL_INTERSECTING,
+		CULL_INSIDE
+	};
+
+private:
+	// planes as (normal, distance), with the normals pointing
+	// into the frustum
+	glm::vec4 m_planes[PLANE_COUNT];
+
+public:
+	// take the frustum planes from a projection * view matrix
+	void ExtractPlanes(const glm::mat4& viewProjection);
+
+	// test a bounding box against the frustum
+	CULL_RESULT TestBox(const BOUNDING_BOX& box) const;
+	// test a bounding sphere against the frustum
+	bool TestSphere(const glm::vec3& center, float radius) const;
+
+	// get one of the frustum planes
+	const glm::vec4& GetPlane(int plane) const;
+};
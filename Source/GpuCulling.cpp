@@ -0,0 +1,459 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuculling.cpp
+// ============
+// cull the instanced objects against the view frustum with a compute shader
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuCulling.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// declaration of global variables
+namespace
+{
+	// shader storage bindings of the buffers, matching the
+	// binding layouts of the culling shader
+	const GLuint g_ObjectBinding = 5;
+	const GLuint g_RecordBinding = 6;
+	const GLuint g_VisibleRecordBinding = 7;
+	const GLuint g_CommandBinding = 8;
+
+	// objects culled by each work group, matching the local
+	// size of the culling shader
+	const int g_WorkGroupSize = 64;
+
+	// oldest OpenGL version with compute shaders
+	const GLint g_ComputeMajorVersion = 4;
+	const GLint g_ComputeMinorVersion = 3;
+}
+
+/***********************************************************
+ *  GpuCulling()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuCulling::GpuCulling()
+{
+	m_program = 0;
+	m_objectCountLocation = -1;
+	m_frustumPlanesLocation = -1;
+	m_cameraPositionLocation = -1;
+	m_projectionScaleLocation = -1;
+	m_perspectiveLocation = -1;
+	m_lodScreenSizesLocation = -1;
+	m_lodHysteresisLocation = -1;
+	m_objectBuffer = 0;
+	m_recordBuffer = 0;
+	m_visibleRecordBuffer = 0;
+	m_commandTemplateBuffer = 0;
+	m_commandBuffer = 0;
+	m_readbackBuffer = 0;
+	m_readbackFence = 0;
+	m_objectCount = 0;
+	m_commandCount = 0;
+	m_lodHysteresis = 0.0f;
+}
+
+/***********************************************************
+ *  ~GpuCulling()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuCulling::~GpuCulling()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for checking that the context runs
+ *  compute shaders, loading the culling shader and creating
+ *  the buffers.  Any failure leaves the culling unavailable.
+ ***********************************************************/
+bool GpuCulling::Initialize(const char* shaderFilename)
+{
+	GLint majorVersion = 0;
+	GLint minorVersion = 0;
+
+	Destroy();
+
+	glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+	glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+	if ((majorVersion < g_ComputeMajorVersion) ||
+		((majorVersion == g_ComputeMajorVersion) && (minorVersion < g_ComputeMinorVersion)))
+	{
+		std::cout << "OpenGL " << majorVersion << "." << minorVersion
+			<< " has no compute shaders" << std::endl;
+		return(false);
+	}
+
+	if (LoadProgram(shaderFilename) == false)
+	{
+		return(false);
+	}
+
+	m_objectCountLocation = glGetUniformLocation(m_program, "objectCount");
+	m_frustumPlanesLocation = glGetUniformLocation(m_program, "frustumPlanes");
+	m_cameraPositionLocation = glGetUniformLocation(m_program, "cameraPosition");
+	m_projectionScaleLocation = glGetUniformLocation(m_program, "projectionScale");
+	m_perspectiveLocation = glGetUniformLocation(m_program, "bPerspective");
+	m_lodScreenSizesLocation = glGetUniformLocation(m_program, "lodScreenSizes");
+	m_lodHysteresisLocation = glGetUniformLocation(m_program, "lodHysteresis");
+
+	glGenBuffers(1, &m_objectBuffer);
+	glGenBuffers(1, &m_recordBuffer);
+	glGenBuffers(1, &m_visibleRecordBuffer);
+	glGenBuffers(1, &m_commandTemplateBuffer);
+	glGenBuffers(1, &m_commandBuffer);
+	glGenBuffers(1, &m_readbackBuffer);
+
+	return(true);
+}
+
+/***********************************************************
+ *  LoadProgram()
+ *
+ *  This method is used for reading the culling shader from a
+ *  file, and compiling and linking it into a program.  The
+ *  info log is printed when either step fails.
+ ***********************************************************/
+bool GpuCulling::LoadProgram(const char* filename)
+{
+	std::ifstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not open culling shader:" << filename << std::endl;
+		return(false);
+	}
+
+	std::stringstream source;
+	source << file.rdbuf();
+	std::string sourceText = source.str();
+	const char* pSource = sourceText.c_str();
+
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	glShaderSource(shader, 1, &pSource, NULL);
+	glCompileShader(shader);
+
+	GLint status = 0;
+	char infoLog[1024];
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status == 0)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "Could not compile culling shader:" << filename << std::endl << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(false);
+	}
+
+	m_program = glCreateProgram();
+	glAttachShader(m_program, shader);
+	glLinkProgram(m_program);
+	glDeleteShader(shader);
+
+	glGetProgramiv(m_program, GL_LINK_STATUS, &status);
+	if (status == 0)
+	{
+		glGetProgramInfoLog(m_program, sizeof(infoLog), NULL, infoLog);
+		std::cout << "Could not link culling shader:" << filename << std::endl << infoLog << std::endl;
+		glDeleteProgram(m_program);
+		m_program = 0;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the program and the
+ *  buffers.
+ ***********************************************************/
+void GpuCulling::Destroy()
+{
+	if (0 != m_program)
+	{
+		glDeleteProgram(m_program);
+		m_program = 0;
+	}
+
+	if (0 != m_objectBuffer)
+	{
+		glDeleteBuffers(1, &m_objectBuffer);
+		glDeleteBuffers(1, &m_recordBuffer);
+		glDeleteBuffers(1, &m_visibleRecordBuffer);
+		glDeleteBuffers(1, &m_commandTemplateBuffer);
+		glDeleteBuffers(1, &m_commandBuffer);
+		glDeleteBuffers(1, &m_readbackBuffer);
+	}
+	if (0 != m_readbackFence)
+	{
+		glDeleteSync(m_readbackFence);
+	}
+	m_objectBuffer = 0;
+	m_recordBuffer = 0;
+	m_visibleRecordBuffer = 0;
+	m_commandTemplateBuffer = 0;
+	m_commandBuffer = 0;
+	m_readbackBuffer = 0;
+	m_readbackFence = 0;
+	m_readbackCommands.clear();
+	m_objectCount = 0;
+	m_commandCount = 0;
+}
+
+/***********************************************************
+ *  IsAvailable()
+ *
+ *  This method is used for checking whether the compute
+ *  shader was loaded, so the objects can be culled with it.
+ ***********************************************************/
+bool GpuCulling::IsAvailable() const
+{
+	return(0 != m_program);
+}
+
+/***********************************************************
+ *  SetLodScreenSizes()
+ *
+ *  This method is used for setting the screen sizes at which
+ *  the coarser levels of detail are chosen, and the share of
+ *  a threshold the size has to pass it by.  The values match
+ *  the ones used on the CPU, so both choose the same levels.
+ ***********************************************************/
+void GpuCulling::SetLodScreenSizes(const float* screenSizes, int count, float hysteresis)
+{
+	m_lodScreenSizes.assign(screenSizes, screenSizes + count);
+	m_lodHysteresis = hysteresis;
+}
+
+/***********************************************************
+ *  SetObjects()
+ *
+ *  This method is used for uploading the bounds and records of
+ *  the objects, and the commands of each batch and level of
+ *  detail.  It only needs to be called again when the objects
+ *  have moved.
+ ***********************************************************/
+void GpuCulling::SetObjects(
+	const std::vector<CULL_OBJECT>& objects,
+	const std::vector<PrimitiveMeshes::INSTANCE_DATA>& records,
+	const std::vector<PrimitiveMeshes::INDIRECT_COMMAND>& commands,
+	int visibleRecordCount)
+{
+	if (IsAvailable() == false)
+	{
+		return;
+	}
+
+	m_objectCount = (int)objects.size();
+	m_commandCount = (int)commands.size();
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_objectBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, objects.size() * sizeof(CULL_OBJECT), objects.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_recordBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, records.size() * sizeof(PrimitiveMeshes::INSTANCE_DATA), records.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visibleRecordBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, visibleRecordCount * sizeof(PrimitiveMeshes::INSTANCE_DATA), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandTemplateBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(PrimitiveMeshes::INDIRECT_COMMAND), commands.data(), GL_STATIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, commands.size() * sizeof(PrimitiveMeshes::INDIRECT_COMMAND), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	// a copy still in flight holds the old commands, so it is
+	// dropped and the counts start from none visible
+	if (0 != m_readbackFence)
+	{
+		glDeleteSync(m_readbackFence);
+		m_readbackFence = 0;
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_readbackBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, commands.size() * sizeof(PrimitiveMeshes::INDIRECT_COMMAND), NULL, GL_STREAM_READ);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	m_readbackCommands = commands;
+}
+
+/***********************************************************
+ *  Cull()
+ *
+ *  This method is used for culling the objects for the passed
+ *  in view.  The commands are reset by copying the templates
+ *  over them, and then one shader invocation tests each
+ *  object, adds it to the command of its level of detail and
+ *  copies its record into the room of that command.  The
+ *  barrier makes the written commands and records visible to
+ *  the draws that follow.  The counted commands are also
+ *  copied for reading back on a later frame, once the GPU is
+ *  done with them, so the counts never stall the frame.
+ ***********************************************************/
+void GpuCulling::Cull(
+	const Frustum& frustum,
+	const glm::mat4& projection,
+	const glm::vec3& cameraPosition)
+{
+	if ((IsAvailable() == false) || (m_objectCount == 0))
+	{
+		return;
+	}
+
+	ReadBackCommands();
+
+	glBindBuffer(GL_COPY_READ_BUFFER, m_commandTemplateBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandBuffer);
+	glCopyBufferSubData(
+		GL_COPY_READ_BUFFER,
+		GL_COPY_WRITE_BUFFER,
+		0,
+		0,
+		m_commandCount * sizeof(PrimitiveMeshes::INDIRECT_COMMAND));
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// the program of the scene is put back once the objects
+	// are culled
+	GLint sceneProgram = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &sceneProgram);
+	glUseProgram(m_program);
+
+	glm::vec4 planes[Frustum::PLANE_COUNT];
+	for (int i = 0; i < Frustum::PLANE_COUNT; i++)
+	{
+		planes[i] = frustum.GetPlane(i);
+	}
+	glUniform1ui(m_objectCountLocation, (GLuint)m_objectCount);
+	glUniform4fv(m_frustumPlanesLocation, Frustum::PLANE_COUNT, &planes[0].x);
+	glUniform3fv(m_cameraPositionLocation, 1, &cameraPosition.x);
+	glUniform1f(m_projectionScaleLocation, projection[1][1]);
+	// only a perspective projection divides by the distance
+	glUniform1i(m_perspectiveLocation, (projection[2][3] != 0.0f) ? 1 : 0);
+	if (m_lodScreenSizes.empty() == false)
+	{
+		glUniform1fv(m_lodScreenSizesLocation, (GLsizei)m_lodScreenSizes.size(), m_lodScreenSizes.data());
+	}
+	glUniform1f(m_lodHysteresisLocation, m_lodHysteresis);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_ObjectBinding, m_objectBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_RecordBinding, m_recordBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_VisibleRecordBinding, m_visibleRecordBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_CommandBinding, m_commandBuffer);
+
+	glDispatchCompute((m_objectCount + g_WorkGroupSize - 1) / g_WorkGroupSize, 1, 1);
+	// the draws read the commands and records, the next
+	// dispatch reads the levels of detail chosen by this one,
+	// and the readback copies the commands
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+		GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	glUseProgram((GLuint)sceneProgram);
+
+	// only one copy is in flight at a time, so the copy being
+	// waited on is never overwritten
+	if (0 == m_readbackFence)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, m_commandBuffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_readbackBuffer);
+		glCopyBufferSubData(
+			GL_COPY_READ_BUFFER,
+			GL_COPY_WRITE_BUFFER,
+			0,
+			0,
+			m_commandCount * sizeof(PrimitiveMeshes::INDIRECT_COMMAND));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		m_readbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+/***********************************************************
+ *  ReadBackCommands()
+ *
+ *  This method is used for reading the copied commands back
+ *  when the fence placed after the copy has been signaled.
+ *  The fence is only polled, never waited on, so a copy the
+ *  GPU has not reached yet is read on a later frame and the
+ *  last counts read are kept until then.
+ ***********************************************************/
+void GpuCulling::ReadBackCommands()
+{
+	if (0 == m_readbackFence)
+	{
+		return;
+	}
+
+	GLenum result = glClientWaitSync(m_readbackFence, 0, 0);
+	if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED))
+	{
+		return;
+	}
+	glDeleteSync(m_readbackFence);
+	m_readbackFence = 0;
+
+	m_readbackCommands.resize(m_commandCount);
+	glBindBuffer(GL_COPY_READ_BUFFER, m_readbackBuffer);
+	glGetBufferSubData(
+		GL_COPY_READ_BUFFER,
+		0,
+		m_commandCount * sizeof(PrimitiveMeshes::INDIRECT_COMMAND),
+		m_readbackCommands.data());
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+/***********************************************************
+ *  GetCommandBuffer()
+ *
+ *  This method is used for getting the buffer of commands
+ *  filled in by the last Cull().
+ ***********************************************************/
+GLuint GpuCulling::GetCommandBuffer() const
+{
+	return(m_commandBuffer);
+}
+
+/***********************************************************
+ *  GetVisibleRecordBuffer()
+ *
+ *  This method is used for getting the buffer holding the
+ *  records of the objects that passed the last Cull().
+ ***********************************************************/
+GLuint GpuCulling::GetVisibleRecordBuffer() const
+{
+	return(m_visibleRecordBuffer);
+}
+
+/***********************************************************
+ *  GetObjectCount()
+ *
+ *  This method is used for getting the number of objects that
+ *  are culled on the GPU.
+ ***********************************************************/
+int GpuCulling::GetObjectCount() const
+{
+	return(m_objectCount);
+}
+
+/***********************************************************
+ *  GetVisibleInstanceCount()
+ *
+ *  This method is used for getting the number of visible
+ *  copies the shader counted into a command.  The count was
+ *  read back from an earlier frame, usually the one before,
+ *  so it is only meant for statistics.
+ ***********************************************************/
+int GpuCulling::GetVisibleInstanceCount(int command) const
+{
+	if ((command < 0) || (command >= (int)m_readbackCommands.size()))
+	{
+		return(0);
+	}
+	return((int)m_readbackCommands[command].instanceCount);
+}
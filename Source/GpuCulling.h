@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuculling.h
+// ============
+// cull the instanced objects against the view frustum with a compute shader
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Frustum.h"
+#include "PrimitiveMeshes.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  GpuCulling
+ *
+ *  This class tests the bounds of every instanced object
+ *  against the view frustum in a compute shader, and chooses
+ *  the level of detail of each visible object the same way
+ *  the CPU does.  The records of the visible objects are
+ *  packed into a record buffer, and the number of them is
+ *  counted straight into an indirect command for each batch
+ *  and level, so the draws never wait for the CPU.  Compute
+ *  shaders need OpenGL 4.3, and Initialize() fails without
+ *  them so the caller can keep culling on the CPU.
+ ***********************************************************/
+class GpuCulling
+{
+public:
+	// constructor
+	GpuCulling();
+	// destructor
+	~GpuCulling();
+
+	// std430 layout of one object in the object buffer
+	struct CULL_OBJECT
+	{
+		// world space bounds as a center and a half size
+		glm::vec4 center;
+		glm::vec4 extent;
+		// first indirect command of the object's batch - the
+		// command of each level follows it
+		GLuint firstCommand;
+		// number of levels of detail of the object's mesh
+		int lodCount;
+		// level of detail chosen on the last frame
+		int lod;
+		int padding;
+	};
+
+private:
+	// the linked compute program
+	GLuint m_program;
+	// uniform locations of the compute program
+	GLint m_objectCountLocation;
+	GLint m_frustumPlanesLocation;
+	GLint m_cameraPositionLocation;
+	GLint m_projectionScaleLocation;
+	GLint m_perspectiveLocation;
+	GLint m_lodScreenSizesLocation;
+	GLint m_lodHysteresisLocation;
+
+	// objects and their records, read by the compute shader
+	GLuint m_objectBuffer;
+	GLuint m_recordBuffer;
+	// records of the visible objects, written by the shader
+	GLuint m_visibleRecordBuffer;
+	// commands with no copies, copied over the commands at the
+	// start of every frame
+	GLuint m_commandTemplateBuffer;
+	// commands counted by the shader and read by the draws
+	GLuint m_commandBuffer;
+	// copy of the counted commands for reading back, and the
+	// fence signaled once the copy is done
+	GLuint m_readbackBuffer;
+	GLsync m_readbackFence;
+	// commands read back from an earlier frame
+	std::vector<PrimitiveMeshes::INDIRECT_COMMAND> m_readbackCommands;
+	// number of objects and commands in the buffers
+	int m_objectCount;
+	int m_commandCount;
+
+	// screen sizes below which each coarser level is used
+	std::vector<float> m_lodScreenSizes;
+	float m_lodHysteresis;
+
+	// compile and link the compute shader from a file
+	bool LoadProgram(const char* filename);
+	// read the copied commands back if the GPU is done with them
+	void ReadBackCommands();
+
+public:
+	// check for compute shader support and load the shader,
+	// returning false when culling has to stay on the CPU
+	bool Initialize(const char* shaderFilename);
+	// free the program and the buffers
+	void Destroy();
+	// true when the compute shader is ready to cull
+	bool IsAvailable() const;
+
+	// set the level of detail thresholds used by the CPU
+	void SetLodScreenSizes(const float* screenSizes, int count, float hysteresis);
+
+	// upload the objects, their records and the commands of
+	// each batch and level of detail - the commands must leave
+	// room for every object of a batch at each level, within
+	// the passed in number of visible records
+	void SetObjects(
+		const std::vector<CULL_OBJECT>& objects,
+		const std::vector<PrimitiveMeshes::INSTANCE_DATA>& records,
+		const std::vector<PrimitiveMeshes::INDIRECT_COMMAND>& commands,
+		int visibleRecordCount);
+
+	// cull the objects for the passed in view and fill the
+	// commands with the visible ones
+	void Cull(
+		const Frustum& frustum,
+		const glm::mat4& projection,
+		const glm::vec3& cameraPosition);
+
+	// get the buffers read by the draws
+	GLuint GetCommandBuffer() const;
+	GLuint GetVisibleRecordBuffer() const;
+	// get the number of objects culled on the GPU
+	int GetObjectCount() const;
+	// get the number of visible copies counted into a command,
+	// as read back from an earlier frame
+	int GetVisibleInstanceCount(int command) const;
+};
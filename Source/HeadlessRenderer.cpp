@@ -0,0 +1,360 @@
+///////////////////////////////////////////////////////////////////////////////
+// headlessrenderer.cpp
+// ============
+// render the 3D scene offscreen on machines without a display
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HeadlessRenderer.h"
+#include "SceneManager.h"
+#include "ViewManager.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+/***********************************************************
+ *  HeadlessRenderer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+HeadlessRenderer::HeadlessRenderer()
+{
+	m_display = NULL;
+	m_context = NULL;
+	m_pHiddenWindow = NULL;
+	m_framebuffer = 0;
+	m_colorBuffer = 0;
+	m_depthBuffer = 0;
+	m_width = 0;
+	m_height = 0;
+	m_outputDirectory = "frames";
+	m_pFrameProfiler = NULL;
+}
+
+/***********************************************************
+ *  ~HeadlessRenderer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+HeadlessRenderer::~HeadlessRenderer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  CreateContext()
+ *
+ *  This method is used for creating an OpenGL 4.6 core
+ *  context that does not need a display, and making it
+ *  current.  On Linux the context has no surface at all, so
+ *  everything is drawn into the framebuffer object.  GLEW
+ *  cannot look up GLX functions without a display, so only
+ *  the OpenGL functions of the context are loaded.
+ ***********************************************************/
+bool HeadlessRenderer::CreateContext()
+{
+#ifdef __linux__
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	EGLDisplay display = EGL_NO_DISPLAY;
+
+	// the surfaceless platform needs neither X11 nor a GPU
+	if (NULL != getPlatformDisplay)
+	{
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	if (display == EGL_NO_DISPLAY)
+	{
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+
+	EGLint majorVersion = 0;
+	EGLint minorVersion = 0;
+	if ((display == EGL_NO_DISPLAY) || (eglInitialize(display, &majorVersion, &minorVersion) == EGL_FALSE))
+	{
+		std::cout << "Failed to initialize EGL, error:" << eglGetError() << std::endl;
+		return(false);
+	}
+	m_display = display;
+
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE };
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 6,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE };
+	EGLConfig config = NULL;
+	EGLint configCount = 0;
+
+	eglBindAPI(EGL_OPENGL_API);
+	if ((eglChooseConfig(display, configAttributes, &config, 1, &configCount) == EGL_FALSE) || (configCount == 0))
+	{
+		std::cout << "Failed to find an EGL config, error:" << eglGetError() << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+	if (context == EGL_NO_CONTEXT)
+	{
+		std::cout << "Failed to create an EGL context, error:" << eglGetError() << std::endl;
+		Destroy();
+		return(false);
+	}
+	m_context = context;
+
+	if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_FALSE)
+	{
+		std::cout << "Failed to make the EGL context current, error:" << eglGetError() << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	glewExperimental = GL_TRUE;
+	GLenum GLEWInitResult = glewContextInit();
+#else
+	// a hidden window still needs a desktop session, but never
+	// shows anything on it
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	m_pHiddenWindow = glfwCreateWindow(1, 1, "headless", NULL, NULL);
+	if (NULL == m_pHiddenWindow)
+	{
+		std::cout << "Failed to create a hidden GLFW window" << std::endl;
+		return(false);
+	}
+	glfwMakeContextCurrent(m_pHiddenWindow);
+
+	GLenum GLEWInitResult = glewInit();
+#endif
+
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	std::cout << "INFO: headless OpenGL context created" << std::endl;
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreateFramebuffer()
+ *
+ *  This method is used for creating the framebuffer that the
+ *  frames are drawn into, and binding it with a viewport that
+ *  covers it.
+ ***********************************************************/
+bool HeadlessRenderer::CreateFramebuffer(int width, int height)
+{
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Could not create the offscreen framebuffer, status:" << status << std::endl;
+		return(false);
+	}
+
+	m_width = width;
+	m_height = height;
+	m_pixels.resize((size_t)width * height * 3);
+	glViewport(0, 0, width, height);
+
+	// enable blending for supporting tranparent rendering, the
+	// same as the display window
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetOutputDirectory()
+ *
+ *  This method is used for setting the directory the frames
+ *  are written to.
+ ***********************************************************/
+void HeadlessRenderer::SetOutputDirectory(const std::string& directory)
+{
+	m_outputDirectory = directory;
+}
+
+/***********************************************************
+ *  SetFrameProfiler()
+ *
+ *  This method is used for setting the profiler that measures
+ *  the CPU and GPU time of the frames.
+ ***********************************************************/
+void HeadlessRenderer::SetFrameProfiler(FrameProfiler* pFrameProfiler)
+{
+	m_pFrameProfiler = pFrameProfiler;
+}
+
+/***********************************************************
+ *  WriteFrame()
+ *
+ *  This method is used for reading the pixels of the
+ *  framebuffer and writing them to a binary PPM image file.
+ *  OpenGL returns the rows from the bottom up, so they are
+ *  written in reverse order.
+ ***********************************************************/
+bool HeadlessRenderer::WriteFrame(const std::string& filename)
+{
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE, m_pixels.data());
+
+	FILE* file = fopen(filename.c_str(), "wb");
+	if (NULL == file)
+	{
+		std::cout << "Could not write frame:" << filename << std::endl;
+		return(false);
+	}
+
+	fprintf(file, "P6\n%d %d\n255\n", m_width, m_height);
+	size_t rowSize = (size_t)m_width * 3;
+	for (int row = m_height - 1; row >= 0; row--)
+	{
+		fwrite(&m_pixels[row * rowSize], 1, rowSize, file);
+	}
+	fclose(file);
+
+	return(true);
+}
+
+/***********************************************************
+ *  RenderFrames()
+ *
+ *  This method is used for rendering the scene from each
+ *  camera pose of the camera path, and writing every frame to
+ *  the output directory as frame_0000.ppm, frame_0001.ppm and
+ *  so on.  The camera pose depends only on the frame number,
+ *  so the frames are the same on every run.
+ ***********************************************************/
+bool HeadlessRenderer::RenderFrames(
+	SceneManager* pSceneManager,
+	ViewManager* pViewManager,
+	const CameraPath& cameraPath,
+	int frameCount)
+{
+	if ((NULL == pSceneManager) || (NULL == pViewManager) || (m_framebuffer == 0))
+	{
+		return(false);
+	}
+
+#ifdef _WIN32
+	_mkdir(m_outputDirectory.c_str());
+#else
+	mkdir(m_outputDirectory.c_str(), 0755);
+#endif
+
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		if (NULL != m_pFrameProfiler)
+		{
+			m_pFrameProfiler->BeginFrame();
+		}
+		ProfileScope frameScope(m_pFrameProfiler, "Frame");
+
+		glm::vec3 position;
+		glm::vec3 target;
+		cameraPath.GetPose(frame, frameCount, position, target);
+		pViewManager->SetCameraPose(position, target);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glViewport(0, 0, m_width, m_height);
+		glEnable(GL_DEPTH_TEST);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		pViewManager->PrepareSceneView(1.0f);
+		pSceneManager->RenderScene();
+
+		ProfileScope writeScope(m_pFrameProfiler, "WriteFrame");
+		std::ostringstream filename;
+		filename << m_outputDirectory << "/frame_" << std::setw(4) << std::setfill('0') << frame << ".ppm";
+		if (WriteFrame(filename.str()) == false)
+		{
+			return(false);
+		}
+	}
+
+	std::cout << "INFO: wrote " << frameCount << " frames to " << m_outputDirectory << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the framebuffer and the
+ *  OpenGL context.
+ ***********************************************************/
+void HeadlessRenderer::Destroy()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		glDeleteRenderbuffers(1, &m_colorBuffer);
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+		m_framebuffer = 0;
+		m_colorBuffer = 0;
+		m_depthBuffer = 0;
+	}
+	m_pixels.clear();
+
+#ifdef __linux__
+	if (NULL != m_display)
+	{
+		eglMakeCurrent((EGLDisplay)m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (NULL != m_context)
+		{
+			eglDestroyContext((EGLDisplay)m_display, (EGLContext)m_context);
+		}
+		eglTerminate((EGLDisplay)m_display);
+	}
+#endif
+	m_display = NULL;
+	m_context = NULL;
+
+	if (NULL != m_pHiddenWindow)
+	{
+		glfwDestroyWindow(m_pHiddenWindow);
+		m_pHiddenWindow = NULL;
+	}
+}
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// headlessrenderer.h
+// ============
+// render the 3D scene offscreen on machines without a display
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CameraPath.h"
+#include "FrameProfiler.h"
+
+#include <GL/glew.h>
+
+// GLFW library
+#include "GLFW/glfw3.h"
+
+#include <string>
+#include <vector>
+
+class SceneManager;
+class ViewManager;
+
+/***********************************************************
+ *  HeadlessRenderer
+ *
+ *  This class renders the scene without a display window.
+ *  On Linux the OpenGL context is created through EGL on the
+ *  Mesa surfaceless platform, which works on servers with no
+ *  display at all, for example with the llvmpipe software
+ *  renderer.  Elsewhere a hidden GLFW window provides the
+ *  context.  The frames are drawn into a framebuffer object,
+ *  following a scripted camera path, and written to disk.
+ ***********************************************************/
+class HeadlessRenderer
+{
+public:
+	// constructor
+	HeadlessRenderer();
+	// destructor
+	~HeadlessRenderer();
+
+private:
+	// EGL display and context, kept as plain pointers so the
+	// EGL headers are only needed by the source file
+	void* m_display;
+	void* m_context;
+	// hidden window providing the context without EGL
+	GLFWwindow* m_pHiddenWindow;
+
+	// framebuffer the frames are drawn into
+	GLuint m_framebuffer;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+	int m_width;
+	int m_height;
+	// pixels of the last read frame
+	std::vector<unsigned char> m_pixels;
+
+	// directory the frames are written to
+	std::string m_outputDirectory;
+	// pointer to the profiler measuring the frames
+	FrameProfiler* m_pFrameProfiler;
+
+	// write the pixels of the framebuffer to a PPM image file
+	bool WriteFrame(const std::string& filename);
+
+public:
+	// create an OpenGL context that needs no display and load
+	// the OpenGL functions for it
+	bool CreateContext();
+	// create the framebuffer the frames are drawn into
+	bool CreateFramebuffer(int width, int height);
+	// set the directory the frames are written to
+	void SetOutputDirectory(const std::string& directory);
+	// set the profiler that measures the frames
+	void SetFrameProfiler(FrameProfiler* pFrameProfiler);
+
+	// render the passed in number of frames along the camera
+	// path and write each one to the output directory
+	bool RenderFrames(
+		SceneManager* pSceneManager,
+		ViewManager* pViewManager,
+		const CameraPath& cameraPath,
+		int frameCount);
+
+	// free the framebuffer and the context
+	void Destroy();
+};
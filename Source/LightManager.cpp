@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.cpp
+// ============
+// keep the scene light sources in a uniform buffer
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightManager.h"
+
+#include <cstddef>
+
+// declaration of global variables
+namespace
+{
+	// uniform block binding of the light buffer, matching the
+	// LightBlock binding of the fragment shader
+	const GLuint g_LightBlockBinding = 2;
+}
+
+/***********************************************************
+ *  LightManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightManager::LightManager()
+{
+	LIGHT_SOURCE unusedLight;
+	unusedLight.type = LIGHT_POINT;
+	unusedLight.position = glm::vec3(0.0f);
+	unusedLight.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	unusedLight.ambientColor = glm::vec3(0.0f);
+	unusedLight.diffuseColor = glm::vec3(0.0f);
+	unusedLight.specularColor = glm::vec3(0.0f);
+	unusedLight.focalStrength = 1.0f;
+	unusedLight.specularIntensity = 0.0f;
+
+	m_buffer = 0;
+	m_dirtyFirst = -1;
+	m_dirtyLast = -1;
+
+	// every light of the block is set, so the first upload
+	// sends no uninitialized values - the whole block is sent
+	// then, so the lights are not left marked as changed
+	m_block.lightCount = MAX_LIGHTS;
+	for (int i = 0; i < MAX_LIGHTS; i++)
+	{
+		SetLight(i, unusedLight);
+	}
+	m_block.lightCount = 0;
+	m_block.padding[0] = 0;
+	m_block.padding[1] = 0;
+	m_block.padding[2] = 0;
+	m_dirtyFirst = -1;
+	m_dirtyLast = -1;
+	m_bCountDirty = true;
+	m_uploadedBytes = 0;
+}
+
+/***********************************************************
+ *  ~LightManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightManager::~LightManager()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  MarkDirty()
+ *
+ *  This method is used for growing the dirty range so that it
+ *  also holds the passed in light.
+ ***********************************************************/
+void LightManager::MarkDirty(int light)
+{
+	if ((m_dirtyFirst < 0) || (light < m_dirtyFirst))
+	{
+		m_dirtyFirst = light;
+	}
+	if (light > m_dirtyLast)
+	{
+		m_dirtyLast = light;
+	}
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for adding a light source after the
+ *  existing ones.
+ ***********************************************************/
+int LightManager::AddLight(const LIGHT_SOURCE& light)
+{
+	if (m_block.lightCount >= MAX_LIGHTS)
+	{
+		return(-1);
+	}
+
+	int index = m_block.lightCount;
+	m_block.lightCount++;
+	m_bCountDirty = true;
+	SetLight(index, light);
+
+	return(index);
+}
+
+/***********************************************************
+ *  SetLight()
+ *
+ *  This method is used for replacing all the values of a
+ *  light source.
+ ***********************************************************/
+bool LightManager::SetLight(int light, const LIGHT_SOURCE& values)
+{
+	if ((light < 0) || (light >= m_block.lightCount))
+	{
+		return(false);
+	}
+
+	GPU_LIGHT& gpuLight = m_block.lights[light];
+	gpuLight.position = values.position;
+	gpuLight.focalStrength = values.focalStrength;
+	gpuLight.direction = values.direction;
+	gpuLight.specularIntensity = values.specularIntensity;
+	gpuLight.ambientColor = values.ambientColor;
+	gpuLight.type = (GLint)values.type;
+	gpuLight.diffuseColor = values.diffuseColor;
+	gpuLight.padding0 = 0.0f;
+	gpuLight.specularColor = values.specularColor;
+	gpuLight.padding1 = 0.0f;
+	MarkDirty(light);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetLightPosition()
+ *
+ *  This method is used for moving a point light.
+ ***********************************************************/
+bool LightManager::SetLightPosition(int light, const glm::vec3& position)
+{
+	if ((light < 0) || (light >= m_block.lightCount))
+	{
+		return(false);
+	}
+
+	m_block.lights[light].position = position;
+	MarkDirty(light);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetLightDirection()
+ *
+ *  This method is used for turning a directional light.
+ ***********************************************************/
+bool LightManager::SetLightDirection(int light, const glm::vec3& direction)
+{
+	if ((light < 0) || (light >= m_block.lightCount))
+	{
+		return(false);
+	}
+
+	m_block.lights[light].direction = direction;
+	MarkDirty(light);
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetLight()
+ *
+ *  This method is used for getting the values of a light
+ *  source, for example the direction of a shadow casting
+ *  light.
+ ***********************************************************/
+bool LightManager::GetLight(int light, LIGHT_SOURCE& values) const
+{
+	if ((light < 0) || (light >= m_block.lightCount))
+	{
+		return(false);
+	}
+
+	const GPU_LIGHT& gpuLight = m_block.lights[light];
+	values.type = (LIGHT_TYPE)gpuLight.type;
+	values.position = gpuLight.position;
+	values.direction = gpuLight.direction;
+	values.ambientColor = gpuLight.ambientColor;
+	values.diffuseColor = gpuLight.diffuseColor;
+	values.specularColor = gpuLight.specularColor;
+	values.focalStrength = gpuLight.focalStrength;
+	values.specularIntensity = gpuLight.specularIntensity;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetLightCount()
+ *
+ *  This method is used for getting the number of light
+ *  sources.
+ ***********************************************************/
+int LightManager::GetLightCount() const
+{
+	return(m_block.lightCount);
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  This method is used for sending the changed lights to the
+ *  uniform buffer.  The whole block is only sent when the
+ *  buffer is created, and after that only the light count
+ *  and the dirty range of lights are sent.
+ ***********************************************************/
+void LightManager::Upload()
+{
+	if (m_buffer == 0)
+	{
+		glGenBuffers(1, &m_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(GPU_LIGHT_BLOCK), &m_block, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferBase(GL_UNIFORM_BUFFER, g_LightBlockBinding, m_buffer);
+
+		m_uploadedBytes += sizeof(GPU_LIGHT_BLOCK);
+		m_bCountDirty = false;
+		m_dirtyFirst = -1;
+		m_dirtyLast = -1;
+		return;
+	}
+
+	if ((m_bCountDirty == false) && (m_dirtyFirst < 0))
+	{
+		return;
+	}
+
+	glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+	if (m_bCountDirty == true)
+	{
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(GLint), &m_block.lightCount);
+		m_uploadedBytes += sizeof(GLint);
+		m_bCountDirty = false;
+	}
+	if (m_dirtyFirst >= 0)
+	{
+		GLintptr offset = offsetof(GPU_LIGHT_BLOCK, lights) + m_dirtyFirst * sizeof(GPU_LIGHT);
+		GLsizeiptr size = (m_dirtyLast - m_dirtyFirst + 1) * sizeof(GPU_LIGHT);
+
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, &m_block.lights[m_dirtyFirst]);
+		m_uploadedBytes += (int)size;
+		m_dirtyFirst = -1;
+		m_dirtyLast = -1;
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/***********************************************************
+ *  GetUploadedBytes()
+ *
+ *  This method is used for getting the number of bytes sent
+ *  to the light buffer since the last reset.
+ ***********************************************************/
+int LightManager::GetUploadedBytes() const
+{
+	return(m_uploadedBytes);
+}
+
+/***********************************************************
+ *  ResetUploadedBytes()
+ *
+ *  This method is used for resetting the number of bytes sent
+ *  to the light buffer.
+ ***********************************************************/
+void LightManager::ResetUploadedBytes()
+{
+	m_uploadedBytes = 0;
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the uniform buffer.  The
+ *  lights are kept, and the whole block is sent again by the
+ *  next upload.
+ ***********************************************************/
+void LightManager::Destroy()
+{
+	if (m_buffer != 0)
+	{
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+	}
+	m_bCountDirty = true;
+}
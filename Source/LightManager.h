@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.h
+// ============
+// keep the scene light sources in a uniform buffer
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  LightManager
+ *
+ *  This class keeps the light sources of the scene in one
+ *  std140 uniform buffer, in place of separate named uniforms.
+ *  Changing a light only marks it as dirty, and the next
+ *  upload sends the range between the first and the last
+ *  dirty light with a single glBufferSubData() call.
+ ***********************************************************/
+class LightManager
+{
+public:
+	// constructor
+	LightManager();
+	// destructor
+	~LightManager();
+
+	// number of lights the shader light block holds
+	static const int MAX_LIGHTS = 16;
+
+	// kinds of light sources
+	enum LIGHT_TYPE
+	{
+		LIGHT_POINT = 0,
+		LIGHT_DIRECTIONAL
+	};
+
+	// values of one light source
+	struct LIGHT_SOURCE
+	{
+		LIGHT_TYPE type;
+		// position of a point light
+		glm::vec3 position;
+		// direction the light of a directional light travels in
+		glm::vec3 direction;
+		glm::vec3 ambientColor;
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float focalStrength;
+		float specularIntensity;
+	};
+
+private:
+	// std140 layout of one light in the light buffer, shared
+	// with the LightSource struct of the fragment shader
+	struct GPU_LIGHT
+	{
+		glm::vec3 position;
+		float focalStrength;
+		glm::vec3 direction;
+		float specularIntensity;
+		glm::vec3 ambientColor;
+		GLint type;
+		glm::vec3 diffuseColor;
+		float padding0;
+		glm::vec3 specularColor;
+		float padding1;
+	};
+
+	// std140 layout of the whole light block
+	struct GPU_LIGHT_BLOCK
+	{
+		GLint lightCount;
+		GLint padding[3];
+		GPU_LIGHT lights[MAX_LIGHTS];
+	};
+
+	// copy of the buffer contents
+	GPU_LIGHT_BLOCK m_block;
+	// uniform buffer holding the light block
+	GLuint m_buffer;
+	// range of lights changed since the last upload, -1 when
+	// no light has changed
+	int m_dirtyFirst;
+	int m_dirtyLast;
+	// true when the number of lights has changed
+	bool m_bCountDirty;
+	// number of bytes sent by the uploads since the last reset
+	int m_uploadedBytes;
+
+	// mark a light as changed
+	void MarkDirty(int light);
+
+public:
+	// add a light source and return its index, -1 when full
+	int AddLight(const LIGHT_SOURCE& light);
+	// replace all the values of a light source
+	bool SetLight(int light, const LIGHT_SOURCE& values);
+	// move a point light
+	bool SetLightPosition(int light, const glm::vec3& position);
+	// turn a directional light
+	bool SetLightDirection(int light, const glm::vec3& direction);
+	// get the values of a light source
+	bool GetLight(int light, LIGHT_SOURCE& values) const;
+	// get the number of light sources
+	int GetLightCount() const;
+
+	// send the changed lights to the uniform buffer
+	void Upload();
+
+	// get and reset the number of uploaded bytes
+	int GetUploadedBytes() const;
+	void ResetUploadedBytes();
+
+	// free the uniform buffer
+	void Destroy();
+};
@@ -1,5 +1,8 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
+#include <sstream>          // window title statistics
+#include <string>
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -11,8 +14,13 @@
 
 #include "SceneManager.h"
 #include "ViewManager.h"
-#include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "BenchmarkManager.h"
+#include "UniformCache.h"
+#include "FramePacer.h"
+#include "HeadlessRenderer.h"
+#include "CameraPath.h"
+#include "FrameProfiler.h"
 
 // Namespace for declaring global variables
 namespace
@@ -29,6 +37,70 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+	// cached uniform locations of the loaded shader program
+	UniformCache* g_UniformCache = nullptr;
+	// profiler measuring the CPU and GPU time of the frames
+	FrameProfiler* g_FrameProfiler = nullptr;
+
+	// true when the render counters are printed to the console
+	bool g_bShowStats = false;
+	// pack the scene textures into texture arrays when enabled
+	bool g_bUseTextureArrays = false;
+	// submit the scene with multi-draw-indirect calls when enabled
+	bool g_bUseMultiDraw = false;
+	// cull the instanced objects with a compute shader when enabled
+	bool g_bUseGpuCulling = false;
+	// start with occlusion culling switched on when enabled
+	bool g_bUseOcclusionCulling = false;
+	// number of point lights scattered over the yard
+	int g_YardLampCount = 0;
+	// shadow map size and number of shadow cascades, where
+	// -1 keeps the scene manager defaults
+	int g_ShadowResolution = -1;
+	int g_ShadowCascadeCount = -1;
+	// true when the shadow settings are benchmarked instead of
+	// running the interactive scene
+	bool g_bBenchmarkShadows = false;
+	// paces the frames of the main loop and steps the simulation
+	FramePacer g_FramePacer;
+	// number of frames rendered offscreen without a display
+	// window, 0 for the interactive scene
+	int g_HeadlessFrameCount = 0;
+	// directory the headless frames are written to
+	std::string g_HeadlessOutputDirectory = "frames";
+	// camera path file followed by the headless and benchmark
+	// frames, empty for an orbit around the scene
+	std::string g_CameraPathFile;
+	// camera path followed by the headless and benchmark frames
+	CameraPath g_CameraPath;
+	// file the camera is recorded to every frame, empty when the
+	// camera is not recorded
+	std::string g_RecordPathFile;
+	// camera path recorded while flying the camera by hand
+	CameraPath g_RecordedPath;
+	// true when the camera path benchmark is run, offscreen when
+	// its headless flag is set
+	bool g_bBenchmarkPath = false;
+	bool g_bBenchmarkHeadless = false;
+	// number of generated objects that replace the scene, 0 for
+	// the normal scene
+	int g_GeneratedObjectCount = 0;
+	// frames measured by the path benchmark
+	int g_BenchmarkFrameCount = 600;
+	// file the benchmark result is written to
+	std::string g_BenchmarkOutputFile = "benchmark.json";
+	// result of an earlier run the benchmark is compared with,
+	// empty when no comparison is made
+	std::string g_BenchmarkBaselineFile;
+	// percent a frame time may grow over the baseline
+	float g_BenchmarkThresholdPercent = 10.0f;
+	// false when the frames are not profiled
+	bool g_bUseProfiler = true;
+	// file the profiled sections are saved to as a Chrome trace,
+	// empty when no trace is saved
+	std::string g_ProfileTraceFile;
+	// seconds between the printed render counters
+	const double STATS_INTERVAL = 1.0;
 }
 
 // Function declarations - all functions that are called manually
@@ -45,8 +117,168 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// the command line benchmarks do not need a display window
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--bench-transforms") == 0)
+		{
+			BenchmarkManager benchmarks;
+			benchmarks.RunTransformBenchmark(10000, 600);
+			return(EXIT_SUCCESS);
+		}
+		else if (strcmp(argv[i], "--bench-culling") == 0)
+		{
+			BenchmarkManager benchmarks;
+			benchmarks.RunCullingBenchmark(20);
+			return(EXIT_SUCCESS);
+		}
+		else if (strcmp(argv[i], "--stats") == 0)
+		{
+			g_bShowStats = true;
+		}
+		else if (strcmp(argv[i], "--texture-arrays") == 0)
+		{
+			g_bUseTextureArrays = true;
+		}
+		else if (strcmp(argv[i], "--multi-draw") == 0)
+		{
+			g_bUseMultiDraw = true;
+		}
+		else if (strcmp(argv[i], "--gpu-culling") == 0)
+		{
+			g_bUseGpuCulling = true;
+		}
+		else if (strcmp(argv[i], "--occlusion") == 0)
+		{
+			g_bUseOcclusionCulling = true;
+		}
+		else if ((strcmp(argv[i], "--point-lights") == 0) && (i + 1 < argc))
+		{
+			g_YardLampCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--shadow-resolution") == 0) && (i + 1 < argc))
+		{
+			g_ShadowResolution = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--shadow-cascades") == 0) && (i + 1 < argc))
+		{
+			g_ShadowCascadeCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--bench-shadows") == 0)
+		{
+			g_bBenchmarkShadows = true;
+		}
+		else if ((strcmp(argv[i], "--vsync") == 0) && (i + 1 < argc))
+		{
+			// off for uncapped benchmarks, adaptive to avoid the
+			// stutter of a missed vertical blank
+			i++;
+			if (strcmp(argv[i], "off") == 0)
+			{
+				g_FramePacer.SetVSyncMode(FramePacer::VSYNC_OFF);
+			}
+			else if (strcmp(argv[i], "adaptive") == 0)
+			{
+				g_FramePacer.SetVSyncMode(FramePacer::VSYNC_ADAPTIVE);
+			}
+			else
+			{
+				g_FramePacer.SetVSyncMode(FramePacer::VSYNC_ON);
+			}
+		}
+		else if ((strcmp(argv[i], "--fps-limit") == 0) && (i + 1 < argc))
+		{
+			g_FramePacer.SetTargetFrameRate(atof(argv[++i]));
+		}
+		else if ((strcmp(argv[i], "--step-rate") == 0) && (i + 1 < argc))
+		{
+			double stepRate = atof(argv[++i]);
+			if (stepRate > 0.0)
+			{
+				g_FramePacer.SetFixedTimestep(1.0 / stepRate);
+			}
+		}
+		else if ((strcmp(argv[i], "--headless") == 0) && (i + 1 < argc))
+		{
+			g_HeadlessFrameCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--output-dir") == 0) && (i + 1 < argc))
+		{
+			g_HeadlessOutputDirectory = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--camera-path") == 0) && (i + 1 < argc))
+		{
+			g_CameraPathFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--record-path") == 0) && (i + 1 < argc))
+		{
+			g_RecordPathFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--benchmark") == 0)
+		{
+			g_bBenchmarkPath = true;
+		}
+		else if (strcmp(argv[i], "--benchmark-headless") == 0)
+		{
+			g_bBenchmarkPath = true;
+			g_bBenchmarkHeadless = true;
+		}
+		else if ((strcmp(argv[i], "--benchmark-objects") == 0) && (i + 1 < argc))
+		{
+			g_GeneratedObjectCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--benchmark-frames") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkFrameCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--benchmark-output") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkOutputFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--benchmark-baseline") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkBaselineFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--benchmark-threshold") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkThresholdPercent = (float)atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--no-profiler") == 0)
+		{
+			g_bUseProfiler = false;
+		}
+		else if ((strcmp(argv[i], "--profile-trace") == 0) && (i + 1 < argc))
+		{
+			g_ProfileTraceFile = argv[++i];
+		}
+	}
+
+	// the camera path is shared by the headless frames and the
+	// path benchmark
+	if ((g_CameraPathFile.empty() == false) &&
+		(g_CameraPath.Load(g_CameraPathFile.c_str()) == false))
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// the headless mode renders into an offscreen framebuffer
+	// of the same size as the display window
+	bool bHeadless = (g_HeadlessFrameCount > 0) || (g_bBenchmarkHeadless == true);
+	HeadlessRenderer headlessRenderer;
+	if (bHeadless == true)
+	{
+		int width = 0;
+		int height = 0;
+		ViewManager::GetDisplaySize(width, height);
+		if ((headlessRenderer.CreateContext() == false) ||
+			(headlessRenderer.CreateFramebuffer(width, height) == false))
+		{
+			return(EXIT_FAILURE);
+		}
+		headlessRenderer.SetOutputDirectory(g_HeadlessOutputDirectory);
+	}
 	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
+	else if (InitializeGLFW() == false)
 	{
 		return(EXIT_FAILURE);
 	}
@@ -57,29 +289,143 @@ int main(int argc, char* argv[])
 	g_ViewManager = new ViewManager(
 		g_ShaderManager);
 
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-
-	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
+	if (bHeadless == false)
 	{
-		return(EXIT_FAILURE);
+		// try to create the main display window
+		g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+		// the swap interval is applied to the new window
+		g_FramePacer.SetWindow(g_Window);
+
+		// if GLEW fails initialization, then terminate the application
+		if (InitializeGLEW() == false)
+		{
+			return(EXIT_FAILURE);
+		}
 	}
 
-	// load the shader code from the external GLSL files
+	// the frames are profiled from the start, so the loading is
+	// measured as the first frame
+	g_FrameProfiler = new FrameProfiler();
+	g_FrameProfiler->Initialize();
+	g_FrameProfiler->SetEnabled(g_bUseProfiler);
+	g_ViewManager->SetFrameProfiler(g_FrameProfiler);
+	headlessRenderer.SetFrameProfiler(g_FrameProfiler);
+
+	// load the shader code from the project GLSL files, which
+	// add per-instance data to the shared utility shaders
+	int shaderSection = g_FrameProfiler->BeginSection("Shader.Load");
 	g_ShaderManager->LoadShaders(
-		"../../Utilities/shaders/vertexShader.glsl",
-		"../../Utilities/shaders/fragmentShader.glsl");
+		"Source/shaders/vertexShader.glsl",
+		"Source/shaders/fragmentShader.glsl");
 	g_ShaderManager->use();
+	g_FrameProfiler->EndSection(shaderSection);
+
+	// look up every active uniform location of the shader program
+	// once, so no uniform lookups are done while rendering
+	shaderSection = g_FrameProfiler->BeginSection("Shader.ResolveUniforms");
+	GLint programID = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &programID);
+	g_UniformCache = new UniformCache();
+	g_UniformCache->Resolve((GLuint)programID);
+	g_ViewManager->SetUniformCache(g_UniformCache);
+	g_FrameProfiler->EndSection(shaderSection);
+	if (g_bUseOcclusionCulling == true)
+	{
+		g_ViewManager->SetOcclusionCullingEnabled(true);
+	}
 
 	// try to create a new scene manager object and prepare the 3D scene
 	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager->SetViewManager(g_ViewManager);
+	g_SceneManager->SetUniformCache(g_UniformCache);
+	g_SceneManager->SetFrameProfiler(g_FrameProfiler);
+	g_SceneManager->SetTextureArraysEnabled(g_bUseTextureArrays);
+	g_SceneManager->SetMultiDrawEnabled(g_bUseMultiDraw);
+	g_SceneManager->SetGpuCullingEnabled(g_bUseGpuCulling);
+	g_SceneManager->SetYardLampCount(g_YardLampCount);
+	g_SceneManager->SetGeneratedObjectCount(g_GeneratedObjectCount);
+	g_SceneManager->SetShadowSettings(g_ShadowResolution, g_ShadowCascadeCount);
+	int prepareSection = g_FrameProfiler->BeginSection("PrepareScene");
 	g_SceneManager->PrepareScene();
+	g_FrameProfiler->EndSection(prepareSection);
+
+	// the shadow benchmark renders the scene with every shadow
+	// setting, and then the application closes
+	if ((g_bBenchmarkShadows == true) && (NULL != g_Window))
+	{
+		// the benchmark frames are not profiled
+		BenchmarkManager benchmarks;
+		g_FrameProfiler->SetEnabled(false);
+		benchmarks.RunShadowBenchmark(g_SceneManager, g_ViewManager, g_Window, 300);
+		g_FrameProfiler->SetEnabled(g_bUseProfiler);
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+
+	// the path benchmark replays the camera path over the scene,
+	// and then the application closes with a failure when a
+	// frame time is over its threshold
+	int exitCode = EXIT_SUCCESS;
+	if (g_bBenchmarkPath == true)
+	{
+		// the benchmark frames are not profiled
+		BenchmarkManager benchmarks;
+		g_FrameProfiler->SetEnabled(false);
+		if (benchmarks.RunPathBenchmark(
+			g_SceneManager,
+			g_ViewManager,
+			g_Window,
+			g_CameraPath,
+			g_BenchmarkFrameCount,
+			g_BenchmarkOutputFile.c_str(),
+			g_BenchmarkBaselineFile.c_str(),
+			g_BenchmarkThresholdPercent) == false)
+		{
+			exitCode = EXIT_FAILURE;
+		}
+		g_FrameProfiler->SetEnabled(g_bUseProfiler);
+		if (NULL != g_Window)
+		{
+			glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+		}
+	}
+
+	// the headless frames follow the camera path, and then the
+	// application closes
+	if (g_HeadlessFrameCount > 0)
+	{
+		if (headlessRenderer.RenderFrames(
+			g_SceneManager,
+			g_ViewManager,
+			g_CameraPath,
+			g_HeadlessFrameCount) == false)
+		{
+			exitCode = EXIT_FAILURE;
+		}
+		if (g_bShowStats == true)
+		{
+			g_FrameProfiler->Finish();
+			g_FrameProfiler->PrintStats();
+		}
+	}
+
+	double lastStatsTime = glfwGetTime();
 
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
+	while ((NULL != g_Window) && (!glfwWindowShouldClose(g_Window)))
 	{
+		// the camera is moved in fixed steps, as many as the
+		// time since the last frame holds
+		g_FramePacer.BeginFrame();
+		g_FrameProfiler->BeginFrame();
+		int frameSection = g_FrameProfiler->BeginSection("Frame");
+		int section = g_FrameProfiler->BeginSection("UpdateCamera");
+		while (g_FramePacer.StepSimulation() == true)
+		{
+			g_ViewManager->UpdateCamera((float)g_FramePacer.GetFixedTimestep());
+		}
+		g_FrameProfiler->EndSection(section);
+
 		// Enable z-depth
 		glEnable(GL_DEPTH_TEST);
 
@@ -87,20 +433,95 @@ int main(int argc, char* argv[])
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+		// count the uniform lookups done during this frame only
+		g_UniformCache->ResetLookupCount();
+
 		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
+		// the frame is viewed from between the last two steps
+		section = g_FrameProfiler->BeginSection("PrepareSceneView");
+		g_ViewManager->PrepareSceneView((float)g_FramePacer.GetInterpolationAlpha());
+		g_FrameProfiler->EndSection(section);
+
+		// the camera moved by hand is kept for replaying later
+		if (g_RecordPathFile.empty() == false)
+		{
+			g_RecordedPath.AddKey(g_ViewManager->GetCameraPosition(), g_ViewManager->GetCameraTarget());
+		}
 
 		// refresh the 3D scene
+		section = g_FrameProfiler->BeginSection("RenderScene");
 		g_SceneManager->RenderScene();
+		g_FrameProfiler->EndSection(section);
 
+		// print the render counters of the last frame
+		if ((g_bShowStats == true) && (glfwGetTime() - lastStatsTime >= STATS_INTERVAL))
+		{
+			const SceneManager::RENDER_STATS& stats = g_SceneManager->GetRenderStats();
+			std::cout << "INFO: draw calls: " << stats.drawCalls
+				<< ", state changes: " << stats.stateChanges
+				<< ", state changes skipped: " << stats.stateChangesSkipped
+				<< ", culled objects: " << stats.culledItems
+				<< ", occluded objects: " << stats.occludedItems
+				<< ", point lights: " << stats.pointLights
+				<< ", cluster light entries: " << stats.lightAssignments
+				<< ", light bytes uploaded: " << stats.lightBytesUploaded
+				<< ", shadow casters: " << stats.shadowCasters
+				<< ", shadow draw calls: " << stats.shadowDrawCalls
+				<< ", shadow pass: " << stats.shadowPassCpuMs << " ms CPU / "
+				<< stats.shadowPassGpuMs << " ms GPU"
+				<< ", draw data bytes: " << stats.drawDataBytes
+				<< ", draw data stalls: " << stats.drawDataStalls
+				<< ", indirect commands: " << stats.indirectCommands
+				<< ", frame time: " << g_FramePacer.GetFrameDeltaTime() * 1000.0 << " ms"
+				<< ", simulation steps: " << g_FramePacer.GetStepCount()
+				<< ", uniform lookups: " << g_UniformCache->GetLookupCount() << std::endl;
 
-		// Flips the the back buffer with the front buffer every frame.
+			// the triangles drawn at each level of detail are shown
+			// over the scene in the window title
+			std::ostringstream lodStats;
+			lodStats << "triangles by LOD:";
+			for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+			{
+				lodStats << " [" << lod << "] " << stats.lodTriangles[lod]
+					<< " (" << stats.lodItems[lod] << " objects)";
+			}
+			std::string windowTitle = std::string(WINDOW_TITLE) + " - " + lodStats.str();
+			glfwSetWindowTitle(g_Window, windowTitle.c_str());
+			std::cout << "INFO: " << lodStats.str() << std::endl;
+			if (g_FrameProfiler->IsEnabled() == true)
+			{
+				g_FrameProfiler->PrintStats();
+			}
+			lastStatsTime = glfwGetTime();
+		}
+
+		// hold the frame back to the frame rate limit, then flip
+		// the back buffer with the front buffer
+		g_FramePacer.WaitForPresent();
+		section = g_FrameProfiler->BeginSection("SwapBuffers");
 		glfwSwapBuffers(g_Window);
+		g_FrameProfiler->EndSection(section);
+		g_FrameProfiler->EndSection(frameSection);
 
 		// query the latest GLFW events
 		glfwPollEvents();
 	}
 
+	if (g_RecordPathFile.empty() == false)
+	{
+		g_RecordedPath.Save(g_RecordPathFile.c_str());
+	}
+
+	// the queries still in flight are read before the trace is
+	// saved, and the profiler is freed while its context lives
+	g_FrameProfiler->Finish();
+	if (g_ProfileTraceFile.empty() == false)
+	{
+		g_FrameProfiler->WriteChromeTrace(g_ProfileTraceFile.c_str());
+	}
+	delete g_FrameProfiler;
+	g_FrameProfiler = NULL;
+
 	// clear the allocated manager objects from memory
 	if (NULL != g_SceneManager)
 	{
@@ -112,14 +533,21 @@ int main(int argc, char* argv[])
 		delete g_ViewManager;
 		g_ViewManager = NULL;
 	}
+	if (NULL != g_UniformCache)
+	{
+		delete g_UniformCache;
+		g_UniformCache = NULL;
+	}
 	if (NULL != g_ShaderManager)
 	{
 		delete g_ShaderManager;
 		g_ShaderManager = NULL;
 	}
+	// the headless context is freed after the objects using it
+	headlessRenderer.Destroy();
 
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
+	// Terminates the program
+	exit(exitCode); 
 }
 
 /***********************************************************
@@ -0,0 +1,449 @@
+///////////////////////////////////////////////////////////////////////////////
+// mesharena.cpp
+// ============
+// suballocate the geometry of many meshes from one vertex and index buffer
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshArena.h"
+
+// declaration of global variables
+namespace
+{
+	// create a buffer of the passed in size without any data -
+	// the copy target is used so the bound vertex layout keeps
+	// its index buffer
+	GLuint CreateBuffer(GLsizeiptr size)
+	{
+		GLuint buffer = 0;
+
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		return(buffer);
+	}
+
+	// copy a run of bytes from one buffer to another
+	void CopyBuffer(GLuint source, GLuint destination, GLintptr sourceOffset, GLintptr destinationOffset, GLsizeiptr size)
+	{
+		if (size <= 0)
+		{
+			return;
+		}
+
+		glBindBuffer(GL_COPY_READ_BUFFER, source);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, destination);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, destinationOffset, size);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+}
+
+/***********************************************************
+ *  MeshArena()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+MeshArena::MeshArena()
+{
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_vertexSize = 0;
+	m_vertexCapacity = 0;
+	m_indexCapacity = 0;
+	m_bufferVersion = 0;
+}
+
+/***********************************************************
+ *  ~MeshArena()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+MeshArena::~MeshArena()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the empty buffers, with
+ *  room for the passed in numbers of vertices and indices.
+ ***********************************************************/
+void MeshArena::Create(int vertexSize, int vertexCapacity, int indexCapacity)
+{
+	Destroy();
+
+	m_vertexSize = vertexSize;
+	m_vertexCapacity = vertexCapacity;
+	m_indexCapacity = indexCapacity;
+	m_vertexBuffer = CreateBuffer((GLsizeiptr)vertexCapacity * vertexSize);
+	m_indexBuffer = CreateBuffer((GLsizeiptr)indexCapacity * sizeof(GLuint));
+
+	ReleaseRange(m_freeVertices, 0, vertexCapacity);
+	ReleaseRange(m_freeIndices, 0, indexCapacity);
+	m_bufferVersion++;
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the buffers.  The handles
+ *  of the added meshes are no longer valid afterwards.
+ ***********************************************************/
+void MeshArena::Destroy()
+{
+	if (0 != m_vertexBuffer)
+	{
+		glDeleteBuffers(1, &m_vertexBuffer);
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_vertexBuffer = 0;
+		m_indexBuffer = 0;
+		m_bufferVersion++;
+	}
+
+	m_vertexCapacity = 0;
+	m_indexCapacity = 0;
+	m_freeVertices.clear();
+	m_freeIndices.clear();
+	m_meshes.clear();
+}
+
+/***********************************************************
+ *  AllocateRange()
+ *
+ *  This method is used for taking a range from the first free
+ *  range that is large enough for it.
+ ***********************************************************/
+int MeshArena::AllocateRange(std::vector<FREE_RANGE>& freeRanges, int count)
+{
+	for (size_t i = 0; i < freeRanges.size(); i++)
+	{
+		if (freeRanges[i].count >= count)
+		{
+			int first = freeRanges[i].first;
+
+			freeRanges[i].first += count;
+			freeRanges[i].count -= count;
+			if (freeRanges[i].count == 0)
+			{
+				freeRanges.erase(freeRanges.begin() + i);
+			}
+			return(first);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  ReleaseRange()
+ *
+ *  This method is used for putting a range back into a free
+ *  list in order, and joining it with the free ranges right
+ *  before and after it.
+ ***********************************************************/
+void MeshArena::ReleaseRange(std::vector<FREE_RANGE>& freeRanges, int first, int count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	size_t position = 0;
+	while ((position < freeRanges.size()) && (freeRanges[position].first < first))
+	{
+		position++;
+	}
+
+	FREE_RANGE range;
+	range.first = first;
+	range.count = count;
+	freeRanges.insert(freeRanges.begin() + position, range);
+
+	// join the following range first, so the position of the
+	// new range stays the same
+	if ((position + 1 < freeRanges.size()) &&
+		(freeRanges[position].first + freeRanges[position].count == freeRanges[position + 1].first))
+	{
+		freeRanges[position].count += freeRanges[position + 1].count;
+		freeRanges.erase(freeRanges.begin() + position + 1);
+	}
+	if ((position > 0) &&
+		(freeRanges[position - 1].first + freeRanges[position - 1].count == freeRanges[position].first))
+	{
+		freeRanges[position - 1].count += freeRanges[position].count;
+		freeRanges.erase(freeRanges.begin() + position);
+	}
+}
+
+/***********************************************************
+ *  Grow()
+ *
+ *  This method is used for replacing the buffers with larger
+ *  ones.  The old contents are copied on the GPU to the same
+ *  places, so every mesh keeps its ranges, and the added room
+ *  is free at the end.
+ ***********************************************************/
+void MeshArena::Grow(int vertexCapacity, int indexCapacity)
+{
+	if (vertexCapacity > m_vertexCapacity)
+	{
+		GLuint vertexBuffer = CreateBuffer((GLsizeiptr)vertexCapacity * m_vertexSize);
+		CopyBuffer(m_vertexBuffer, vertexBuffer, 0, 0, (GLsizeiptr)m_vertexCapacity * m_vertexSize);
+		glDeleteBuffers(1, &m_vertexBuffer);
+		m_vertexBuffer = vertexBuffer;
+
+		ReleaseRange(m_freeVertices, m_vertexCapacity, vertexCapacity - m_vertexCapacity);
+		m_vertexCapacity = vertexCapacity;
+	}
+
+	if (indexCapacity > m_indexCapacity)
+	{
+		GLuint indexBuffer = CreateBuffer((GLsizeiptr)indexCapacity * sizeof(GLuint));
+		CopyBuffer(m_indexBuffer, indexBuffer, 0, 0, (GLsizeiptr)m_indexCapacity * sizeof(GLuint));
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_indexBuffer = indexBuffer;
+
+		ReleaseRange(m_freeIndices, m_indexCapacity, indexCapacity - m_indexCapacity);
+		m_indexCapacity = indexCapacity;
+	}
+
+	m_bufferVersion++;
+}
+
+/***********************************************************
+ *  AddMesh()
+ *
+ *  This method is used for copying the vertices and indices
+ *  of a mesh into free ranges of the buffers.  A buffer that
+ *  has no free range large enough is grown to twice its size
+ *  plus the size of the mesh first.
+ ***********************************************************/
+int MeshArena::AddMesh(
+	const void* vertices,
+	int vertexCount,
+	const GLuint* indices,
+	int indexCount)
+{
+	if ((0 == m_vertexBuffer) || (vertexCount <= 0) || (indexCount <= 0))
+	{
+		return(-1);
+	}
+
+	int baseVertex = AllocateRange(m_freeVertices, vertexCount);
+	if (baseVertex < 0)
+	{
+		Grow(m_vertexCapacity * 2 + vertexCount, m_indexCapacity);
+		baseVertex = AllocateRange(m_freeVertices, vertexCount);
+	}
+	int firstIndex = AllocateRange(m_freeIndices, indexCount);
+	if (firstIndex < 0)
+	{
+		Grow(m_vertexCapacity, m_indexCapacity * 2 + indexCount);
+		firstIndex = AllocateRange(m_freeIndices, indexCount);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_vertexBuffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)baseVertex * m_vertexSize, (GLsizeiptr)vertexCount * m_vertexSize, vertices);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_indexBuffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)firstIndex * sizeof(GLuint), (GLsizeiptr)indexCount * sizeof(GLuint), indices);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	MESH_RANGE range;
+	range.baseVertex = baseVertex;
+	range.vertexCount = vertexCount;
+	range.firstIndex = (GLuint)firstIndex;
+	range.indexCount = indexCount;
+	range.bUsed = true;
+
+	// the handle of a removed mesh is given out again
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		if (m_meshes[i].bUsed == false)
+		{
+			m_meshes[i] = range;
+			return((int)i);
+		}
+	}
+	m_meshes.push_back(range);
+
+	return((int)m_meshes.size() - 1);
+}
+
+/***********************************************************
+ *  RemoveMesh()
+ *
+ *  This method is used for giving the ranges of a mesh back
+ *  to the free lists.  The data stays in the buffers until
+ *  another mesh is placed over it.
+ ***********************************************************/
+void MeshArena::RemoveMesh(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)m_meshes.size()) || (m_meshes[mesh].bUsed == false))
+	{
+		return;
+	}
+
+	MESH_RANGE& range = m_meshes[mesh];
+	ReleaseRange(m_freeVertices, range.baseVertex, range.vertexCount);
+	ReleaseRange(m_freeIndices, (int)range.firstIndex, range.indexCount);
+	range.bUsed = false;
+}
+
+/***********************************************************
+ *  Defragment()
+ *
+ *  This method is used for copying every mesh, in the order of
+ *  the handles, to the start of new buffers of the same size.
+ *  The copies are done on the GPU, and the indices need no
+ *  change since they are relative to the base vertex.
+ ***********************************************************/
+void MeshArena::Defragment()
+{
+	if (0 == m_vertexBuffer)
+	{
+		return;
+	}
+
+	GLuint vertexBuffer = CreateBuffer((GLsizeiptr)m_vertexCapacity * m_vertexSize);
+	GLuint indexBuffer = CreateBuffer((GLsizeiptr)m_indexCapacity * sizeof(GLuint));
+	int nextVertex = 0;
+	int nextIndex = 0;
+
+	for (size_t i = 0; i < m_meshes.size(); i++)
+	{
+		MESH_RANGE& range = m_meshes[i];
+
+		if (range.bUsed == false)
+		{
+			continue;
+		}
+
+		CopyBuffer(
+			m_vertexBuffer,
+			vertexBuffer,
+			(GLintptr)range.baseVertex * m_vertexSize,
+			(GLintptr)nextVertex * m_vertexSize,
+			(GLsizeiptr)range.vertexCount * m_vertexSize);
+		CopyBuffer(
+			m_indexBuffer,
+			indexBuffer,
+			(GLintptr)range.firstIndex * sizeof(GLuint),
+			(GLintptr)nextIndex * sizeof(GLuint),
+			(GLsizeiptr)range.indexCount * sizeof(GLuint));
+
+		range.baseVertex = nextVertex;
+		range.firstIndex = (GLuint)nextIndex;
+		nextVertex += range.vertexCount;
+		nextIndex += range.indexCount;
+	}
+
+	glDeleteBuffers(1, &m_vertexBuffer);
+	glDeleteBuffers(1, &m_indexBuffer);
+	m_vertexBuffer = vertexBuffer;
+	m_indexBuffer = indexBuffer;
+
+	m_freeVertices.clear();
+	m_freeIndices.clear();
+	ReleaseRange(m_freeVertices, nextVertex, m_vertexCapacity - nextVertex);
+	ReleaseRange(m_freeIndices, nextIndex, m_indexCapacity - nextIndex);
+	m_bufferVersion++;
+}
+
+/***********************************************************
+ *  GetMesh()
+ *
+ *  This method is used for getting the place of a mesh in the
+ *  buffers, which changes when the buffers are defragmented.
+ ***********************************************************/
+const MeshArena::MESH_RANGE& MeshArena::GetMesh(int mesh) const
+{
+	return(m_meshes[mesh]);
+}
+
+/***********************************************************
+ *  GetVertexBuffer()
+ *
+ *  This method is used for getting the shared vertex buffer.
+ ***********************************************************/
+GLuint MeshArena::GetVertexBuffer() const
+{
+	return(m_vertexBuffer);
+}
+
+/***********************************************************
+ *  GetIndexBuffer()
+ *
+ *  This method is used for getting the shared index buffer.
+ ***********************************************************/
+GLuint MeshArena::GetIndexBuffer() const
+{
+	return(m_indexBuffer);
+}
+
+/***********************************************************
+ *  GetBufferVersion()
+ *
+ *  This method is used for getting a number that changes
+ *  every time the buffers are replaced, so a vertex layout
+ *  can tell that it must be pointed at the new buffers.
+ ***********************************************************/
+int MeshArena::GetBufferVersion() const
+{
+	return(m_bufferVersion);
+}
+
+/***********************************************************
+ *  GetGapShare()
+ *
+ *  This method is used for getting the share of the used part
+ *  of a buffer, from its start to the end of its last mesh,
+ *  that is free space caught between meshes.  A free range
+ *  reaching the end of the buffer is not part of it.
+ ***********************************************************/
+float MeshArena::GetGapShare(const std::vector<FREE_RANGE>& freeRanges, int capacity)
+{
+	int gaps = 0;
+	int usedEnd = capacity;
+
+	for (size_t i = 0; i < freeRanges.size(); i++)
+	{
+		if (freeRanges[i].first + freeRanges[i].count == capacity)
+		{
+			usedEnd = freeRanges[i].first;
+		}
+		else
+		{
+			gaps += freeRanges[i].count;
+		}
+	}
+
+	if (usedEnd == 0)
+	{
+		return(0.0f);
+	}
+
+	return((float)gaps / usedEnd);
+}
+
+/***********************************************************
+ *  GetFragmentation()
+ *
+ *  This method is used for getting the share of the used part
+ *  of the vertex or index buffer, whichever is worse, that is
+ *  free but caught in gaps between meshes.  The free space
+ *  after the last mesh is left out, so the share does not
+ *  depend on how much room the buffers have to spare.
+ ***********************************************************/
+float MeshArena::GetFragmentation() const
+{
+	float vertexFragmentation = GetGapShare(m_freeVertices, m_vertexCapacity);
+	float indexFragmentation = GetGapShare(m_freeIndices, m_indexCapacity);
+
+	return((vertexFragmentation > indexFragmentation) ? vertexFragmentation : indexFragmentation);
+}
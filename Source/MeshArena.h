@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// mesharena.h
+// ============
+// suballocate the geometry of many meshes from one vertex and index buffer
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  MeshArena
+ *
+ *  This class owns one large vertex buffer and one large
+ *  index buffer, and hands out a range of each to every mesh
+ *  that is added.  All the meshes can then be drawn with the
+ *  same vertex layout, each draw picking its mesh with a base
+ *  vertex and a first index.  The free space of each buffer is
+ *  kept as a sorted list of ranges, which are joined again
+ *  when the meshes between them are removed.  The buffers grow
+ *  when a mesh does not fit, and Defragment() packs the meshes
+ *  together again.  Both replace the buffers, which is tracked
+ *  by a version number so the vertex layouts using them can
+ *  be pointed at the new ones.
+ ***********************************************************/
+class MeshArena
+{
+public:
+	// constructor
+	MeshArena();
+	// destructor
+	~MeshArena();
+
+	// place of one mesh in the buffers
+	struct MESH_RANGE
+	{
+		GLint baseVertex;
+		GLsizei vertexCount;
+		GLuint firstIndex;
+		GLsizei indexCount;
+		// false once the mesh was removed
+		bool bUsed;
+	};
+
+private:
+	// a run of free vertices or indices
+	struct FREE_RANGE
+	{
+		int first;
+		int count;
+	};
+
+	// the shared buffers
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	// size in bytes of one vertex
+	int m_vertexSize;
+	// number of vertices and indices the buffers can hold
+	int m_vertexCapacity;
+	int m_indexCapacity;
+	// free space of each buffer, sorted by position
+	std::vector<FREE_RANGE> m_freeVertices;
+	std::vector<FREE_RANGE> m_freeIndices;
+	// every added mesh, indexed by its handle
+	std::vector<MESH_RANGE> m_meshes;
+	// increased whenever the buffers are replaced
+	int m_bufferVersion;
+
+	// take a range from a free list, returning -1 without room
+	static int AllocateRange(std::vector<FREE_RANGE>& freeRanges, int count);
+	// give a range back to a free list, joining its neighbors
+	static void ReleaseRange(std::vector<FREE_RANGE>& freeRanges, int first, int count);
+	// get the share of the used part of a buffer that a free
+	// list leaves in gaps between meshes
+	static float GetGapShare(const std::vector<FREE_RANGE>& freeRanges, int capacity);
+	// replace the buffers with larger ones holding the same data
+	void Grow(int vertexCapacity, int indexCapacity);
+
+public:
+	// create the buffers with the passed in vertex size and
+	// starting capacities
+	void Create(int vertexSize, int vertexCapacity, int indexCapacity);
+	// free the buffers and forget every mesh
+	void Destroy();
+
+	// copy a mesh into the buffers, returning its handle - the
+	// indices are relative to the first vertex of the mesh
+	int AddMesh(
+		const void* vertices,
+		int vertexCount,
+		const GLuint* indices,
+		int indexCount);
+	// give the space of a mesh back to the buffers
+	void RemoveMesh(int mesh);
+	// move every mesh to the start of the buffers, so the free
+	// space is one range at the end
+	void Defragment();
+
+	// get the place of a mesh in the buffers
+	const MESH_RANGE& GetMesh(int mesh) const;
+
+	// get the shared buffers
+	GLuint GetVertexBuffer() const;
+	GLuint GetIndexBuffer() const;
+	// get the number that changes whenever the buffers change
+	int GetBufferVersion() const;
+	// get the share of the used part of the buffers lost in
+	// gaps between meshes
+	float GetFragmentation() const;
+};
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionqueries.cpp
+// ============
+// find the scene objects that are hidden behind large occluders
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OcclusionQueries.h"
+
+/***********************************************************
+ *  OcclusionQueries()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+OcclusionQueries::OcclusionQueries()
+{
+	m_currentSet = 0;
+	m_activeObject = -1;
+}
+
+/***********************************************************
+ *  ~OcclusionQueries()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+OcclusionQueries::~OcclusionQueries()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the query objects for the
+ *  passed in number of objects.  Any existing queries are
+ *  freed first.
+ ***********************************************************/
+void OcclusionQueries::Create(int objectCount)
+{
+	Destroy();
+
+	if (objectCount <= 0)
+	{
+		return;
+	}
+
+	for (int s = 0; s < QUERY_SET_COUNT; s++)
+	{
+		m_queries[s].resize(objectCount);
+		glGenQueries(objectCount, m_queries[s].data());
+		m_issued[s].assign(objectCount, 0);
+	}
+	m_occluded.assign(objectCount, 0);
+	m_currentSet = 0;
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for reading the results of the queries
+ *  issued during the last frame, and for switching to the
+ *  other query set for this frame.  Only results that are
+ *  already available are read, so this never stalls.
+ ***********************************************************/
+void OcclusionQueries::BeginFrame()
+{
+	int lastSet = m_currentSet;
+
+	for (size_t i = 0; i < m_occluded.size(); i++)
+	{
+		GLuint available = GL_FALSE;
+		GLuint anySamples = GL_TRUE;
+
+		m_occluded[i] = 0;
+		if (m_issued[lastSet][i] == 0)
+		{
+			continue;
+		}
+
+		glGetQueryObjectuiv(m_queries[lastSet][i], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == GL_TRUE)
+		{
+			glGetQueryObjectuiv(m_queries[lastSet][i], GL_QUERY_RESULT, &anySamples);
+			m_occluded[i] = (anySamples == GL_FALSE) ? 1 : 0;
+		}
+	}
+
+	m_currentSet = (m_currentSet + 1) % QUERY_SET_COUNT;
+	m_issued[m_currentSet].assign(m_issued[m_currentSet].size(), 0);
+}
+
+/***********************************************************
+ *  Reset()
+ *
+ *  This method is used for forgetting every query result, so
+ *  that every object counts as visible until it is queried
+ *  again.
+ ***********************************************************/
+void OcclusionQueries::Reset()
+{
+	for (int s = 0; s < QUERY_SET_COUNT; s++)
+	{
+		m_issued[s].assign(m_issued[s].size(), 0);
+	}
+	m_occluded.assign(m_occluded.size(), 0);
+}
+
+/***********************************************************
+ *  BeginQuery()
+ *
+ *  This method is used for starting the query of an object.
+ *  The draws until EndQuery() are tested against the depth
+ *  buffer, and the object is hidden when none of their
+ *  samples pass.
+ ***********************************************************/
+void OcclusionQueries::BeginQuery(int object)
+{
+	if ((object < 0) || (object >= (int)m_occluded.size()) || (m_activeObject >= 0))
+	{
+		return;
+	}
+
+	glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, m_queries[m_currentSet][object]);
+	m_issued[m_currentSet][object] = 1;
+	m_activeObject = object;
+}
+
+/***********************************************************
+ *  EndQuery()
+ *
+ *  This method is used for ending the active query.
+ ***********************************************************/
+void OcclusionQueries::EndQuery()
+{
+	if (m_activeObject < 0)
+	{
+		return;
+	}
+
+	glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+	m_activeObject = -1;
+}
+
+/***********************************************************
+ *  IsOccluded()
+ *
+ *  This method is used for checking whether an object was
+ *  hidden when it was last queried.
+ ***********************************************************/
+bool OcclusionQueries::IsOccluded(int object) const
+{
+	if ((object < 0) || (object >= (int)m_occluded.size()))
+	{
+		return(false);
+	}
+
+	return(m_occluded[object] != 0);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the query objects.
+ ***********************************************************/
+void OcclusionQueries::Destroy()
+{
+	if (m_activeObject >= 0)
+	{
+		EndQuery();
+	}
+
+	for (int s = 0; s < QUERY_SET_COUNT; s++)
+	{
+		if (m_queries[s].empty() == false)
+		{
+			glDeleteQueries((GLsizei)m_queries[s].size(), m_queries[s].data());
+		}
+		m_queries[s].clear();
+		m_issued[s].clear();
+	}
+	m_occluded.clear();
+}
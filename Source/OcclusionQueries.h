@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionqueries.h
+// ============
+// find the scene objects that are hidden behind large occluders
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  OcclusionQueries
+ *
+ *  This class owns one occlusion query per scene object for
+ *  each of two frames.  The queries of a frame are read at
+ *  the start of the next frame, while the other set is being
+ *  issued, so the CPU never waits for the GPU to finish.  A
+ *  result that has not arrived yet counts as visible.
+ ***********************************************************/
+class OcclusionQueries
+{
+public:
+	// constructor
+	OcclusionQueries();
+	// destructor
+	~OcclusionQueries();
+
+	// number of query sets used in turn
+	static const int QUERY_SET_COUNT = 2;
+
+private:
+	// query objects of each set, one per object
+	std::vector<GLuint> m_queries[QUERY_SET_COUNT];
+	// 1 for each object that was queried with the set
+	std::vector<char> m_issued[QUERY_SET_COUNT];
+	// 1 for each object that was hidden in the last result
+	std::vector<char> m_occluded;
+	// set that receives the queries of the current frame
+	int m_currentSet;
+	// object whose query is currently active, -1 for none
+	int m_activeObject;
+
+public:
+	// create the query objects for the passed in number of objects
+	void Create(int objectCount);
+	// read the results of the last frame and switch query sets
+	void BeginFrame();
+	// forget every result, for example after the queries have
+	// not been issued for a while
+	void Reset();
+
+	// count the samples of the following draws for an object
+	void BeginQuery(int object);
+	void EndQuery();
+
+	// true when the object was hidden in the last result
+	bool IsOccluded(int object) const;
+
+	// free the query objects
+	void Destroy();
+};
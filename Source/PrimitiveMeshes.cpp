@@ -0,0 +1,1143 @@
+///////////////////////////////////////////////////////////////////////////////
+// primitivemeshes.cpp
+// ============
+// create the basic 3D shape meshes for instanced drawing
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PrimitiveMeshes.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	const float g_PI = 3.14159265358979f;
+
+	// tessellation of the curved shapes for each level of detail
+	const int g_CylinderSlices[PrimitiveMeshes::LOD_COUNT] = { 36, 18, 10 };
+	const int g_SphereStacks[PrimitiveMeshes::LOD_COUNT] = { 18, 10, 6 };
+	const int g_SphereSlices[PrimitiveMeshes::LOD_COUNT] = { 36, 18, 10 };
+	const int g_TorusMainSegments[PrimitiveMeshes::LOD_COUNT] = { 36, 18, 10 };
+	const int g_TorusTubeSegments[PrimitiveMeshes::LOD_COUNT] = { 18, 10, 6 };
+
+	// dimensions of the torus
+	const float g_TorusMainRadius = 1.0f;
+	const float g_TorusTubeRadius = 0.2f;
+
+	// vertex attribute locations used by the shaders
+	const GLuint g_PositionLocation = 0;
+	const GLuint g_NormalLocation = 1;
+	const GLuint g_TextureCoordinateLocation = 2;
+	const GLuint g_InstanceModelLocation = 3;
+	const GLuint g_InstanceMaterialLocation = 7;
+	const GLuint g_InstanceColorLocation = 8;
+	const GLuint g_InstanceUVScaleLocation = 9;
+
+	// vertex buffer binding points of the vertex layout
+	const GLuint g_VertexBinding = 0;
+	const GLuint g_InstanceBinding = 1;
+
+	// draw data records the ring buffer starts with for each
+	// frame - it grows when a frame needs more
+	const int g_InitialRecordCapacity = 1024;
+	// indirect commands the command ring starts with for each
+	// frame
+	const int g_InitialCommandCapacity = 256;
+
+	// vertices and indices the mesh arena starts with, which
+	// hold all of the basic shapes without growing
+	const int g_ArenaVertexCapacity = 16384;
+	const int g_ArenaIndexCapacity = 65536;
+	// share of the arena lost in gaps that makes unloading a
+	// mesh pack the arena
+	const float g_DefragmentThreshold = 0.25f;
+}
+
+/***********************************************************
+ *  PrimitiveMeshes()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PrimitiveMeshes::PrimitiveMeshes()
+{
+	for (int i = 0; i < MESH_KIND_COUNT; i++)
+	{
+		for (int lod = 0; lod < LOD_COUNT; lod++)
+		{
+			m_meshes[i][lod].arenaMesh = -1;
+			m_meshes[i][lod].boundsMinimum = glm::vec3(0.0f);
+			m_meshes[i][lod].boundsMaximum = glm::vec3(0.0f);
+		}
+		m_lodCounts[i] = 0;
+	}
+	m_layoutVersion = 0;
+	m_vao = 0;
+	m_indirectRecordBuffer = 0;
+	m_recordCapacity = 0;
+	m_drawDataBytes = 0;
+	m_drawCalls = 0;
+	m_commandCapacity = 0;
+	m_indirectCommands = 0;
+}
+
+/***********************************************************
+ *  ~PrimitiveMeshes()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+PrimitiveMeshes::~PrimitiveMeshes()
+{
+	DestroyMeshes();
+}
+
+/***********************************************************
+ *  LoadMeshes()
+ *
+ *  This method is used for generating all of the basic shape
+ *  meshes and loading them into the mesh arena.  The flat
+ *  shapes have a single level of detail, and the curved
+ *  shapes are generated once for every level.
+ ***********************************************************/
+void PrimitiveMeshes::LoadMeshes()
+{
+	std::vector<MESH_VERTEX> vertices;
+	std::vector<GLuint> indices;
+
+	if (0 == m_arena.GetVertexBuffer())
+	{
+		m_arena.Create(sizeof(MESH_VERTEX), g_ArenaVertexCapacity, g_ArenaIndexCapacity);
+	}
+
+	GeneratePlane(vertices, indices);
+	CreateMesh(MESH_PLANE, 0, vertices, indices);
+	GenerateBox(vertices, indices);
+	CreateMesh(MESH_BOX, 0, vertices, indices);
+	GeneratePyramid4(vertices, indices);
+	CreateMesh(MESH_PYRAMID4, 0, vertices, indices);
+
+	for (int lod = 0; lod < LOD_COUNT; lod++)
+	{
+		GenerateCylinder(lod, vertices, indices);
+		CreateMesh(MESH_CYLINDER, lod, vertices, indices);
+		GenerateSphere(lod, vertices, indices);
+		CreateMesh(MESH_SPHERE, lod, vertices, indices);
+		GenerateTorus(lod, vertices, indices);
+		CreateMesh(MESH_TORUS, lod, vertices, indices);
+	}
+
+	if (0 == m_vao)
+	{
+		CreateVertexLayout();
+	}
+	UpdateVertexLayout();
+
+	if (0 == m_drawData.GetBuffer())
+	{
+		CreateDrawData(g_InitialRecordCapacity);
+	}
+	if (0 == m_commandData.GetBuffer())
+	{
+		if (m_commandData.Create(g_InitialCommandCapacity * sizeof(INDIRECT_COMMAND)) == true)
+		{
+			m_commandCapacity = g_InitialCommandCapacity;
+		}
+	}
+}
+
+/***********************************************************
+ *  DestroyMeshes()
+ *
+ *  This method is used for freeing the OpenGL buffers of all
+ *  the loaded meshes.
+ ***********************************************************/
+void PrimitiveMeshes::DestroyMeshes()
+{
+	for (int i = 0; i < MESH_KIND_COUNT; i++)
+	{
+		for (int lod = 0; lod < LOD_COUNT; lod++)
+		{
+			m_meshes[i][lod].arenaMesh = -1;
+		}
+		m_lodCounts[i] = 0;
+	}
+	m_arena.Destroy();
+	m_layoutVersion = 0;
+
+	if (0 != m_vao)
+	{
+		glDeleteVertexArrays(1, &m_vao);
+	}
+	m_vao = 0;
+	m_indirectRecordBuffer = 0;
+
+	m_drawData.Destroy();
+	m_recordCapacity = 0;
+	m_commandData.Destroy();
+	m_commandCapacity = 0;
+	m_queuedCommands.clear();
+}
+
+/***********************************************************
+ *  CreateMesh()
+ *
+ *  This method is used for copying generated geometry into the
+ *  mesh arena as one level of a basic shape.  The indices stay
+ *  relative to the first vertex of the mesh, which every draw
+ *  passes as its base vertex.  The levels of a mesh must be
+ *  created in order.
+ ***********************************************************/
+void PrimitiveMeshes::CreateMesh(
+	MESH_KIND mesh,
+	int lod,
+	const std::vector<MESH_VERTEX>& vertices,
+	const std::vector<GLuint>& indices)
+{
+	GL_MESH& glMesh = m_meshes[mesh][lod];
+
+	glMesh.arenaMesh = m_arena.AddMesh(
+		vertices.data(),
+		(int)vertices.size(),
+		indices.data(),
+		(int)indices.size());
+	if (glMesh.arenaMesh < 0)
+	{
+		return;
+	}
+
+	if (lod >= m_lodCounts[mesh])
+	{
+		m_lodCounts[mesh] = lod + 1;
+	}
+
+	glMesh.boundsMinimum = vertices[0].position;
+	glMesh.boundsMaximum = vertices[0].position;
+	for (size_t i = 1; i < vertices.size(); i++)
+	{
+		glMesh.boundsMinimum = glm::min(glMesh.boundsMinimum, vertices[i].position);
+		glMesh.boundsMaximum = glm::max(glMesh.boundsMaximum, vertices[i].position);
+	}
+}
+
+/***********************************************************
+ *  CreateVertexLayout()
+ *
+ *  This method is used for setting up the one vertex layout
+ *  that all of the meshes are drawn with.  The attribute
+ *  formats are kept apart from the buffers they read, so the
+ *  per-vertex attributes can be pointed at new arena buffers,
+ *  and the per-instance attributes at another buffer of
+ *  records, by binding the buffer to its binding point alone.
+ ***********************************************************/
+void PrimitiveMeshes::CreateVertexLayout()
+{
+	glGenVertexArrays(1, &m_vao);
+	glBindVertexArray(m_vao);
+
+	// per-vertex data
+	glVertexAttribFormat(g_PositionLocation, 3, GL_FLOAT, GL_FALSE, 0);
+	glVertexAttribBinding(g_PositionLocation, g_VertexBinding);
+	glEnableVertexAttribArray(g_PositionLocation);
+	glVertexAttribFormat(g_NormalLocation, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3));
+	glVertexAttribBinding(g_NormalLocation, g_VertexBinding);
+	glEnableVertexAttribArray(g_NormalLocation);
+	glVertexAttribFormat(g_TextureCoordinateLocation, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3));
+	glVertexAttribBinding(g_TextureCoordinateLocation, g_VertexBinding);
+	glEnableVertexAttribArray(g_TextureCoordinateLocation);
+
+	// per-instance data - every attribute of the instance
+	// binding advances once per instance
+	const GLuint colorOffset = sizeof(glm::mat4);
+	const GLuint uvScaleOffset = colorOffset + sizeof(glm::vec4);
+	const GLuint materialOffset = uvScaleOffset + sizeof(glm::vec2);
+
+	// the model matrix takes one attribute location for each of
+	// its four columns
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glVertexAttribFormat(g_InstanceModelLocation + column, 4, GL_FLOAT, GL_FALSE, column * sizeof(glm::vec4));
+		glVertexAttribBinding(g_InstanceModelLocation + column, g_InstanceBinding);
+		glEnableVertexAttribArray(g_InstanceModelLocation + column);
+	}
+	glVertexAttribIFormat(g_InstanceMaterialLocation, 1, GL_INT, materialOffset);
+	glVertexAttribBinding(g_InstanceMaterialLocation, g_InstanceBinding);
+	glEnableVertexAttribArray(g_InstanceMaterialLocation);
+	glVertexAttribFormat(g_InstanceColorLocation, 4, GL_FLOAT, GL_FALSE, colorOffset);
+	glVertexAttribBinding(g_InstanceColorLocation, g_InstanceBinding);
+	glEnableVertexAttribArray(g_InstanceColorLocation);
+	glVertexAttribFormat(g_InstanceUVScaleLocation, 2, GL_FLOAT, GL_FALSE, uvScaleOffset);
+	glVertexAttribBinding(g_InstanceUVScaleLocation, g_InstanceBinding);
+	glEnableVertexAttribArray(g_InstanceUVScaleLocation);
+	glVertexBindingDivisor(g_InstanceBinding, 1);
+
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  UpdateVertexLayout()
+ *
+ *  This method is used for pointing the vertex layout at the
+ *  arena buffers again when the arena has replaced them, after
+ *  growing or packing.  Only the vertex binding point and the
+ *  index buffer change, and the per-instance attributes keep
+ *  reading their own buffer.
+ ***********************************************************/
+void PrimitiveMeshes::UpdateVertexLayout()
+{
+	if ((0 == m_vao) || (m_layoutVersion == m_arena.GetBufferVersion()))
+	{
+		return;
+	}
+
+	glBindVertexArray(m_vao);
+	glBindVertexBuffer(g_VertexBinding, m_arena.GetVertexBuffer(), 0, sizeof(MESH_VERTEX));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_arena.GetIndexBuffer());
+	glBindVertexArray(0);
+
+	m_layoutVersion = m_arena.GetBufferVersion();
+}
+
+/***********************************************************
+ *  SetInstanceLayout()
+ *
+ *  This method is used for pointing the per-instance vertex
+ *  attributes of the shared vertex layout at the ring buffer,
+ *  by binding it to the instance binding point.  An instance
+ *  reads the record at its base instance plus its own
+ *  instance number.
+ ***********************************************************/
+void PrimitiveMeshes::SetInstanceLayout()
+{
+	if (0 == m_vao)
+	{
+		return;
+	}
+
+	glBindVertexArray(m_vao);
+	glBindVertexBuffer(g_InstanceBinding, m_drawData.GetBuffer(), 0, sizeof(INSTANCE_DATA));
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  CreateDrawData()
+ *
+ *  This method is used for creating the ring buffer with room
+ *  for the passed in number of records in each frame.  The
+ *  vertex layout is pointed at the new buffer.
+ ***********************************************************/
+bool PrimitiveMeshes::CreateDrawData(int recordCapacity)
+{
+	if (m_drawData.Create(recordCapacity * sizeof(INSTANCE_DATA)) == false)
+	{
+		m_recordCapacity = 0;
+		return(false);
+	}
+	m_recordCapacity = recordCapacity;
+	SetInstanceLayout();
+
+	return(true);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting the draw data of a frame,
+ *  which moves the ring buffers on to their next regions.
+ ***********************************************************/
+void PrimitiveMeshes::BeginFrame()
+{
+	m_drawData.BeginFrame();
+	m_commandData.BeginFrame();
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for ending the draw data of a frame,
+ *  after its last draw was submitted.
+ ***********************************************************/
+void PrimitiveMeshes::EndFrame()
+{
+	SubmitQueuedRecords();
+	m_drawData.EndFrame();
+	m_commandData.EndFrame();
+}
+
+/***********************************************************
+ *  WriteDrawData()
+ *
+ *  This method is used for copying records into the region of
+ *  the current frame, right after the records written before
+ *  them.  A frame that needs more room than the region has
+ *  submits its queued draws, waits for the GPU to finish and
+ *  grows the ring buffer, so the records written before are
+ *  gone and must already have been drawn.
+ ***********************************************************/
+int PrimitiveMeshes::WriteDrawData(const INSTANCE_DATA* instances, int instanceCount)
+{
+	GLsizeiptr size = instanceCount * sizeof(INSTANCE_DATA);
+	GLsizeiptr bufferOffset = 0;
+
+	void* pRecords = m_drawData.Allocate(size, sizeof(INSTANCE_DATA), bufferOffset);
+	if (NULL == pRecords)
+	{
+		int recordCapacity = m_recordCapacity * 2;
+		if (recordCapacity < instanceCount)
+		{
+			recordCapacity = instanceCount;
+		}
+
+		SubmitQueuedRecords();
+		glFinish();
+		if (CreateDrawData(recordCapacity) == false)
+		{
+			return(-1);
+		}
+		std::cout << "INFO: grew the draw data to " << recordCapacity << " records per frame" << std::endl;
+
+		pRecords = m_drawData.Allocate(size, sizeof(INSTANCE_DATA), bufferOffset);
+		if (NULL == pRecords)
+		{
+			return(-1);
+		}
+	}
+
+	memcpy(pRecords, instances, size);
+	m_drawDataBytes += (int)size;
+
+	return((int)(bufferOffset / sizeof(INSTANCE_DATA)));
+}
+
+/***********************************************************
+ *  DrawRecords()
+ *
+ *  This method is used for drawing one copy of a mesh for each
+ *  of the passed in records.  The base instance of the draw
+ *  selects the first record, and the base vertex selects the
+ *  mesh in the shared buffers, so no state is changed between
+ *  draws of different meshes or records.
+ ***********************************************************/
+void PrimitiveMeshes::DrawRecords(MESH_KIND mesh, int lod, int firstRecord, int recordCount)
+{
+	if ((recordCount <= 0) || (firstRecord < 0) || (lod < 0) || (lod >= m_lodCounts[mesh]))
+	{
+		return;
+	}
+
+	const MeshArena::MESH_RANGE& range = m_arena.GetMesh(m_meshes[mesh][lod].arenaMesh);
+
+	glBindVertexArray(m_vao);
+	glDrawElementsInstancedBaseVertexBaseInstance(
+		GL_TRIANGLES,
+		range.indexCount,
+		GL_UNSIGNED_INT,
+		(void*)(range.firstIndex * sizeof(GLuint)),
+		recordCount,
+		range.baseVertex,
+		(GLuint)firstRecord);
+	glBindVertexArray(0);
+
+	m_drawCalls++;
+}
+
+/***********************************************************
+ *  QueueRecords()
+ *
+ *  This method is used for adding a draw of the passed in
+ *  records to the next multi-draw submission.  The records
+ *  must stay in the draw data until it is submitted, which
+ *  WriteDrawData() takes care of when the ring buffer grows.
+ ***********************************************************/
+void PrimitiveMeshes::QueueRecords(MESH_KIND mesh, int lod, int firstRecord, int recordCount)
+{
+	if ((recordCount <= 0) || (firstRecord < 0) || (lod < 0) || (lod >= m_lodCounts[mesh]))
+	{
+		return;
+	}
+
+	const MeshArena::MESH_RANGE& range = m_arena.GetMesh(m_meshes[mesh][lod].arenaMesh);
+	INDIRECT_COMMAND command;
+
+	command.count = (GLuint)range.indexCount;
+	command.instanceCount = (GLuint)recordCount;
+	command.firstIndex = range.firstIndex;
+	command.baseVertex = range.baseVertex;
+	command.baseInstance = (GLuint)firstRecord;
+	m_queuedCommands.push_back(command);
+}
+
+/***********************************************************
+ *  SubmitQueuedRecords()
+ *
+ *  This method is used for copying the queued draws into the
+ *  command ring buffer and drawing all of them with a single
+ *  glMultiDrawElementsIndirect() call.  The command ring grows
+ *  the same way as the draw data when a frame outgrows it.
+ ***********************************************************/
+int PrimitiveMeshes::SubmitQueuedRecords()
+{
+	int commandCount = (int)m_queuedCommands.size();
+
+	if (commandCount == 0)
+	{
+		return(0);
+	}
+
+	GLsizeiptr size = commandCount * sizeof(INDIRECT_COMMAND);
+	GLsizeiptr bufferOffset = 0;
+
+	void* pCommands = m_commandData.Allocate(size, sizeof(INDIRECT_COMMAND), bufferOffset);
+	if (NULL == pCommands)
+	{
+		int commandCapacity = m_commandCapacity * 2;
+		if (commandCapacity < commandCount)
+		{
+			commandCapacity = commandCount;
+		}
+
+		glFinish();
+		if (m_commandData.Create(commandCapacity * sizeof(INDIRECT_COMMAND)) == false)
+		{
+			m_commandCapacity = 0;
+			m_queuedCommands.clear();
+			return(0);
+		}
+		m_commandCapacity = commandCapacity;
+		std::cout << "INFO: grew the indirect commands to " << commandCapacity << " per frame" << std::endl;
+
+		pCommands = m_commandData.Allocate(size, sizeof(INDIRECT_COMMAND), bufferOffset);
+		if (NULL == pCommands)
+		{
+			m_queuedCommands.clear();
+			return(0);
+		}
+	}
+
+	memcpy(pCommands, m_queuedCommands.data(), size);
+	m_queuedCommands.clear();
+
+	glBindVertexArray(m_vao);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandData.GetBuffer());
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)bufferOffset, commandCount, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexArray(0);
+
+	m_drawCalls++;
+	m_indirectCommands += commandCount;
+
+	return(commandCount);
+}
+
+/***********************************************************
+ *  GetIndirectCommand()
+ *
+ *  This method is used for getting the indirect command that
+ *  draws one level of a mesh.  It draws no copies yet, so the
+ *  number of copies and the first record are left for the GPU
+ *  to fill in.
+ ***********************************************************/
+bool PrimitiveMeshes::GetIndirectCommand(MESH_KIND mesh, int lod, INDIRECT_COMMAND& command) const
+{
+	command.count = 0;
+	command.instanceCount = 0;
+	command.firstIndex = 0;
+	command.baseVertex = 0;
+	command.baseInstance = 0;
+
+	if ((lod < 0) || (lod >= m_lodCounts[mesh]))
+	{
+		return(false);
+	}
+
+	const MeshArena::MESH_RANGE& range = m_arena.GetMesh(m_meshes[mesh][lod].arenaMesh);
+	command.count = (GLuint)range.indexCount;
+	command.firstIndex = range.firstIndex;
+	command.baseVertex = range.baseVertex;
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetIndirectRecordBuffer()
+ *
+ *  This method is used for setting the buffer of records that
+ *  the draws of DrawIndirect() read, such as the records of
+ *  the visible objects written by a compute shader.
+ ***********************************************************/
+void PrimitiveMeshes::SetIndirectRecordBuffer(GLuint recordBuffer)
+{
+	m_indirectRecordBuffer = recordBuffer;
+}
+
+/***********************************************************
+ *  DrawIndirect()
+ *
+ *  This method is used for drawing a range of commands that
+ *  were written into a command buffer on the GPU, with one
+ *  multi-draw-indirect call.  The queued draws go first, so
+ *  the draw order is kept.  Only the instance binding point
+ *  of the shared vertex layout is pointed at the indirect
+ *  records for the call, and then back at the ring buffer.
+ ***********************************************************/
+void PrimitiveMeshes::DrawIndirect(GLuint commandBuffer, int firstCommand, int commandCount)
+{
+	if ((0 == m_vao) || (0 == m_indirectRecordBuffer) || (commandCount <= 0))
+	{
+		return;
+	}
+
+	SubmitQueuedRecords();
+
+	glBindVertexArray(m_vao);
+	glBindVertexBuffer(g_InstanceBinding, m_indirectRecordBuffer, 0, sizeof(INSTANCE_DATA));
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+	glMultiDrawElementsIndirect(
+		GL_TRIANGLES,
+		GL_UNSIGNED_INT,
+		(void*)(firstCommand * sizeof(INDIRECT_COMMAND)),
+		commandCount,
+		0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexBuffer(g_InstanceBinding, m_drawData.GetBuffer(), 0, sizeof(INSTANCE_DATA));
+	glBindVertexArray(0);
+
+	m_drawCalls++;
+	m_indirectCommands += commandCount;
+}
+
+/***********************************************************
+ *  DrawInstanced()
+ *
+ *  This method is used for drawing every passed in instance
+ *  of a mesh with a single draw call.  The instance data is
+ *  written into the draw data of the current frame first.
+ ***********************************************************/
+void PrimitiveMeshes::DrawInstanced(
+	MESH_KIND mesh,
+	int lod,
+	const INSTANCE_DATA* instances,
+	int instanceCount)
+{
+	if ((instanceCount <= 0) || (lod < 0) || (lod >= m_lodCounts[mesh]))
+	{
+		return;
+	}
+
+	int firstRecord = WriteDrawData(instances, instanceCount);
+	DrawRecords(mesh, lod, firstRecord, instanceCount);
+}
+
+/***********************************************************
+ *  DrawSingle()
+ *
+ *  This method is used for drawing one copy of a mesh, placed
+ *  and colored by a single record of draw data.
+ ***********************************************************/
+void PrimitiveMeshes::DrawSingle(MESH_KIND mesh, int lod, const INSTANCE_DATA& instance)
+{
+	DrawInstanced(mesh, lod, &instance, 1);
+}
+
+/***********************************************************
+ *  UnloadMesh()
+ *
+ *  This method is used for giving the space of every level of
+ *  a mesh back to the mesh arena, so a scene that never draws
+ *  a shape does not keep it.  When too much of the arena is
+ *  lost in gaps between meshes, the meshes are packed together
+ *  again.  The queued draws are submitted first, since packing
+ *  moves the meshes they point at.
+ ***********************************************************/
+void PrimitiveMeshes::UnloadMesh(MESH_KIND mesh)
+{
+	if (m_lodCounts[mesh] == 0)
+	{
+		return;
+	}
+
+	SubmitQueuedRecords();
+
+	for (int lod = 0; lod < m_lodCounts[mesh]; lod++)
+	{
+		m_arena.RemoveMesh(m_meshes[mesh][lod].arenaMesh);
+		m_meshes[mesh][lod].arenaMesh = -1;
+	}
+	m_lodCounts[mesh] = 0;
+
+	float fragmentation = m_arena.GetFragmentation();
+	if (fragmentation > g_DefragmentThreshold)
+	{
+		m_arena.Defragment();
+		UpdateVertexLayout();
+		std::cout << "INFO: packed the mesh arena, " << (int)(fragmentation * 100.0f) << "% was lost in gaps" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  GetBufferVersion()
+ *
+ *  This method is used for getting the number that changes
+ *  whenever the meshes move in the shared buffers, so that
+ *  indirect commands built from them can be built again.
+ ***********************************************************/
+int PrimitiveMeshes::GetBufferVersion() const
+{
+	return(m_arena.GetBufferVersion());
+}
+
+/***********************************************************
+ *  GetLocalBounds()
+ *
+ *  This method is used for getting the object space bounds
+ *  of a loaded mesh.  The full detail level is used, since it
+ *  holds the lower levels.
+ ***********************************************************/
+void PrimitiveMeshes::GetLocalBounds(
+	MESH_KIND mesh,
+	glm::vec3& minimum,
+	glm::vec3& maximum) const
+{
+	minimum = m_meshes[mesh][0].boundsMinimum;
+	maximum = m_meshes[mesh][0].boundsMaximum;
+}
+
+/***********************************************************
+ *  GetLodCount()
+ *
+ *  This method is used for getting the number of levels of
+ *  detail that were loaded for a mesh.
+ ***********************************************************/
+int PrimitiveMeshes::GetLodCount(MESH_KIND mesh) const
+{
+	return(m_lodCounts[mesh]);
+}
+
+/***********************************************************
+ *  GetTriangleCount()
+ *
+ *  This method is used for getting the number of triangles
+ *  of one level of detail of a mesh.
+ ***********************************************************/
+int PrimitiveMeshes::GetTriangleCount(MESH_KIND mesh, int lod) const
+{
+	if ((lod < 0) || (lod >= m_lodCounts[mesh]))
+	{
+		return(0);
+	}
+
+	return((int)m_arena.GetMesh(m_meshes[mesh][lod].arenaMesh).indexCount / 3);
+}
+
+/***********************************************************
+ *  GetDrawCallCount()
+ *
+ *  This method is used for getting the number of instanced
+ *  draw calls since the last reset.
+ ***********************************************************/
+int PrimitiveMeshes::GetDrawCallCount() const
+{
+	return(m_drawCalls);
+}
+
+/***********************************************************
+ *  GetIndirectCommandCount()
+ *
+ *  This method is used for getting the number of indirect
+ *  commands submitted since the last reset.
+ ***********************************************************/
+int PrimitiveMeshes::GetIndirectCommandCount() const
+{
+	return(m_indirectCommands);
+}
+
+/***********************************************************
+ *  ResetDrawCallCount()
+ *
+ *  This method is used for resetting the number of draw calls
+ *  and indirect commands.
+ ***********************************************************/
+void PrimitiveMeshes::ResetDrawCallCount()
+{
+	m_drawCalls = 0;
+	m_indirectCommands = 0;
+}
+
+/***********************************************************
+ *  GetDrawDataBytes()
+ *
+ *  This method is used for getting the bytes of draw data
+ *  written since the last reset.
+ ***********************************************************/
+int PrimitiveMeshes::GetDrawDataBytes() const
+{
+	return(m_drawDataBytes);
+}
+
+/***********************************************************
+ *  GetDrawDataStallCount()
+ *
+ *  This method is used for getting the number of frames whose
+ *  region of the ring buffer was still read by the GPU.
+ ***********************************************************/
+int PrimitiveMeshes::GetDrawDataStallCount() const
+{
+	return(m_drawData.GetStallCount());
+}
+
+/***********************************************************
+ *  ResetDrawDataStats()
+ *
+ *  This method is used for resetting the draw data counters.
+ ***********************************************************/
+void PrimitiveMeshes::ResetDrawDataStats()
+{
+	m_drawDataBytes = 0;
+	m_drawData.ResetStallCount();
+}
+
+/***********************************************************
+ *  AddTriangle()
+ *
+ *  This method is used for adding a triangle to the indices,
+ *  with its winding chosen so that it faces the same way as
+ *  the normals of its vertices.
+ ***********************************************************/
+void PrimitiveMeshes::AddTriangle(
+	const std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices,
+	GLuint a, GLuint b, GLuint c)
+{
+	glm::vec3 faceNormal = glm::cross(
+		vertices[b].position - vertices[a].position,
+		vertices[c].position - vertices[a].position);
+	glm::vec3 vertexNormal = vertices[a].normal + vertices[b].normal + vertices[c].normal;
+
+	indices.push_back(a);
+	if (glm::dot(faceNormal, vertexNormal) < 0.0f)
+	{
+		indices.push_back(c);
+		indices.push_back(b);
+	}
+	else
+	{
+		indices.push_back(b);
+		indices.push_back(c);
+	}
+}
+
+/***********************************************************
+ *  AddQuad()
+ *
+ *  This method is used for adding a flat quad from four
+ *  corners that are given in order around the quad.
+ ***********************************************************/
+void PrimitiveMeshes::AddQuad(
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices,
+	glm::vec3 p0, glm::vec3 p1, glm::vec3 p2, glm::vec3 p3,
+	glm::vec3 normal)
+{
+	GLuint base = (GLuint)vertices.size();
+	MESH_VERTEX vertex;
+
+	vertex.normal = normal;
+	vertex.position = p0;
+	vertex.textureCoordinate = glm::vec2(0.0f, 0.0f);
+	vertices.push_back(vertex);
+	vertex.position = p1;
+	vertex.textureCoordinate = glm::vec2(1.0f, 0.0f);
+	vertices.push_back(vertex);
+	vertex.position = p2;
+	vertex.textureCoordinate = glm::vec2(1.0f, 1.0f);
+	vertices.push_back(vertex);
+	vertex.position = p3;
+	vertex.textureCoordinate = glm::vec2(0.0f, 1.0f);
+	vertices.push_back(vertex);
+
+	AddTriangle(vertices, indices, base, base + 1, base + 2);
+	AddTriangle(vertices, indices, base, base + 2, base + 3);
+}
+
+/***********************************************************
+ *  GeneratePlane()
+ *
+ *  This method is used for generating a flat plane on the
+ *  XZ axes, from -1 to 1, facing up.
+ ***********************************************************/
+void PrimitiveMeshes::GeneratePlane(
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	vertices.clear();
+	indices.clear();
+
+	AddQuad(vertices, indices,
+		glm::vec3(-1.0f, 0.0f, 1.0f),
+		glm::vec3(1.0f, 0.0f, 1.0f),
+		glm::vec3(1.0f, 0.0f, -1.0f),
+		glm::vec3(-1.0f, 0.0f, -1.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+/***********************************************************
+ *  GenerateBox()
+ *
+ *  This method is used for generating a unit box centered
+ *  on the origin, with its own normals for each side.
+ ***********************************************************/
+void PrimitiveMeshes::GenerateBox(
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	const float h = 0.5f;
+
+	vertices.clear();
+	indices.clear();
+
+	// front
+	AddQuad(vertices, indices,
+		glm::vec3(-h, -h, h), glm::vec3(h, -h, h), glm::vec3(h, h, h), glm::vec3(-h, h, h),
+		glm::vec3(0.0f, 0.0f, 1.0f));
+	// back
+	AddQuad(vertices, indices,
+		glm::vec3(h, -h, -h), glm::vec3(-h, -h, -h), glm::vec3(-h, h, -h), glm::vec3(h, h, -h),
+		glm::vec3(0.0f, 0.0f, -1.0f));
+	// right
+	AddQuad(vertices, indices,
+		glm::vec3(h, -h, h), glm::vec3(h, -h, -h), glm::vec3(h, h, -h), glm::vec3(h, h, h),
+		glm::vec3(1.0f, 0.0f, 0.0f));
+	// left
+	AddQuad(vertices, indices,
+		glm::vec3(-h, -h, -h), glm::vec3(-h, -h, h), glm::vec3(-h, h, h), glm::vec3(-h, h, -h),
+		glm::vec3(-1.0f, 0.0f, 0.0f));
+	// top
+	AddQuad(vertices, indices,
+		glm::vec3(-h, h, h), glm::vec3(h, h, h), glm::vec3(h, h, -h), glm::vec3(-h, h, -h),
+		glm::vec3(0.0f, 1.0f, 0.0f));
+	// bottom
+	AddQuad(vertices, indices,
+		glm::vec3(-h, -h, -h), glm::vec3(h, -h, -h), glm::vec3(h, -h, h), glm::vec3(-h, -h, h),
+		glm::vec3(0.0f, -1.0f, 0.0f));
+}
+
+/***********************************************************
+ *  GenerateCylinder()
+ *
+ *  This method is used for generating a cylinder with a
+ *  radius of 1, from 0 to 1 on the Y axis, with its top and
+ *  bottom closed.
+ ***********************************************************/
+void PrimitiveMeshes::GenerateCylinder(
+	int lod,
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	MESH_VERTEX vertex;
+	const int slices = g_CylinderSlices[lod];
+
+	vertices.clear();
+	indices.clear();
+
+	// sides - the seam is duplicated so the texture wraps once
+	for (int i = 0; i <= slices; i++)
+	{
+		float angle = 2.0f * g_PI * i / slices;
+		float x = sinf(angle);
+		float z = cosf(angle);
+
+		vertex.normal = glm::vec3(x, 0.0f, z);
+		vertex.position = glm::vec3(x, 0.0f, z);
+		vertex.textureCoordinate = glm::vec2((float)i / slices, 0.0f);
+		vertices.push_back(vertex);
+		vertex.position = glm::vec3(x, 1.0f, z);
+		vertex.textureCoordinate = glm::vec2((float)i / slices, 1.0f);
+		vertices.push_back(vertex);
+	}
+	for (int i = 0; i < slices; i++)
+	{
+		GLuint bottom = i * 2;
+		AddTriangle(vertices, indices, bottom, bottom + 2, bottom + 3);
+		AddTriangle(vertices, indices, bottom, bottom + 3, bottom + 1);
+	}
+
+	// top and bottom caps
+	for (int cap = 0; cap < 2; cap++)
+	{
+		float y = (cap == 0) ? 1.0f : 0.0f;
+		glm::vec3 normal = (cap == 0) ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, -1.0f, 0.0f);
+		GLuint center = (GLuint)vertices.size();
+
+		vertex.normal = normal;
+		vertex.position = glm::vec3(0.0f, y, 0.0f);
+		vertex.textureCoordinate = glm::vec2(0.5f, 0.5f);
+		vertices.push_back(vertex);
+		for (int i = 0; i <= slices; i++)
+		{
+			float angle = 2.0f * g_PI * i / slices;
+			float x = sinf(angle);
+			float z = cosf(angle);
+
+			vertex.position = glm::vec3(x, y, z);
+			vertex.textureCoordinate = glm::vec2(0.5f + 0.5f * x, 0.5f + 0.5f * z);
+			vertices.push_back(vertex);
+		}
+		for (int i = 0; i < slices; i++)
+		{
+			AddTriangle(vertices, indices, center, center + 1 + i, center + 2 + i);
+		}
+	}
+}
+
+/***********************************************************
+ *  GenerateSphere()
+ *
+ *  This method is used for generating a sphere with a radius
+ *  of 1, centered on the origin.
+ ***********************************************************/
+void PrimitiveMeshes::GenerateSphere(
+	int lod,
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	MESH_VERTEX vertex;
+	const int stacks = g_SphereStacks[lod];
+	const int slices = g_SphereSlices[lod];
+
+	vertices.clear();
+	indices.clear();
+
+	for (int stack = 0; stack <= stacks; stack++)
+	{
+		float phi = g_PI * stack / stacks;
+		float ringRadius = sinf(phi);
+		float y = cosf(phi);
+
+		for (int slice = 0; slice <= slices; slice++)
+		{
+			float theta = 2.0f * g_PI * slice / slices;
+
+			vertex.position = glm::vec3(ringRadius * sinf(theta), y, ringRadius * cosf(theta));
+			vertex.normal = vertex.position;
+			vertex.textureCoordinate = glm::vec2(
+				(float)slice / slices,
+				1.0f - (float)stack / stacks);
+			vertices.push_back(vertex);
+		}
+	}
+
+	for (int stack = 0; stack < stacks; stack++)
+	{
+		for (int slice = 0; slice < slices; slice++)
+		{
+			GLuint upper = stack * (slices + 1) + slice;
+			GLuint lower = upper + slices + 1;
+
+			AddTriangle(vertices, indices, upper, lower, lower + 1);
+			AddTriangle(vertices, indices, upper, lower + 1, upper + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  GenerateTorus()
+ *
+ *  This method is used for generating a torus lying on the
+ *  XY axes, centered on the origin.
+ ***********************************************************/
+void PrimitiveMeshes::GenerateTorus(
+	int lod,
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	MESH_VERTEX vertex;
+	const int mainSegments = g_TorusMainSegments[lod];
+	const int tubeSegments = g_TorusTubeSegments[lod];
+
+	vertices.clear();
+	indices.clear();
+
+	for (int main = 0; main <= mainSegments; main++)
+	{
+		float u = 2.0f * g_PI * main / mainSegments;
+
+		for (int tube = 0; tube <= tubeSegments; tube++)
+		{
+			float v = 2.0f * g_PI * tube / tubeSegments;
+			float ringRadius = g_TorusMainRadius + g_TorusTubeRadius * cosf(v);
+
+			vertex.position = glm::vec3(ringRadius * cosf(u), ringRadius * sinf(u), g_TorusTubeRadius * sinf(v));
+			vertex.normal = glm::vec3(cosf(v) * cosf(u), cosf(v) * sinf(u), sinf(v));
+			vertex.textureCoordinate = glm::vec2(
+				(float)main / mainSegments,
+				(float)tube / tubeSegments);
+			vertices.push_back(vertex);
+		}
+	}
+
+	for (int main = 0; main < mainSegments; main++)
+	{
+		for (int tube = 0; tube < tubeSegments; tube++)
+		{
+			GLuint current = main * (tubeSegments + 1) + tube;
+			GLuint next = current + tubeSegments + 1;
+
+			AddTriangle(vertices, indices, current, next, next + 1);
+			AddTriangle(vertices, indices, current, next + 1, current + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  GeneratePyramid4()
+ *
+ *  This method is used for generating a pyramid with a unit
+ *  square base, centered on the origin.
+ ***********************************************************/
+void PrimitiveMeshes::GeneratePyramid4(
+	std::vector<MESH_VERTEX>& vertices,
+	std::vector<GLuint>& indices)
+{
+	const float h = 0.5f;
+	glm::vec3 apex(0.0f, h, 0.0f);
+	glm::vec3 corners[4] =
+	{
+		glm::vec3(-h, -h, h),
+		glm::vec3(h, -h, h),
+		glm::vec3(h, -h, -h),
+		glm::vec3(-h, -h, -h)
+	};
+	MESH_VERTEX vertex;
+
+	vertices.clear();
+	indices.clear();
+
+	// sides
+	for (int side = 0; side < 4; side++)
+	{
+		glm::vec3 left = corners[side];
+		glm::vec3 right = corners[(side + 1) % 4];
+		GLuint base = (GLuint)vertices.size();
+
+		vertex.normal = glm::normalize(glm::cross(right - left, apex - left));
+		vertex.position = left;
+		vertex.textureCoordinate = glm::vec2(0.0f, 0.0f);
+		vertices.push_back(vertex);
+		vertex.position = right;
+		vertex.textureCoordinate = glm::vec2(1.0f, 0.0f);
+		vertices.push_back(vertex);
+		vertex.position = apex;
+		vertex.textureCoordinate = glm::vec2(0.5f, 1.0f);
+		vertices.push_back(vertex);
+
+		AddTriangle(vertices, indices, base, base + 1, base + 2);
+	}
+
+	// base
+	AddQuad(vertices, indices,
+		corners[3], corners[2], corners[1], corners[0],
+		glm::vec3(0.0f, -1.0f, 0.0f));
+}
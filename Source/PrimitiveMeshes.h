@@ -0,0 +1,240 @@
+///////////////////////////////////////////////////////////////////////////////
+// primitivemeshes.h
+// ============
+// create the basic 3D shape meshes for instanced drawing
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "MeshArena.h"
+#include "RingBuffer.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// kinds of basic shape meshes that can be drawn
+enum MESH_KIND
+{
+	MESH_PLANE = 0,
+	MESH_BOX,
+	MESH_CYLINDER,
+	MESH_SPHERE,
+	MESH_TORUS,
+	MESH_PYRAMID4,
+	MESH_KIND_COUNT
+};
+
+/***********************************************************
+ *  PrimitiveMeshes
+ *
+ *  This class contains the basic shapes of the scene, and
+ *  each mesh reads a record of draw data for every drawn
+ *  instance.  Any number of copies of one mesh can then be
+ *  drawn with a single draw call.  The records of a whole
+ *  frame are written one after the other into a persistently
+ *  mapped ring buffer, and each draw selects its first record
+ *  with its base instance.  All of the meshes are suballocated
+ *  from one mesh arena and drawn with one vertex layout, so
+ *  draws of different meshes can also be queued and submitted
+ *  together with a single multi-draw-indirect call.  The
+ *  curved shapes are also generated at lower levels of
+ *  detail, with fewer slices and stacks, for objects that are
+ *  small on screen.
+ ***********************************************************/
+class PrimitiveMeshes
+{
+public:
+	// constructor
+	PrimitiveMeshes();
+	// destructor
+	~PrimitiveMeshes();
+
+	// number of levels of detail generated for the curved
+	// shapes - level 0 is the full tessellation
+	static const int LOD_COUNT = 3;
+
+	// data for one drawn copy of a mesh, read by the vertex
+	// shader from the ring buffer
+	struct INSTANCE_DATA
+	{
+		glm::mat4 modelMatrix;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		int materialIndex;
+		int padding;
+	};
+
+	// command layout read by glMultiDrawElementsIndirect()
+	struct INDIRECT_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+private:
+	// vertex layout of every mesh
+	struct MESH_VERTEX
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 textureCoordinate;
+	};
+
+	// one loaded mesh
+	struct GL_MESH
+	{
+		// handle of the mesh in the arena, or -1 when unloaded
+		int arenaMesh;
+		// object space bounds of the vertices
+		glm::vec3 boundsMinimum;
+		glm::vec3 boundsMaximum;
+	};
+
+	// loaded meshes, indexed by mesh kind and level of detail
+	GL_MESH m_meshes[MESH_KIND_COUNT][LOD_COUNT];
+	// number of loaded levels of detail of each mesh kind
+	int m_lodCounts[MESH_KIND_COUNT];
+	// shared buffers holding the geometry of every mesh
+	MeshArena m_arena;
+	// arena buffer version the vertex layout points at
+	int m_layoutVersion;
+	// vertex layout shared by all of the meshes
+	GLuint m_vao;
+	// buffer of records written on the GPU, read by the draws
+	// of DrawIndirect() through the instance binding point
+	GLuint m_indirectRecordBuffer;
+	// ring buffer holding the draw data records of each frame
+	RingBuffer m_drawData;
+	// number of records the region of each frame can hold
+	int m_recordCapacity;
+	// bytes of draw data written since the last reset
+	int m_drawDataBytes;
+	// number of instanced draw calls since the last reset
+	int m_drawCalls;
+
+	// draws queued for the next multi-draw submission
+	std::vector<INDIRECT_COMMAND> m_queuedCommands;
+	// ring buffer holding the indirect commands of each frame
+	RingBuffer m_commandData;
+	// number of commands the region of each frame can hold
+	int m_commandCapacity;
+	// number of indirect commands submitted since the last reset
+	int m_indirectCommands;
+
+	// set up the attribute formats of the vertex layout
+	void CreateVertexLayout();
+	// point the vertex layout at the arena buffers again after
+	// the arena replaced them
+	void UpdateVertexLayout();
+	// point the per-instance attributes of the vertex layout at
+	// the ring buffer
+	void SetInstanceLayout();
+	// create the ring buffer with room for the passed in number
+	// of records in each frame
+	bool CreateDrawData(int recordCapacity);
+
+	// add the generated geometry to the shared buffers
+	void CreateMesh(
+		MESH_KIND mesh,
+		int lod,
+		const std::vector<MESH_VERTEX>& vertices,
+		const std::vector<GLuint>& indices);
+
+	// add a triangle facing the same way as its vertex normals
+	static void AddTriangle(
+		const std::vector<MESH_VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		GLuint a, GLuint b, GLuint c);
+	// add a flat quad from four corners given in order
+	static void AddQuad(
+		std::vector<MESH_VERTEX>& vertices,
+		std::vector<GLuint>& indices,
+		glm::vec3 p0, glm::vec3 p1, glm::vec3 p2, glm::vec3 p3,
+		glm::vec3 normal);
+
+	// generate the geometry of the basic shapes
+	void GeneratePlane(std::vector<MESH_VERTEX>& vertices, std::vector<GLuint>& indices);
+	void GenerateBox(std::vector<MESH_VERTEX>& vertices, std::vector<GLuint>& indices);
+	void GenerateCylinder(int lod, std::vector<MESH_VERTEX>& vertices, std::vector<GLuint>& indices);
+	void GenerateSphere(int lod, std::vector<MESH_VERTEX>& vertices, std::vector<GLuint>& indices);
+	void GenerateTorus(int lod, std::vector<MESH_VERTEX>& vertices, std::vector<GLuint>& indices);
+	void GeneratePyramid4(std::vector<MESH_VERTEX>& vertices, std::vector<GLuint>& indices);
+
+public:
+	// generate and load all of the basic shape meshes
+	void LoadMeshes();
+	// free the loaded meshes
+	void DestroyMeshes();
+
+	// free every level of a mesh, packing the shared buffers
+	// when too much of them is lost in gaps
+	void UnloadMesh(MESH_KIND mesh);
+	// get the number that changes whenever the meshes move in
+	// the shared buffers, which makes their commands stale
+	int GetBufferVersion() const;
+
+	// start and end the draw data of a frame - every record
+	// must be written and drawn between the two calls
+	void BeginFrame();
+	void EndFrame();
+	// write records into the draw data of the current frame,
+	// returning the index of the first one, or -1 on failure
+	int WriteDrawData(const INSTANCE_DATA* instances, int instanceCount);
+	// draw one copy of the mesh for each of the passed in
+	// records that were written in the current frame
+	void DrawRecords(MESH_KIND mesh, int lod, int firstRecord, int recordCount);
+	// queue the same draw as DrawRecords() for the next
+	// multi-draw submission instead of drawing it now
+	void QueueRecords(MESH_KIND mesh, int lod, int firstRecord, int recordCount);
+	// draw every queued draw with one multi-draw-indirect call,
+	// returning the number of submitted commands
+	int SubmitQueuedRecords();
+
+	// get the command drawing no copies of a mesh yet, for
+	// commands that are filled in on the GPU
+	bool GetIndirectCommand(MESH_KIND mesh, int lod, INDIRECT_COMMAND& command) const;
+	// set the buffer of records read by DrawIndirect()
+	void SetIndirectRecordBuffer(GLuint recordBuffer);
+	// draw a range of commands from a command buffer, reading
+	// the records from the indirect record buffer
+	void DrawIndirect(GLuint commandBuffer, int firstCommand, int commandCount);
+
+	// draw every passed in instance of the mesh with one call
+	void DrawInstanced(
+		MESH_KIND mesh,
+		int lod,
+		const INSTANCE_DATA* instances,
+		int instanceCount);
+	// draw one copy of the mesh with the passed in draw data
+	void DrawSingle(MESH_KIND mesh, int lod, const INSTANCE_DATA& instance);
+
+	// get the object space bounds of a mesh
+	void GetLocalBounds(
+		MESH_KIND mesh,
+		glm::vec3& minimum,
+		glm::vec3& maximum) const;
+
+	// get the number of levels of detail of a mesh
+	int GetLodCount(MESH_KIND mesh) const;
+	// get the number of triangles of one level of a mesh
+	int GetTriangleCount(MESH_KIND mesh, int lod) const;
+
+	// get and reset the number of draw calls, and of the
+	// indirect commands submitted by them
+	int GetDrawCallCount() const;
+	int GetIndirectCommandCount() const;
+	void ResetDrawCallCount();
+	// get the bytes of draw data written since the last reset,
+	// and the number of frames that waited for the GPU
+	int GetDrawDataBytes() const;
+	int GetDrawDataStallCount() const;
+	void ResetDrawDataStats();
+};
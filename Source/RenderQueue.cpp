@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.cpp
+// ============
+// collect and sort the draw commands of a rendered frame
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+// declaration of global variables
+namespace
+{
+	// number of bits used by each field of the sort key
+	const int g_ShaderBits = 4;
+	const int g_TextureBits = 12;
+	const int g_MaterialBits = 12;
+	const int g_MeshBits = 12;
+	const int g_DepthBits = 24;
+
+	// position of each field, counted from the lowest bit
+	const int g_DepthShift = 0;
+	const int g_MeshShift = g_DepthShift + g_DepthBits;
+	const int g_MaterialShift = g_MeshShift + g_MeshBits;
+	const int g_TextureShift = g_MaterialShift + g_MaterialBits;
+	const int g_ShaderShift = g_TextureShift + g_TextureBits;
+
+	// keep a value within the number of bits of its field
+	uint64_t PackField(int value, int bits)
+	{
+		uint64_t maxValue = (1ull << bits) - 1;
+		if (value < 0)
+		{
+			return(0);
+		}
+		return(std::min((uint64_t)value, maxValue));
+	}
+
+	// compare two draw commands by their keys
+	bool CompareCommands(
+		const RenderQueue::DRAW_COMMAND& a,
+		const RenderQueue::DRAW_COMMAND& b)
+	{
+		return(a.sortKey < b.sortKey);
+	}
+}
+
+/***********************************************************
+ *  RenderQueue()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RenderQueue::RenderQueue()
+{
+}
+
+/***********************************************************
+ *  ~RenderQueue()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+RenderQueue::~RenderQueue()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  MakeSortKey()
+ *
+ *  This method is used for packing the draw state into a
+ *  64-bit sort key.  The texture slot and material index are
+ *  shifted up by one so that "none" (-1) sorts first, and the
+ *  depth is quantized over the range from 0 to maxDepth.
+ ***********************************************************/
+uint64_t RenderQueue::MakeSortKey(
+	int shaderMode,
+	int textureSlot,
+	int materialIndex,
+	int meshKind,
+	float depth,
+	float maxDepth)
+{
+	uint64_t key = 0;
+	uint64_t depthSteps = (1ull << g_DepthBits) - 1;
+	float normalizedDepth = 0.0f;
+
+	if (maxDepth > 0.0f)
+	{
+		normalizedDepth = std::min(std::max(depth / maxDepth, 0.0f), 1.0f);
+	}
+
+	key |= PackField(shaderMode, g_ShaderBits) << g_ShaderShift;
+	key |= PackField(textureSlot + 1, g_TextureBits) << g_TextureShift;
+	key |= PackField(materialIndex + 1, g_MaterialBits) << g_MaterialShift;
+	key |= PackField(meshKind, g_MeshBits) << g_MeshShift;
+	key |= (uint64_t)(normalizedDepth * depthSteps) << g_DepthShift;
+
+	return(key);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the draw commands.
+ *  The memory is kept so the next frame does not allocate.
+ ***********************************************************/
+void RenderQueue::Clear()
+{
+	m_commands.clear();
+}
+
+/***********************************************************
+ *  Submit()
+ *
+ *  This method is used for adding a draw command to the queue.
+ ***********************************************************/
+void RenderQueue::Submit(uint64_t sortKey, int index, bool bInstanced)
+{
+	DRAW_COMMAND command;
+
+	command.sortKey = sortKey;
+	command.index = index;
+	command.bInstanced = bInstanced;
+
+	m_commands.push_back(command);
+}
+
+/***********************************************************
+ *  Sort()
+ *
+ *  This method is used for sorting the draw commands by their
+ *  keys, so that draws sharing the same state are adjacent.
+ ***********************************************************/
+void RenderQueue::Sort()
+{
+	std::sort(m_commands.begin(), m_commands.end(), CompareCommands);
+}
+
+/***********************************************************
+ *  GetCommands()
+ *
+ *  This method is used for getting the sorted draw commands.
+ ***********************************************************/
+const std::vector<RenderQueue::DRAW_COMMAND>& RenderQueue::GetCommands() const
+{
+	return(m_commands);
+}
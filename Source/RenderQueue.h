@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.h
+// ============
+// collect and sort the draw commands of a rendered frame
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/***********************************************************
+ *  RenderQueue
+ *
+ *  This class collects the draw commands for a frame and
+ *  sorts them by a packed 64-bit key.  From the highest bits
+ *  to the lowest, the key holds the shader mode, texture
+ *  slot, material, mesh and depth, so draws that share the
+ *  same state end up next to each other and, within the same
+ *  state, the closest objects are drawn first.
+ ***********************************************************/
+class RenderQueue
+{
+public:
+	// constructor
+	RenderQueue();
+	// destructor
+	~RenderQueue();
+
+	struct DRAW_COMMAND
+	{
+		uint64_t sortKey;
+		// index of the render item, or of the instance batch
+		int index;
+		// true when the index refers to an instance batch
+		bool bInstanced;
+	};
+
+private:
+	// draw commands of the current frame
+	std::vector<DRAW_COMMAND> m_commands;
+
+public:
+	// pack the draw state into a sort key
+	static uint64_t MakeSortKey(
+		int shaderMode,
+		int textureSlot,
+		int materialIndex,
+		int meshKind,
+		float depth,
+		float maxDepth);
+
+	// remove all the draw commands
+	void Clear();
+	// add a draw command to the queue
+	void Submit(uint64_t sortKey, int index, bool bInstanced);
+	// sort the draw commands by their keys
+	void Sort();
+
+	// get the sorted draw commands
+	const std::vector<DRAW_COMMAND>& GetCommands() const;
+};
@@ -0,0 +1,248 @@
+///////////////////////////////////////////////////////////////////////////////
+// ringbuffer.cpp
+// ============
+// stream per-frame data to the GPU through a persistently mapped buffer
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RingBuffer.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// nanoseconds a single wait for a fence may take before it is
+	// tried again
+	const GLuint64 g_FenceWaitTimeout = 1000000;
+}
+
+/***********************************************************
+ *  RingBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RingBuffer::RingBuffer()
+{
+	m_buffer = 0;
+	m_pMapped = NULL;
+	m_frameSize = 0;
+	m_currentFrame = 0;
+	m_frameOffset = 0;
+	m_stallCount = 0;
+
+	for (int frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		m_fences[frame] = 0;
+	}
+}
+
+/***********************************************************
+ *  ~RingBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+RingBuffer::~RingBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the buffer with one region
+ *  of the passed in size for each frame in flight, and mapping
+ *  it for good.  The mapping is coherent, so the written data
+ *  reaches the GPU without flushing it.
+ ***********************************************************/
+bool RingBuffer::Create(GLsizeiptr frameSize)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	Destroy();
+
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+	glBufferStorage(GL_ARRAY_BUFFER, frameSize * FRAME_COUNT, NULL, flags);
+	m_pMapped = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, frameSize * FRAME_COUNT, flags);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (NULL == m_pMapped)
+	{
+		std::cout << "Could not map the ring buffer of " << frameSize * FRAME_COUNT << " bytes" << std::endl;
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+		return(false);
+	}
+
+	m_frameSize = frameSize;
+	m_currentFrame = 0;
+	m_frameOffset = 0;
+
+	return(true);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for waiting until the GPU is done with
+ *  every region, and then freeing the buffer.
+ ***********************************************************/
+void RingBuffer::Destroy()
+{
+	for (int frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		WaitForRegion(frame);
+	}
+
+	if (m_buffer != 0)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0;
+	}
+	m_pMapped = NULL;
+	m_frameSize = 0;
+	m_frameOffset = 0;
+}
+
+/***********************************************************
+ *  GetBuffer()
+ *
+ *  This method is used for getting the buffer, for binding it
+ *  as a source of draw data.
+ ***********************************************************/
+GLuint RingBuffer::GetBuffer() const
+{
+	return(m_buffer);
+}
+
+/***********************************************************
+ *  GetFrameSize()
+ *
+ *  This method is used for getting the size in bytes of the
+ *  region of each frame.
+ ***********************************************************/
+GLsizeiptr RingBuffer::GetFrameSize() const
+{
+	return(m_frameSize);
+}
+
+/***********************************************************
+ *  WaitForRegion()
+ *
+ *  This method is used for waiting until the GPU has passed
+ *  the fence of a region, and freeing the fence.  The first
+ *  check does not wait at all, so a wait that is needed is
+ *  counted as a stall.
+ ***********************************************************/
+void RingBuffer::WaitForRegion(int frame)
+{
+	if (m_fences[frame] == 0)
+	{
+		return;
+	}
+
+	GLenum result = glClientWaitSync(m_fences[frame], 0, 0);
+	if ((result == GL_TIMEOUT_EXPIRED) || (result == GL_WAIT_FAILED))
+	{
+		m_stallCount++;
+		do
+		{
+			result = glClientWaitSync(m_fences[frame], GL_SYNC_FLUSH_COMMANDS_BIT, g_FenceWaitTimeout);
+		} while (result == GL_TIMEOUT_EXPIRED);
+	}
+
+	glDeleteSync(m_fences[frame]);
+	m_fences[frame] = 0;
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for moving on to the region of the next
+ *  frame.  It was last used FRAME_COUNT frames ago, so the GPU
+ *  is normally done with it and there is no wait.
+ ***********************************************************/
+void RingBuffer::BeginFrame()
+{
+	m_currentFrame = (m_currentFrame + 1) % FRAME_COUNT;
+	m_frameOffset = 0;
+	WaitForRegion(m_currentFrame);
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for getting space in the region of the
+ *  current frame.  The space follows the previous space, so
+ *  all the data of a frame is written one after the other.
+ ***********************************************************/
+void* RingBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment, GLsizeiptr& bufferOffset)
+{
+	if (NULL == m_pMapped)
+	{
+		return(NULL);
+	}
+
+	GLsizeiptr offset = m_frameOffset;
+	if (alignment > 1)
+	{
+		offset = ((offset + alignment - 1) / alignment) * alignment;
+	}
+	if (offset + size > m_frameSize)
+	{
+		return(NULL);
+	}
+
+	m_frameOffset = offset + size;
+	bufferOffset = m_currentFrame * m_frameSize + offset;
+
+	return(m_pMapped + bufferOffset);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for placing a fence after the draws of
+ *  the current frame, which the GPU passes once it is done
+ *  reading the region of the frame.
+ ***********************************************************/
+void RingBuffer::EndFrame()
+{
+	if (m_buffer == 0)
+	{
+		return;
+	}
+
+	if (m_fences[m_currentFrame] != 0)
+	{
+		glDeleteSync(m_fences[m_currentFrame]);
+	}
+	m_fences[m_currentFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/***********************************************************
+ *  GetStallCount()
+ *
+ *  This method is used for getting the number of times a
+ *  region was still in use by the GPU when it was needed.
+ ***********************************************************/
+int RingBuffer::GetStallCount() const
+{
+	return(m_stallCount);
+}
+
+/***********************************************************
+ *  ResetStallCount()
+ *
+ *  This method is used for resetting the number of stalls.
+ ***********************************************************/
+void RingBuffer::ResetStallCount()
+{
+	m_stallCount = 0;
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+// ringbuffer.h
+// ============
+// stream per-frame data to the GPU through a persistently mapped buffer
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  RingBuffer
+ *
+ *  This class owns a buffer that stays mapped for its whole
+ *  life, split into one region for each frame in flight.  The
+ *  CPU writes the data of a frame straight into its region
+ *  with no OpenGL calls, while the GPU still reads the regions
+ *  of the previous frames.  A fence placed at the end of each
+ *  frame tells when the GPU is done with a region, so it is
+ *  only written again once it is free.
+ ***********************************************************/
+class RingBuffer
+{
+public:
+	// constructor
+	RingBuffer();
+	// destructor
+	~RingBuffer();
+
+	// number of frames whose regions can be in flight at once
+	static const int FRAME_COUNT = 3;
+
+private:
+	// the mapped buffer and the address it is mapped at
+	GLuint m_buffer;
+	unsigned char* m_pMapped;
+	// size in bytes of the region of each frame
+	GLsizeiptr m_frameSize;
+	// region written during the current frame
+	int m_currentFrame;
+	// bytes of the current region already handed out
+	GLsizeiptr m_frameOffset;
+	// fence placed after the last use of each region
+	GLsync m_fences[FRAME_COUNT];
+	// number of times a region was still in use by the GPU
+	int m_stallCount;
+
+	// wait until the GPU is done with a region
+	void WaitForRegion(int frame);
+
+public:
+	// create the buffer with the passed in size for each frame,
+	// replacing any existing buffer
+	bool Create(GLsizeiptr frameSize);
+	// wait for the GPU to finish every region and free the buffer
+	void Destroy();
+
+	// get the buffer, for binding it as a source of draw data
+	GLuint GetBuffer() const;
+	// get the size in bytes of the region of each frame
+	GLsizeiptr GetFrameSize() const;
+
+	// move on to the next region, waiting until the GPU is done
+	// reading it
+	void BeginFrame();
+	// get space for the passed in number of bytes in the region
+	// of the current frame, returning NULL when the region is
+	// full - the offset of the space in the buffer is returned
+	// through bufferOffset
+	void* Allocate(GLsizeiptr size, GLsizeiptr alignment, GLsizeiptr& bufferOffset);
+	// mark the region of the current frame as in use by the GPU
+	void EndFrame();
+
+	// get and reset the number of frames that had to wait
+	int GetStallCount() const;
+	void ResetStallCount();
+};
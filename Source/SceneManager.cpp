@@ -16,6 +16,10 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <chrono>
+#include <cmath>
+#include <random>
+
 // declaration of global variables
 namespace
 {
@@ -24,6 +28,62 @@ namespace
 	const char* g_TextureValueName = "objectTexture";
 	const char* g_UseTextureName = "bUseTexture";
 	const char* g_UseLightingName = "bUseLighting";
+	const char* g_UseInstancingName = "bUseInstancing";
+
+	// objects that share a mesh and surface are drawn with one
+	// instanced draw call once there are at least this many
+	const int g_MinimumInstanceCount = 2;
+
+	// shader modes used in the draw command sort keys
+	const int g_ShaderModeSingle = 0;
+	const int g_ShaderModeInstanced = 1;
+
+	// the material buffer is bound to this uniform block binding,
+	// and holds up to the number of materials the shader declares
+	const GLuint g_MaterialBlockBinding = 1;
+	const int g_MaxMaterials = 256;
+
+	// directory holding the compressed copies of the textures
+	const char* g_TextureCacheDirectory = "texture_cache";
+	// compute shader culling the instanced objects on the GPU
+	const char* g_CullingShaderName = "Source/shaders/cullingShader.glsl";
+	// farthest camera distance represented in the sort keys,
+	// which matches the far plane of the projection
+	const float g_MaxSortDepth = 100.0f;
+	// the bounds of an item are not queried when the camera is
+	// this close to them, since the near plane would clip the box
+	const float g_OcclusionCameraMargin = 0.5f;
+
+	// a curved object drops to the next level of detail once
+	// its bounds cover less than this fraction of the screen
+	// height, and the level only changes again after the size
+	// has moved past the threshold by the hysteresis fraction,
+	// so objects near a threshold do not pop back and forth
+	const float g_LodScreenSizes[PrimitiveMeshes::LOD_COUNT - 1] = { 0.25f, 0.08f };
+	const float g_LodHysteresis = 0.15f;
+
+	// the directional light at this index of the scene lights
+	// casts the shadows, matching the fragment shader
+	const int g_ShadowLightIndex = 0;
+	// shadow map size and cascade count used until other
+	// settings are requested
+	const int g_DefaultShadowResolution = 2048;
+	const int g_DefaultShadowCascades = 3;
+
+	// get the level of detail for a screen size, with the
+	// thresholds scaled by the passed in factor
+	int LodForScreenSize(float screenSize, float thresholdScale)
+	{
+		for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT - 1; lod++)
+		{
+			if (screenSize >= g_LodScreenSizes[lod] * thresholdScale)
+			{
+				return(lod);
+			}
+		}
+
+		return(PrimitiveMeshes::LOD_COUNT - 1);
+	}
 }
 
 /***********************************************************
@@ -34,15 +94,45 @@ namespace
 SceneManager::SceneManager(ShaderManager *pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-
-	// initialize the texture collection
-	for (int i = 0; i < 16; i++)
+	m_pViewManager = NULL;
+	m_pFrameProfiler = NULL;
+	m_pUniformCache = NULL;
+	m_primitiveMeshes = new PrimitiveMeshes();
+	m_bInstancesChanged = true;
+	m_materialBuffer = 0;
+	m_renderStats.drawCalls = 0;
+	m_renderStats.stateChanges = 0;
+	m_renderStats.stateChangesSkipped = 0;
+	m_renderStats.culledItems = 0;
+	m_renderStats.occludedItems = 0;
+	for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
 	{
-		m_textureIDs[i].tag = "/0";
-		m_textureIDs[i].ID = -1;
+		m_renderStats.lodItems[lod] = 0;
+		m_renderStats.lodTriangles[lod] = 0;
 	}
-	m_loadedTextures = 0;
+	m_renderStats.pointLights = 0;
+	m_renderStats.lightAssignments = 0;
+	m_renderStats.lightBytesUploaded = 0;
+	m_renderStats.shadowCasters = 0;
+	m_renderStats.shadowDrawCalls = 0;
+	m_renderStats.shadowPassCpuMs = 0.0f;
+	m_renderStats.shadowPassGpuMs = 0.0f;
+	m_renderStats.drawDataBytes = 0;
+	m_renderStats.drawDataStalls = 0;
+	m_renderStats.indirectCommands = 0;
+	m_bOcclusionActive = false;
+	m_yardLampCount = 0;
+	m_generatedObjectCount = 0;
+	m_shadowResolution = g_DefaultShadowResolution;
+	m_shadowCascadeCount = g_DefaultShadowCascades;
+	m_sceneBounds.minimum = glm::vec3(0.0f);
+	m_sceneBounds.maximum = glm::vec3(0.0f);
+	m_shaderState.bValid = false;
+	m_residentTextureUnits = 0;
+	m_bUseTextureArrays = false;
+	m_bUseMultiDraw = false;
+	m_bUseGpuCulling = false;
+	m_cullingBufferVersion = 0;
 }
 
 /***********************************************************
@@ -54,14 +144,32 @@ SceneManager::~SceneManager()
 {
 	// clear all the allocated memory
 	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
+	m_pViewManager = NULL;
+	m_pFrameProfiler = NULL;
+	m_pUniformCache = NULL;
+	delete m_primitiveMeshes;
+	m_primitiveMeshes = NULL;
 
 	// destroy the created OpenGL textures
 	DestroyGLTextures();
 
 	// clear the collection of defined materials
 	m_objectMaterials.clear();
+	m_materialIndices.clear();
+	if (m_materialBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_materialBuffer);
+		m_materialBuffer = 0;
+	}
+	// clear the retained scene objects
+	m_renderItems.clear();
+	m_instanceBatches.clear();
+	m_transforms.Clear();
+	m_boundingVolumes.Clear();
+	m_occlusionQueries.Destroy();
+	m_clusteredLighting.Destroy();
+	m_lightManager.Destroy();
+	m_shadowCascades.Destroy();
 }
 
 /***********************************************************
@@ -72,12 +180,11 @@ SceneManager::~SceneManager()
  *  generating the mipmaps, and loading the read texture into
  *  the next available texture slot in memory.
  ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+bool SceneManager::CreateGLTexture(const char* filename, const std::string& tag)
 {
 	int width = 0;
 	int height = 0;
 	int colorChannels = 0;
-	GLuint textureID = 0;
 
 	// indicate to always flip images vertically when loaded
 	stbi_set_flip_vertically_on_load(true);
@@ -93,292 +200,1779 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 	// if the image was successfully read from the image file
 	if (image)
 	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
+		bool bReturn = UploadGLTexture(filename, image, width, height, colorChannels, tag, "");
+
+		// free the image data from local memory
+		stbi_image_free(image);
+
+		return bReturn;
+	}
+
+	std::cout << "Could not load image:" << filename << std::endl;
+
+	// Error loading the image
+	return false;
+}
+
+/***********************************************************
+ *  UploadGLTexture()
+ *
+ *  This method is used for creating an OpenGL texture from
+ *  already decoded image data, streaming the pixels through
+ *  the pixel buffer of the texture loader, and registering
+ *  the texture under the passed in tag.  The image data is
+ *  not freed here.  When a cache path is passed in, the
+ *  texture is compressed by the driver and written, with its
+ *  mipmaps, to the cache file for the next run.
+ ***********************************************************/
+bool SceneManager::UploadGLTexture(
+	const char* filename,
+	const unsigned char* image,
+	int width,
+	int height,
+	int colorChannels,
+	const std::string& tag,
+	const std::string& cachePath)
+{
+	// every tag names exactly one texture slot
+	if (m_textureSlots.find(tag) != m_textureSlots.end())
+	{
+		std::cout << "Texture tag is already loaded:" << tag << std::endl;
+		return false;
+	}
+
+	std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
+
+	// the texture arrays keep the image until all the textures
+	// are loaded, and create the OpenGL textures themselves
+	if (m_bUseTextureArrays == true)
+	{
+		int textureIndex = m_textureArrays.AddImage(image, width, height, colorChannels);
+		if (textureIndex < 0)
+		{
+			return false;
+		}
+
+		RegisterGLTexture(0, tag);
+
+		return true;
+	}
+
+	if ((colorChannels != 3) && (colorChannels != 4))
+	{
+		std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
+		return false;
+	}
+
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - the generated mipmaps
+	// are sampled the same way as those of the texture arrays
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// the pixels are read from the bound pixel buffer at offset 0
+	m_textureLoader.StagePixels(image, (size_t)width * height * colorChannels);
+
+	// if the loaded image is in RGB format
+	if (colorChannels == 3)
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+	// if the loaded image is in RGBA format - it supports transparency
+	else
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+	m_textureLoader.EndStaging();
+
+	// generate the texture mipmaps for mapping textures to lower resolutions
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	// compress the uploaded levels and store them so later
+	// runs skip the decoding
+	if (cachePath.empty() == false)
+	{
+		if (TextureCache::CompressBoundTexture(colorChannels) == true)
+		{
+			TextureCache::WriteBoundTexture(cachePath);
+		}
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	// register the loaded texture and associate it with the special tag string
+	RegisterGLTexture(textureID, tag);
+
+	return true;
+}
+
+/***********************************************************
+ *  UploadCachedTexture()
+ *
+ *  This method is used for creating an OpenGL texture from a
+ *  memory-mapped texture cache file.  The compressed levels
+ *  are uploaded as they are, including the mipmaps, so nothing
+ *  is decoded or generated.
+ ***********************************************************/
+bool SceneManager::UploadCachedTexture(
+	const char* filename,
+	const TextureCache* pCachedTexture,
+	const std::string& tag)
+{
+	// every tag names exactly one texture slot
+	if (m_textureSlots.find(tag) != m_textureSlots.end())
+	{
+		std::cout << "Texture tag is already loaded:" << tag << std::endl;
+		return false;
+	}
 
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
+	std::cout << "Successfully loaded cached image:" << filename << ", width:" << pCachedTexture->GetWidth() << ", height:" << pCachedTexture->GetHeight() << std::endl;
 
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - the cached mipmaps are
+	// sampled the same way as the generated ones
+	if (pCachedTexture->GetLevelCount() > 1)
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	}
+	else
+	{
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	pCachedTexture->UploadLevels();
+
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	RegisterGLTexture(textureID, tag);
+
+	return true;
+}
+
+/***********************************************************
+ *  RegisterGLTexture()
+ *
+ *  This method is used for registering a created texture in
+ *  the next texture slot and associating it with its tag.
+ ***********************************************************/
+void SceneManager::RegisterGLTexture(GLuint textureID, const std::string& tag)
+{
+	TEXTURE_INFO texture;
+	texture.ID = textureID;
+	texture.tag = tag;
+	m_textureSlots[tag] = (int)m_textureIDs.size();
+	m_textureIDs.push_back(texture);
+}
+
+/***********************************************************
+ *  LoadQueuedTextures()
+ *
+ *  This method is used for loading every texture file added
+ *  to the texture loader.  The files are decoded in parallel
+ *  on the worker threads while this thread uploads each image
+ *  as soon as it is decoded, so loading takes about as long as
+ *  the slowest single file.  Files found in the compressed
+ *  texture cache are not decoded at all.  The timing is
+ *  reported once all of the textures are loaded.
+ ***********************************************************/
+void SceneManager::LoadQueuedTextures()
+{
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.LoadTextures");
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	TextureLoader::DECODED_IMAGE image;
+	double slowestDecode = 0.0;
+	double totalDecode = 0.0;
+	int textureCount = 0;
+	int cachedCount = 0;
+
+	// the texture arrays need the decoded pixels, and the cache
+	// needs the driver to support the compressed formats
+	if ((m_bUseTextureArrays == false) &&
+		(glewIsSupported("GL_EXT_texture_compression_s3tc") == GL_TRUE))
+	{
+		m_textureLoader.SetCacheDirectory(g_TextureCacheDirectory);
+	}
+	else
+	{
+		m_textureLoader.SetCacheDirectory("");
+	}
+
+	m_textureLoader.Start();
+	while (m_textureLoader.GetNextImage(image) == true)
+	{
+		if (image.pCachedTexture)
+		{
+			UploadCachedTexture(image.filename.c_str(), image.pCachedTexture, image.tag);
+			cachedCount++;
+		}
+		else if (image.pixels)
+		{
+			UploadGLTexture(image.filename.c_str(), image.pixels, image.width, image.height, image.colorChannels, image.tag, image.cachePath);
+		}
 		else
 		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
+			std::cout << "Could not load image:" << image.filename << std::endl;
 		}
+		m_textureLoader.FreeImage(image);
 
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
+		if (image.decodeMilliseconds > slowestDecode)
+		{
+			slowestDecode = image.decodeMilliseconds;
+		}
+		totalDecode += image.decodeMilliseconds;
+		textureCount++;
+	}
+	m_textureLoader.Finish();
+	m_textureLoader.DestroyPixelBuffer();
 
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+	std::chrono::duration<double, std::milli> elapsed =
+		std::chrono::steady_clock::now() - start;
+	std::cout << "INFO: loaded " << textureCount << " textures (" << cachedCount << " from cache) in " << elapsed.count() << " ms"
+		<< " (slowest decode " << slowestDecode << " ms, all decodes " << totalDecode << " ms)" << std::endl;
+}
 
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the loaded textures to
+ *  OpenGL texture units.  Every texture slot keeps its own
+ *  unit while there are enough units, and the last unit is
+ *  kept free for the remaining slots, which are bound to it
+ *  when they are drawn.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	GLint textureUnits = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+	// the very last unit holds the shadow maps
+	textureUnits--;
+
+	// samplers of different types cannot share a texture unit, so
+	// unit 0 is left to objectTexture when the arrays are used,
+	// and the last unit is left to objectTextureArray otherwise
+	if (m_bUseTextureArrays == true)
+	{
+		bool bBuilt = m_textureArrays.BuildArrays(1);
+		if ((bBuilt == true) && (NULL != m_pUniformCache))
+		{
+			m_pUniformCache->SetBool("bUseTextureArray", true);
+			m_pUniformCache->SetInt(g_TextureValueName, 0);
+		}
+		return;
+	}
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->SetInt("objectTextureArray", textureUnits - 1);
+	}
 
-		return true;
+	m_residentTextureUnits = (int)m_textureIDs.size();
+	if (m_residentTextureUnits > textureUnits - 1)
+	{
+		m_residentTextureUnits = textureUnits - 2;
+	}
+
+	for (int i = 0; i < m_residentTextureUnits; i++)
+	{
+		// bind textures on corresponding texture units
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+	}
+}
+
+/***********************************************************
+ *  BindTextureSlot()
+ *
+ *  This method is used for getting the texture unit that a
+ *  texture slot is bound to.  A slot without its own unit is
+ *  first bound to the shared last unit.
+ ***********************************************************/
+int SceneManager::BindTextureSlot(int textureSlot)
+{
+	if ((textureSlot < 0) || (textureSlot < m_residentTextureUnits))
+	{
+		return(textureSlot);
+	}
+
+	glActiveTexture(GL_TEXTURE0 + m_residentTextureUnits);
+	glBindTexture(GL_TEXTURE_2D, m_textureIDs[textureSlot].ID);
+
+	return(m_residentTextureUnits);
+}
+
+/***********************************************************
+ *  ApplyTextureSlot()
+ *
+ *  This method is used for selecting a loaded texture in the
+ *  shader for the next draw, either by its texture unit or by
+ *  the unit and layer of its texture array.
+ ***********************************************************/
+void SceneManager::ApplyTextureSlot(int textureSlot)
+{
+	if ((NULL == m_pUniformCache) || (textureSlot < 0))
+	{
+		return;
+	}
+
+	if (m_bUseTextureArrays == true)
+	{
+		m_pUniformCache->SetInt(m_uniforms.objectTextureArray, m_textureArrays.GetTextureUnit(textureSlot));
+		m_pUniformCache->SetInt(m_uniforms.textureLayer, m_textureArrays.GetTextureLayer(textureSlot));
+	}
+	else
+	{
+		m_pUniformCache->SetInt(m_uniforms.objectTexture, BindTextureSlot(textureSlot));
+	}
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (size_t i = 0; i < m_textureIDs.size(); i++)
+	{
+		glDeleteTextures(1, &m_textureIDs[i].ID);
+	}
+	m_textureIDs.clear();
+	m_textureSlots.clear();
+	m_residentTextureUnits = 0;
+	m_textureArrays.DestroyArrays();
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(const std::string& tag)
+{
+	int textureSlot = FindTextureSlot(tag);
+
+	if (textureSlot < 0)
+	{
+		return(-1);
+	}
+
+	return(m_textureIDs[textureSlot].ID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const std::string& tag)
+{
+	std::unordered_map<std::string, int>::const_iterator it = m_textureSlots.find(tag);
+
+	if (it == m_textureSlots.end())
+	{
+		return(-1);
+	}
+
+	return(it->second);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(const std::string& tag, OBJECT_MATERIAL& material)
+{
+	int index = FindMaterialIndex(tag);
+
+	if (index < 0)
+	{
+		return(false);
+	}
+
+	material = m_objectMaterials[index];
+
+	return(true);
+}
+
+/***********************************************************
+ *  ComputeModelMatrix()
+ *
+ *  This method is used for calculating the model matrix
+ *  from the passed in transformation values.
+ ***********************************************************/
+glm::mat4 SceneManager::ComputeModelMatrix(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	return(TransformCache::ComputeMatrix(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ));
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform buffer
+ *  using the passed in transformation values.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 modelView;
+
+	modelView = ComputeModelMatrix(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setMat4Value(g_ModelName, modelView);
 	}
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, false);
+		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in ID into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	const std::string& textureTag)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, true);
+
+		ApplyTextureSlot(FindTextureSlot(textureTag));
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for selecting the material, from the
+ *  material buffer, that the shader uses for the next draw.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	const std::string& materialTag)
+{
+	int materialIndex = FindMaterialIndex(materialTag);
+
+	if (materialIndex >= 0)
+	{
+		ApplyMaterial(materialIndex);
+	}
+}
+
+/***********************************************************
+ *  ApplyMaterial()
+ *
+ *  This method is used for selecting an already resolved
+ *  material in the shader.  The material values themselves
+ *  are already in the material buffer.
+ ***********************************************************/
+void SceneManager::ApplyMaterial(
+	int materialIndex)
+{
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->SetInt(m_uniforms.materialIndex, materialIndex);
+	}
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the index of a previously
+ *  defined material that is associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const std::string& tag)
+{
+	std::unordered_map<std::string, int>::const_iterator it = m_materialIndices.find(tag);
+
+	if (it == m_materialIndices.end())
+	{
+		return(-1);
+	}
+
+	return(it->second);
+}
+
+/***********************************************************
+ *  IndexObjectMaterials()
+ *
+ *  This method is used for indexing the tags of the defined
+ *  materials, so that a material is found without comparing
+ *  it against every other tag.
+ ***********************************************************/
+void SceneManager::IndexObjectMaterials()
+{
+	m_materialIndices.clear();
+
+	for (size_t index = 0; index < m_objectMaterials.size(); index++)
+	{
+		// the first material defined with a tag is the one used
+		if (m_materialIndices.find(m_objectMaterials[index].tag) == m_materialIndices.end())
+		{
+			m_materialIndices[m_objectMaterials[index].tag] = (int)index;
+		}
+	}
+}
+
+/***********************************************************
+ *  AddRenderItem()
+ *
+ *  This method is used for registering an object in the
+ *  retained scene.  The model matrix, texture slot and
+ *  material index are resolved once, here, instead of on
+ *  every rendered frame.  An empty texture tag means the
+ *  object is drawn with its color.
+ ***********************************************************/
+int SceneManager::AddRenderItem(
+	MESH_KIND mesh,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ,
+	glm::vec4 color,
+	const std::string& textureTag,
+	const std::string& materialTag)
+{
+	RENDER_ITEM item;
+
+	item.mesh = mesh;
+	item.transformIndex = m_transforms.AddTransform(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	item.color = color;
+	item.textureSlot = -1;
+	if (textureTag.empty() == false)
+	{
+		item.textureSlot = FindTextureSlot(textureTag);
+	}
+	item.materialIndex = FindMaterialIndex(materialTag);
+	item.uvScale = glm::vec2(1.0f, 1.0f);
+	item.bInstanced = false;
+	item.bOccluder = false;
+	item.lod = 0;
+
+	m_renderItems.push_back(item);
+
+	return((int)m_renderItems.size() - 1);
+}
+
+/***********************************************************
+ *  AttachRenderItem()
+ *
+ *  This method is used for attaching a render item to a parent
+ *  render item, so that the child follows the parent whenever
+ *  the parent is moved.  The parent must be added first.
+ ***********************************************************/
+bool SceneManager::AttachRenderItem(int childItem, int parentItem)
+{
+	if ((childItem < 0) || (childItem >= (int)m_renderItems.size()) ||
+		(parentItem < 0) || (parentItem >= (int)m_renderItems.size()))
+	{
+		return(false);
+	}
+
+	return(m_transforms.SetParent(
+		m_renderItems[childItem].transformIndex,
+		m_renderItems[parentItem].transformIndex));
+}
+
+/***********************************************************
+ *  SetRenderItemOccluder()
+ *
+ *  This method is used for marking a render item as a large
+ *  occluder.  Occluders are drawn into the depth buffer before
+ *  the other items are tested against it, and are never drawn
+ *  with instancing so that both passes give the same depth.
+ ***********************************************************/
+void SceneManager::SetRenderItemOccluder(int item)
+{
+	if ((item < 0) || (item >= (int)m_renderItems.size()))
+	{
+		return;
+	}
+
+	m_renderItems[item].bOccluder = true;
+}
+
+/***********************************************************
+ *  BuildInstanceBatches()
+ *
+ *  This method is used for grouping the render items that
+ *  share a mesh and a surface, so that each group can be
+ *  drawn with a single instanced draw call.  Textured items
+ *  are grouped regardless of their color, since the color
+ *  is not used when a texture is applied.
+ ***********************************************************/
+void SceneManager::BuildInstanceBatches()
+{
+	m_instanceBatches.clear();
+
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		const RENDER_ITEM& item = m_renderItems[i];
+		bool bFound = false;
+		size_t index = 0;
+
+		if (item.bOccluder == true)
+		{
+			continue;
+		}
+
+		while ((index < m_instanceBatches.size()) && (bFound == false))
+		{
+			const INSTANCE_BATCH& batch = m_instanceBatches[index];
+
+			if ((batch.mesh == item.mesh) &&
+				(batch.textureSlot == item.textureSlot) &&
+				(batch.uvScale == item.uvScale) &&
+				((item.textureSlot >= 0) || (batch.color == item.color)))
+			{
+				bFound = true;
+			}
+			else
+			{
+				index++;
+			}
+		}
+
+		if (bFound == false)
+		{
+			INSTANCE_BATCH batch;
+			batch.mesh = item.mesh;
+			batch.color = item.color;
+			batch.textureSlot = item.textureSlot;
+			batch.uvScale = item.uvScale;
+			m_instanceBatches.push_back(batch);
+		}
+		m_instanceBatches[index].items.push_back((int)i);
+	}
+
+	// only the groups with enough objects are worth instancing,
+	// the rest are drawn one at a time
+	size_t batchIndex = 0;
+	while (batchIndex < m_instanceBatches.size())
+	{
+		INSTANCE_BATCH& batch = m_instanceBatches[batchIndex];
+
+		if ((int)batch.items.size() < g_MinimumInstanceCount)
+		{
+			m_instanceBatches.erase(m_instanceBatches.begin() + batchIndex);
+		}
+		else
+		{
+			for (size_t i = 0; i < batch.items.size(); i++)
+			{
+				m_renderItems[batch.items[i]].bInstanced = true;
+			}
+			batch.instances.resize(batch.items.size());
+			batchIndex++;
+		}
+	}
+
+	m_bInstancesChanged = true;
+}
+
+/***********************************************************
+ *  UnloadUnusedMeshes()
+ *
+ *  This method is used for freeing the meshes that none of
+ *  the defined render items draw, which packs the remaining
+ *  meshes together in the shared buffers once enough space
+ *  is freed.  The box is always kept, since the occlusion
+ *  queries draw it as the proxy of every tested item.
+ ***********************************************************/
+void SceneManager::UnloadUnusedMeshes()
+{
+	bool bMeshUsed[MESH_KIND_COUNT] = { false };
+
+	bMeshUsed[MESH_BOX] = true;
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		bMeshUsed[m_renderItems[i].mesh] = true;
+	}
+
+	for (int mesh = 0; mesh < MESH_KIND_COUNT; mesh++)
+	{
+		if (bMeshUsed[mesh] == false)
+		{
+			m_primitiveMeshes->UnloadMesh((MESH_KIND)mesh);
+		}
+	}
+}
+
+/***********************************************************
+ *  UpdateInstanceBatches()
+ *
+ *  This method is used for copying the cached model matrices
+ *  and the surface values into the instance data of each
+ *  group.
+ ***********************************************************/
+void SceneManager::UpdateInstanceBatches()
+{
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.UpdateInstances");
+	for (size_t b = 0; b < m_instanceBatches.size(); b++)
+	{
+		INSTANCE_BATCH& batch = m_instanceBatches[b];
+
+		for (size_t i = 0; i < batch.items.size(); i++)
+		{
+			GetItemDrawData(batch.items[i], batch.instances[i]);
+		}
+	}
+
+	if (m_bUseGpuCulling == true)
+	{
+		UploadGpuCullingObjects();
+	}
+
+	m_bInstancesChanged = false;
+}
+
+/***********************************************************
+ *  UploadGpuCullingObjects()
+ *
+ *  This method is used for sending the bounds and the draw
+ *  data of every instanced item to the compute culling.  Each
+ *  batch gets one indirect command for each level of detail,
+ *  and each command has room for every item of the batch, so
+ *  the shader never runs out of room whatever levels it picks.
+ ***********************************************************/
+void SceneManager::UploadGpuCullingObjects()
+{
+	std::vector<GpuCulling::CULL_OBJECT> objects;
+	std::vector<PrimitiveMeshes::INSTANCE_DATA> records;
+	std::vector<PrimitiveMeshes::INDIRECT_COMMAND> commands;
+	int visibleRecordCount = 0;
+
+	for (size_t b = 0; b < m_instanceBatches.size(); b++)
+	{
+		const INSTANCE_BATCH& batch = m_instanceBatches[b];
+		GLuint firstCommand = (GLuint)commands.size();
+
+		for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+		{
+			PrimitiveMeshes::INDIRECT_COMMAND command;
+			m_primitiveMeshes->GetIndirectCommand(batch.mesh, lod, command);
+			command.baseInstance = (GLuint)visibleRecordCount;
+			commands.push_back(command);
+			visibleRecordCount += (int)batch.items.size();
+		}
+
+		for (size_t i = 0; i < batch.items.size(); i++)
+		{
+			const RENDER_ITEM& item = m_renderItems[batch.items[i]];
+			const BOUNDING_BOX& bounds = m_itemBounds[batch.items[i]];
+			GpuCulling::CULL_OBJECT object;
+
+			object.center = glm::vec4((bounds.minimum + bounds.maximum) * 0.5f, 1.0f);
+			object.extent = glm::vec4((bounds.maximum - bounds.minimum) * 0.5f, 0.0f);
+			object.firstCommand = firstCommand;
+			object.lodCount = m_primitiveMeshes->GetLodCount(item.mesh);
+			object.lod = item.lod;
+			object.padding = 0;
+			objects.push_back(object);
+			records.push_back(batch.instances[i]);
+		}
+	}
+
+	m_gpuCulling.SetObjects(objects, records, commands, visibleRecordCount);
+	m_cullingBufferVersion = m_primitiveMeshes->GetBufferVersion();
+}
+
+/***********************************************************
+ *  GetItemDrawData()
+ *
+ *  This method is used for filling the draw data record of a
+ *  render item from its cached model matrix and its surface.
+ ***********************************************************/
+void SceneManager::GetItemDrawData(int item, PrimitiveMeshes::INSTANCE_DATA& instance) const
+{
+	const RENDER_ITEM& renderItem = m_renderItems[item];
+
+	instance.modelMatrix = m_transforms.GetWorldMatrix(renderItem.transformIndex);
+	instance.color = renderItem.color;
+	instance.uvScale = renderItem.uvScale;
+	instance.materialIndex = renderItem.materialIndex;
+	instance.padding = 0;
+}
+
+/***********************************************************
+ *  UpdateItemBounds()
+ *
+ *  This method is used for calculating the world space bounds
+ *  of every render item from the object space bounds of its
+ *  mesh.  The box is moved to the transformed center, and its
+ *  extent is grown by the absolute values of the matrix, which
+ *  gives the tightest box around the transformed box.
+ ***********************************************************/
+void SceneManager::UpdateItemBounds()
+{
+	m_itemBounds.resize(m_renderItems.size());
+
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		const RENDER_ITEM& item = m_renderItems[i];
+		const glm::mat4& world = m_transforms.GetWorldMatrix(item.transformIndex);
+		glm::vec3 localMinimum;
+		glm::vec3 localMaximum;
+
+		m_primitiveMeshes->GetLocalBounds(item.mesh, localMinimum, localMaximum);
+
+		glm::vec3 center = glm::vec3(world * glm::vec4((localMinimum + localMaximum) * 0.5f, 1.0f));
+		glm::vec3 localExtent = (localMaximum - localMinimum) * 0.5f;
+		glm::vec3 extent(0.0f);
+		for (int column = 0; column < 3; column++)
+		{
+			extent += glm::abs(glm::vec3(world[column])) * localExtent[column];
+		}
+
+		m_itemBounds[i].minimum = center - extent;
+		m_itemBounds[i].maximum = center + extent;
+
+		if (i == 0)
+		{
+			m_sceneBounds = m_itemBounds[i];
+		}
+		else
+		{
+			m_sceneBounds.minimum = glm::min(m_sceneBounds.minimum, m_itemBounds[i].minimum);
+			m_sceneBounds.maximum = glm::max(m_sceneBounds.maximum, m_itemBounds[i].maximum);
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildBoundingVolumes()
+ *
+ *  This method is used for building the bounding volume tree
+ *  over the render items, once the scene has been defined.
+ *  Moving objects later only refit the tree.
+ ***********************************************************/
+void SceneManager::BuildBoundingVolumes()
+{
+	m_transforms.UpdateTransforms();
+	UpdateItemBounds();
+	m_boundingVolumes.Build(m_itemBounds);
+	m_itemVisible.assign(m_renderItems.size(), 1);
+	m_occlusionQueries.Create((int)m_renderItems.size());
+}
+
+/***********************************************************
+ *  CullRenderItems()
+ *
+ *  This method is used for finding the render items that are
+ *  inside the view frustum of the camera.  Without a view
+ *  manager every item is treated as visible.
+ ***********************************************************/
+void SceneManager::CullRenderItems()
+{
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.Culling");
+	m_renderStats.culledItems = 0;
+
+	if (NULL == m_pViewManager)
+	{
+		m_itemVisible.assign(m_renderItems.size(), 1);
+		return;
+	}
+
+	m_frustum.ExtractPlanes(m_pViewManager->GetProjectionMatrix() * m_pViewManager->GetViewMatrix());
+
+	m_itemVisible.assign(m_renderItems.size(), 0);
+	if (m_bUseGpuCulling == true)
+	{
+		// the compute shader culls the instanced items, which
+		// are left out here, and only the single items are
+		// tested on the CPU - the commands hold the places of the
+		// meshes in the shared buffers, so they are built again
+		// whenever the meshes have moved
+		if (m_primitiveMeshes->GetBufferVersion() != m_cullingBufferVersion)
+		{
+			UploadGpuCullingObjects();
+		}
+		m_gpuCulling.Cull(
+			m_frustum,
+			m_pViewManager->GetProjectionMatrix(),
+			m_pViewManager->GetCameraPosition());
+
+		for (size_t i = 0; i < m_renderItems.size(); i++)
+		{
+			if (m_renderItems[i].bInstanced == true)
+			{
+				continue;
+			}
+			if (m_frustum.TestBox(m_itemBounds[i]) != Frustum::CULL_OUTSIDE)
+			{
+				m_itemVisible[i] = 1;
+			}
+			else
+			{
+				m_renderStats.culledItems++;
+			}
+		}
+		return;
+	}
+	m_boundingVolumes.Cull(m_frustum, m_itemVisible);
+
+	for (size_t i = 0; i < m_itemVisible.size(); i++)
+	{
+		if (m_itemVisible[i] == 0)
+		{
+			m_renderStats.culledItems++;
+		}
+	}
+}
+
+/***********************************************************
+ *  RenderOcclusionQueries()
+ *
+ *  This method is used for drawing the occluders inside the
+ *  view frustum into the depth buffer only, and then drawing
+ *  the bounds of every other visible item against it inside an
+ *  occlusion query.  The results are read on the next frame,
+ *  so the queries never make the CPU wait for the GPU.
+ ***********************************************************/
+void SceneManager::RenderOcclusionQueries()
+{
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.OcclusionQueries");
+	glm::vec3 cameraPosition = m_pViewManager->GetCameraPosition();
+
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+	// the occluders fill the depth buffer for the queries, and
+	// are drawn again with the same depth in the color pass
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		const RENDER_ITEM& item = m_renderItems[i];
+
+		if ((item.bOccluder == true) && (m_itemVisible[i] != 0))
+		{
+			PrimitiveMeshes::INSTANCE_DATA instance;
+			GetItemDrawData((int)i, instance);
+			m_primitiveMeshes->DrawSingle(item.mesh, item.lod, instance);
+		}
+	}
+
+	// the bounds proxies only test the depth buffer
+	glDepthMask(GL_FALSE);
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		const RENDER_ITEM& item = m_renderItems[i];
+
+		if ((item.bOccluder == true) || (m_itemVisible[i] == 0))
+		{
+			continue;
+		}
+
+		// a camera inside the bounds always sees the item
+		const BOUNDING_BOX& bounds = m_itemBounds[i];
+		glm::vec3 nearMinimum = bounds.minimum - glm::vec3(g_OcclusionCameraMargin);
+		glm::vec3 nearMaximum = bounds.maximum + glm::vec3(g_OcclusionCameraMargin);
+		if ((cameraPosition.x > nearMinimum.x) && (cameraPosition.x < nearMaximum.x) &&
+			(cameraPosition.y > nearMinimum.y) && (cameraPosition.y < nearMaximum.y) &&
+			(cameraPosition.z > nearMinimum.z) && (cameraPosition.z < nearMaximum.z))
+		{
+			continue;
+		}
+
+		m_occlusionQueries.BeginQuery((int)i);
+		DrawBoundsProxy(bounds);
+		m_occlusionQueries.EndQuery();
+	}
+	glDepthMask(GL_TRUE);
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+/***********************************************************
+ *  DrawBoundsProxy()
+ *
+ *  This method is used for drawing the box mesh stretched over
+ *  the passed in world space bounds.
+ ***********************************************************/
+void SceneManager::DrawBoundsProxy(const BOUNDING_BOX& bounds)
+{
+	glm::vec3 localMinimum;
+	glm::vec3 localMaximum;
+
+	m_primitiveMeshes->GetLocalBounds(MESH_BOX, localMinimum, localMaximum);
+
+	glm::vec3 scale = (bounds.maximum - bounds.minimum) / (localMaximum - localMinimum);
+	glm::vec3 offset = bounds.minimum - localMinimum * scale;
+
+	PrimitiveMeshes::INSTANCE_DATA instance;
+	instance.modelMatrix = glm::translate(offset) * glm::scale(scale);
+	instance.color = glm::vec4(1.0f);
+	instance.uvScale = glm::vec2(1.0f);
+	instance.materialIndex = 0;
+	instance.padding = 0;
+	m_primitiveMeshes->DrawSingle(MESH_BOX, 0, instance);
+}
+
+/***********************************************************
+ *  HideOccludedItems()
+ *
+ *  This method is used for leaving the render items that were
+ *  hidden in the last occlusion results out of this frame.
+ *  An item hidden for a frame is still queried every frame,
+ *  so it is drawn again one frame after it comes into view.
+ ***********************************************************/
+void SceneManager::HideOccludedItems()
+{
+	m_renderStats.occludedItems = 0;
+
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		if ((m_itemVisible[i] != 0) && (m_occlusionQueries.IsOccluded((int)i) == true))
+		{
+			m_itemVisible[i] = 0;
+			m_renderStats.occludedItems++;
+		}
+	}
+}
+
+/***********************************************************
+ *  SelectItemLods()
+ *
+ *  This method is used for choosing the level of detail of
+ *  every visible render item from the size of its bounds on
+ *  screen.  The size is the projected radius of the bounds
+ *  as a fraction of the screen height, which shrinks with the
+ *  distance from the camera under a perspective projection.
+ ***********************************************************/
+void SceneManager::SelectItemLods()
+{
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.SelectLods");
+	if (NULL == m_pViewManager)
+	{
+		return;
+	}
+
+	glm::mat4 projection = m_pViewManager->GetProjectionMatrix();
+	glm::vec3 cameraPosition = m_pViewManager->GetCameraPosition();
+	// only a perspective projection divides by the distance
+	bool bPerspective = (projection[2][3] != 0.0f);
+
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		RENDER_ITEM& item = m_renderItems[i];
+
+		if ((m_itemVisible[i] == 0) || (m_primitiveMeshes->GetLodCount(item.mesh) <= 1))
+		{
+			continue;
+		}
+
+		glm::vec3 center = (m_itemBounds[i].minimum + m_itemBounds[i].maximum) * 0.5f;
+		float radius = glm::length(m_itemBounds[i].maximum - center);
+		float screenSize = radius * projection[1][1];
+		if (bPerspective == true)
+		{
+			screenSize = screenSize / glm::max(glm::distance(cameraPosition, center), 0.001f);
+		}
+
+		// a finer level needs a size well above its threshold,
+		// and a coarser level a size well below it
+		int finerLod = LodForScreenSize(screenSize, 1.0f + g_LodHysteresis);
+		int coarserLod = LodForScreenSize(screenSize, 1.0f - g_LodHysteresis);
+		if (finerLod < item.lod)
+		{
+			item.lod = finerLod;
+		}
+		else if (coarserLod > item.lod)
+		{
+			item.lod = coarserLod;
+		}
+
+		if (item.lod >= m_primitiveMeshes->GetLodCount(item.mesh))
+		{
+			item.lod = m_primitiveMeshes->GetLodCount(item.mesh) - 1;
+		}
+	}
+}
+
+/***********************************************************
+ *  RenderShadowPass()
+ *
+ *  This method is used for fitting the shadow cascades to the
+ *  current view and drawing the shadow casters of each one
+ *  into its shadow map.  Only depth is written, so lighting
+ *  and textures are switched off in the shader for the pass.
+ ***********************************************************/
+void SceneManager::RenderShadowPass()
+{
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.ShadowPass");
+	m_renderStats.shadowCasters = 0;
+	m_renderStats.shadowDrawCalls = 0;
+	m_renderStats.shadowPassCpuMs = 0.0f;
+
+	// the shadow maps are created again after the settings change
+	if ((m_shadowCascades.GetCascadeCount() != m_shadowCascadeCount) ||
+		((m_shadowCascadeCount > 0) && (m_shadowCascades.GetResolution() != m_shadowResolution)))
+	{
+		m_shadowCascades.Create(m_shadowResolution, m_shadowCascadeCount);
+		// settings the shadow maps could not be created with
+		// are dropped, so they are not tried on every frame
+		m_shadowCascadeCount = m_shadowCascades.GetCascadeCount();
+	}
+
+	LightManager::LIGHT_SOURCE light;
+	if ((NULL == m_pViewManager) || (m_shadowCascades.GetCascadeCount() == 0) ||
+		(m_lightManager.GetLight(g_ShadowLightIndex, light) == false) ||
+		(light.type != LightManager::LIGHT_DIRECTIONAL))
+	{
+		m_shadowCascades.Disable();
+		m_renderStats.shadowPassGpuMs = 0.0f;
+		return;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	m_shadowCascades.Update(
+		m_pViewManager->GetViewMatrix(),
+		m_pViewManager->GetProjectionMatrix(),
+		light.direction,
+		m_sceneBounds);
+
+	m_pUniformCache->SetBool(m_uniforms.useLighting, false);
+	m_pUniformCache->SetBool(m_uniforms.useTexture, false);
+
+	m_shadowCascades.BeginPass();
+	for (int cascade = 0; cascade < m_shadowCascades.GetCascadeCount(); cascade++)
+	{
+		m_shadowCascades.BeginCascade(cascade);
+		m_pUniformCache->SetMat4(m_uniforms.view, m_shadowCascades.GetLightView(cascade));
+		m_pUniformCache->SetMat4(m_uniforms.projection, m_shadowCascades.GetLightProjection(cascade));
+		RenderShadowCascade(cascade);
+	}
+	m_shadowCascades.EndPass();
+
+	// the camera view and the surface values are set back
+	m_pUniformCache->SetMat4(m_uniforms.view, m_pViewManager->GetViewMatrix());
+	m_pUniformCache->SetMat4(m_uniforms.projection, m_pViewManager->GetProjectionMatrix());
+	m_pUniformCache->SetBool(m_uniforms.useLighting, true);
+	m_shaderState.bValid = false;
+
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	m_renderStats.shadowPassCpuMs = elapsed.count();
+	m_renderStats.shadowPassGpuMs = m_shadowCascades.GetPassMilliseconds();
+}
+
+/***********************************************************
+ *  RenderShadowCascade()
+ *
+ *  This method is used for drawing the render items that can
+ *  cast a shadow into one cascade.  The items are culled
+ *  against the volume the cascade sees, which reaches back to
+ *  the light, so an item outside of the camera view still
+ *  casts when its shadow falls into the view.
+ ***********************************************************/
+void SceneManager::RenderShadowCascade(int cascade)
+{
+	m_shadowCasters.assign(m_renderItems.size(), 0);
+	m_boundingVolumes.Cull(m_shadowCascades.GetCascadeFrustum(cascade), m_shadowCasters);
+	int firstDrawCall = m_primitiveMeshes->GetDrawCallCount();
+
+	for (size_t i = 0; i < m_renderItems.size(); i++)
+	{
+		const RENDER_ITEM& item = m_renderItems[i];
+
+		if ((item.bInstanced == false) && (m_shadowCasters[i] != 0))
+		{
+			PrimitiveMeshes::INSTANCE_DATA instance;
+			GetItemDrawData((int)i, instance);
+			DrawItemRecords(item.mesh, item.lod, &instance, 1);
+			m_renderStats.shadowCasters++;
+		}
+	}
+
+	// the instance batches only draw their casting instances
+	for (size_t b = 0; b < m_instanceBatches.size(); b++)
+	{
+		const INSTANCE_BATCH& batch = m_instanceBatches[b];
+
+		for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+		{
+			m_visibleInstances[lod].clear();
+		}
+		for (size_t j = 0; j < batch.items.size(); j++)
+		{
+			if (m_shadowCasters[batch.items[j]] != 0)
+			{
+				m_visibleInstances[m_renderItems[batch.items[j]].lod].push_back(batch.instances[j]);
+			}
+		}
+
+		for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+		{
+			int instanceCount = (int)m_visibleInstances[lod].size();
+
+			if (instanceCount > 0)
+			{
+				DrawItemRecords(batch.mesh, lod, m_visibleInstances[lod].data(), instanceCount);
+				m_renderStats.shadowCasters += instanceCount;
+			}
+		}
+	}
+
+	// the queued casters are drawn before the next cascade is
+	// bound
+	m_primitiveMeshes->SubmitQueuedRecords();
+	m_renderStats.shadowDrawCalls += m_primitiveMeshes->GetDrawCallCount() - firstDrawCall;
+}
+
+/***********************************************************
+ *  DrawItemRecords()
+ *
+ *  This method is used for writing the draw data of one or
+ *  more copies of a mesh, and drawing them right away, or
+ *  queueing them for a single multi-draw submission when
+ *  multi-draw is enabled.
+ ***********************************************************/
+void SceneManager::DrawItemRecords(
+	MESH_KIND mesh,
+	int lod,
+	const PrimitiveMeshes::INSTANCE_DATA* instances,
+	int instanceCount)
+{
+	int firstRecord = m_primitiveMeshes->WriteDrawData(instances, instanceCount);
 
-	std::cout << "Could not load image:" << filename << std::endl;
+	if (m_bUseMultiDraw == true)
+	{
+		m_primitiveMeshes->QueueRecords(mesh, lod, firstRecord, instanceCount);
+	}
+	else
+	{
+		m_primitiveMeshes->DrawRecords(mesh, lod, firstRecord, instanceCount);
+	}
+}
 
-	// Error loading the image
-	return false;
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a point light, which only
+ *  lights the pixels within its radius.
+ ***********************************************************/
+int SceneManager::AddPointLight(
+	const glm::vec3& position,
+	float radius,
+	const glm::vec3& color)
+{
+	ClusteredLighting::POINT_LIGHT light;
+
+	light.position = position;
+	light.radius = radius;
+	light.ambientColor = glm::vec3(0.0f);
+	light.diffuseColor = color;
+	light.specularColor = color * 0.5f;
+	light.focalStrength = 16.0f;
+	light.specularIntensity = 0.05f;
+	light.padding = 0.0f;
+
+	return(m_clusteredLighting.AddLight(light));
 }
 
 /***********************************************************
- *  BindGLTextures()
+ *  AddYardLamps()
  *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
+ *  This method is used for scattering small warm lamps over
+ *  the ground plane.  The same seed is used every run, so the
+ *  lamps are always in the same places.
  ***********************************************************/
-void SceneManager::BindGLTextures()
+void SceneManager::AddYardLamps()
 {
-	for (int i = 0; i < m_loadedTextures; i++)
+	std::mt19937 random(330);
+	std::uniform_real_distribution<float> positionX(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> positionY(0.5f, 2.0f);
+	std::uniform_real_distribution<float> positionZ(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> warmth(0.0f, 0.3f);
+
+	for (int i = 0; i < m_yardLampCount; i++)
 	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+		glm::vec3 position(positionX(random), positionY(random), positionZ(random));
+		glm::vec3 color(1.0f, 0.7f + warmth(random), 0.4f + warmth(random));
+
+		AddPointLight(position, 3.0f, color * 0.6f);
 	}
 }
 
 /***********************************************************
- *  DestroyGLTextures()
+ *  BuildGeneratedObjects()
  *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
+ *  This method is used for laying out the generated objects
+ *  on a square grid centered under the scene, cycling through
+ *  the shapes, colors and materials so the objects fall into
+ *  a handful of instanced groups the way a real scene would.
+ *  The same seed is used every run, so every run measures the
+ *  same scene.
  ***********************************************************/
-void SceneManager::DestroyGLTextures()
+void SceneManager::BuildGeneratedObjects()
 {
-	for (int i = 0; i < m_loadedTextures; i++)
+	const MESH_KIND meshes[] = { MESH_BOX, MESH_CYLINDER, MESH_SPHERE, MESH_TORUS, MESH_PYRAMID4 };
+	const glm::vec4 colors[] = {
+		glm::vec4(0.8f, 0.3f, 0.2f, 1.0f),
+		glm::vec4(0.2f, 0.6f, 0.3f, 1.0f),
+		glm::vec4(0.3f, 0.4f, 0.8f, 1.0f),
+		glm::vec4(0.8f, 0.7f, 0.3f, 1.0f) };
+	const char* materials[] = { "wood", "metal", "rubber", "ground" };
+	const int meshCount = sizeof(meshes) / sizeof(meshes[0]);
+	const int colorCount = sizeof(colors) / sizeof(colors[0]);
+	const int materialCount = sizeof(materials) / sizeof(materials[0]);
+	const float spacing = 2.5f;
+
+	std::mt19937 random(330);
+	std::uniform_real_distribution<float> scale(0.6f, 1.0f);
+	std::uniform_real_distribution<float> rotation(0.0f, 360.0f);
+
+	int columns = (int)ceil(sqrt((double)m_generatedObjectCount));
+	float offset = (columns - 1) * spacing * 0.5f;
+
+	for (int i = 0; i < m_generatedObjectCount; i++)
 	{
-		glGenTextures(1, &m_textureIDs[i].ID);
+		float size = scale(random);
+		glm::vec3 positionXYZ(
+			(i % columns) * spacing - offset,
+			size * 0.5f,
+			(i / columns) * spacing - offset);
+
+		AddRenderItem(
+			meshes[i % meshCount],
+			glm::vec3(size, size, size),
+			0.0f,
+			rotation(random),
+			0.0f,
+			positionXYZ,
+			colors[(i / meshCount) % colorCount],
+			"",
+			materials[i % materialCount]);
 	}
 }
 
 /***********************************************************
- *  FindTextureID()
+ *  UploadMaterialBuffer()
  *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method is used for packing all the defined materials
+ *  into a single std140 uniform buffer, which is uploaded once.
+ *  Every draw then selects its material by index, so the
+ *  number of materials does not change the cost of a frame.
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+void SceneManager::UploadMaterialBuffer()
 {
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
+	ProfileScope profileScope(m_pFrameProfiler, "Shader.MaterialBuffer");
+	std::vector<GPU_MATERIAL> materials;
+	int materialCount = (int)m_objectMaterials.size();
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	if (materialCount > g_MaxMaterials)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
+		std::cout << "Only the first " << g_MaxMaterials << " of "
+			<< materialCount << " materials can be used by the shader" << std::endl;
+		materialCount = g_MaxMaterials;
+	}
+
+	// the buffer is always the full size of the shader block, and
+	// the unused entries keep a plain material for unset indices
+	GPU_MATERIAL defaultMaterial;
+	defaultMaterial.ambientColor = glm::vec3(1.0f);
+	defaultMaterial.ambientStrength = 1.0f;
+	defaultMaterial.diffuseColor = glm::vec3(0.0f);
+	defaultMaterial.padding = 0.0f;
+	defaultMaterial.specularColor = glm::vec3(0.0f);
+	defaultMaterial.shininess = 0.0f;
+	materials.resize(g_MaxMaterials, defaultMaterial);
+
+	for (int i = 0; i < materialCount; i++)
+	{
+		materials[i].ambientColor = m_objectMaterials[i].ambientColor;
+		materials[i].ambientStrength = m_objectMaterials[i].ambientStrength;
+		materials[i].diffuseColor = m_objectMaterials[i].diffuseColor;
+		materials[i].specularColor = m_objectMaterials[i].specularColor;
+		materials[i].shininess = m_objectMaterials[i].shininess;
 	}
 
-	return(textureID);
+	if (m_materialBuffer == 0)
+	{
+		glGenBuffers(1, &m_materialBuffer);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+	glBufferData(
+		GL_UNIFORM_BUFFER,
+		materials.size() * sizeof(GPU_MATERIAL),
+		materials.data(),
+		GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_MaterialBlockBinding, m_materialBuffer);
 }
 
 /***********************************************************
- *  FindTextureSlot()
+ *  BuildRenderQueue()
  *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
+ *  This method is used for filling the render queue with a
+ *  draw command for every single render item and for every
+ *  instance batch, and then sorting the commands so the
+ *  draws that share state are submitted together.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+void SceneManager::BuildRenderQueue()
 {
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
+	ProfileScope profileScope(m_pFrameProfiler, "Scene.BuildQueue");
+	glm::vec3 cameraPosition(0.0f, 0.0f, 0.0f);
+
+	if (NULL != m_pViewManager)
+	{
+		cameraPosition = m_pViewManager->GetCameraPosition();
+	}
+
+	m_renderQueue.Clear();
 
-	while ((index < m_loadedTextures) && (bFound == false))
+	for (size_t i = 0; i < m_renderItems.size(); i++)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
+		const RENDER_ITEM& item = m_renderItems[i];
+
+		if ((item.bInstanced == false) && (m_itemVisible[i] != 0))
 		{
-			textureSlot = index;
-			bFound = true;
+			glm::vec3 position = glm::vec3(m_transforms.GetWorldMatrix(item.transformIndex)[3]);
+
+			m_renderQueue.Submit(
+				RenderQueue::MakeSortKey(
+					g_ShaderModeSingle,
+					item.textureSlot,
+					item.materialIndex,
+					item.mesh,
+					glm::distance(cameraPosition, position),
+					g_MaxSortDepth),
+				(int)i,
+				false);
 		}
-		else
-			index++;
 	}
 
-	return(textureSlot);
+	for (size_t b = 0; b < m_instanceBatches.size(); b++)
+	{
+		const INSTANCE_BATCH& batch = m_instanceBatches[b];
+
+		// a batch is only drawn when one of its items is visible,
+		// which the compute culling only knows on the GPU
+		bool bAnyVisible = (m_bUseGpuCulling == true) && (batch.items.empty() == false);
+		for (size_t i = 0; (i < batch.items.size()) && (bAnyVisible == false); i++)
+		{
+			bAnyVisible = (m_itemVisible[batch.items[i]] != 0);
+		}
+		if (bAnyVisible == false)
+		{
+			continue;
+		}
+
+		m_renderQueue.Submit(
+			RenderQueue::MakeSortKey(
+				g_ShaderModeInstanced,
+				batch.textureSlot,
+				-1,
+				batch.mesh,
+				0.0f,
+				g_MaxSortDepth),
+			(int)b,
+			true);
+	}
+
+	m_renderQueue.Sort();
 }
 
 /***********************************************************
- *  FindMaterial()
+ *  ApplySurfaceState()
  *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
+ *  This method is used for setting the texture of the next
+ *  draw into the shader.  The color, UV scale and material are
+ *  read from the draw data, so only the texture is left as
+ *  shader state, and the multi-draw queue only has to be
+ *  submitted when the texture changes.  Any value that the
+ *  shader was already given by the previous draw is skipped,
+ *  and both the uploaded and the skipped values are counted.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+void SceneManager::ApplySurfaceState(int textureSlot)
 {
-	if (m_objectMaterials.size() == 0)
+	bool bValid = m_shaderState.bValid;
+	bool bUseTexture = (textureSlot >= 0);
+
+	// the queued multi-draws are drawn with the texture they
+	// were queued with, before it is changed
+	if ((bValid == false) || (m_shaderState.textureSlot != textureSlot))
 	{
-		return(false);
+		m_primitiveMeshes->SubmitQueuedRecords();
+	}
+
+	if ((bValid == false) || (m_shaderState.bUseTexture != bUseTexture))
+	{
+		m_pUniformCache->SetBool(m_uniforms.useTexture, bUseTexture);
+		m_shaderState.bUseTexture = bUseTexture;
+		m_renderStats.stateChanges++;
+	}
+	else
+	{
+		m_renderStats.stateChangesSkipped++;
 	}
 
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
+	if (bUseTexture == true)
 	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
+		if ((bValid == false) || (m_shaderState.textureSlot != textureSlot))
 		{
-			bFound = true;
-			material.ambientColor = m_objectMaterials[index].ambientColor;
-			material.ambientStrength = m_objectMaterials[index].ambientStrength;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
+			ApplyTextureSlot(textureSlot);
+			m_shaderState.textureSlot = textureSlot;
+			m_renderStats.stateChanges++;
 		}
 		else
 		{
-			index++;
+			m_renderStats.stateChangesSkipped++;
 		}
 	}
 
-	return(true);
+	if (bValid == false)
+	{
+		// the texture slot is unknown when it was not uploaded
+		if (bUseTexture == false)
+		{
+			m_shaderState.textureSlot = -1;
+		}
+		m_shaderState.bValid = true;
+	}
 }
 
 /***********************************************************
- *  SetTransformations()
+ *  SetViewManager()
  *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
+ *  This method is used for setting the view manager that
+ *  provides the camera position for sorting the draws.
  ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
+void SceneManager::SetViewManager(ViewManager* pViewManager)
 {
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationX * rotationY * rotationZ * scale;
+	m_pViewManager = pViewManager;
+}
 
-	if (NULL != m_pShaderManager)
+/***********************************************************
+ *  SetUniformCache()
+ *
+ *  This method is used for setting the cached uniform
+ *  locations of the shader, and for resolving the handles of
+ *  the uniforms that are set on every draw, so that drawing
+ *  does no string work at all.
+ ***********************************************************/
+void SceneManager::SetUniformCache(UniformCache* pUniformCache)
+{
+	m_pUniformCache = pUniformCache;
+
+	if (NULL == m_pUniformCache)
 	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+		return;
 	}
+
+	m_uniforms.objectTexture = m_pUniformCache->GetHandle(g_TextureValueName);
+	m_uniforms.objectTextureArray = m_pUniformCache->GetHandle("objectTextureArray");
+	m_uniforms.textureLayer = m_pUniformCache->GetHandle("textureLayer");
+	m_uniforms.useTexture = m_pUniformCache->GetHandle(g_UseTextureName);
+	m_uniforms.useInstancing = m_pUniformCache->GetHandle(g_UseInstancingName);
+	m_uniforms.materialIndex = m_pUniformCache->GetHandle("materialIndex");
+	m_uniforms.useLighting = m_pUniformCache->GetHandle(g_UseLightingName);
+	m_uniforms.view = m_pUniformCache->GetHandle("view");
+	m_uniforms.projection = m_pUniformCache->GetHandle("projection");
+
+	m_clusteredLighting.SetUniformCache(m_pUniformCache);
+	m_shadowCascades.SetUniformCache(m_pUniformCache);
 }
 
 /***********************************************************
- *  SetShaderColor()
+ *  SetFrameProfiler()
  *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
+ *  This method is used for setting the profiler that measures
+ *  the CPU and GPU time of the render passes.
  ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
+void SceneManager::SetFrameProfiler(FrameProfiler* pFrameProfiler)
 {
-	// variables for this method
-	glm::vec4 currentColor;
+	m_pFrameProfiler = pFrameProfiler;
+}
 
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
+/***********************************************************
+ *  SetTextureArraysEnabled()
+ *
+ *  This method is used for choosing whether the loaded
+ *  textures are packed into texture arrays instead of being
+ *  bound to one texture unit each.  It has to be set before
+ *  the scene is prepared.
+ ***********************************************************/
+void SceneManager::SetTextureArraysEnabled(bool bEnabled)
+{
+	m_bUseTextureArrays = bEnabled;
+}
 
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
+/***********************************************************
+ *  SetMultiDrawEnabled()
+ *
+ *  This method is used for choosing whether the draws of each
+ *  pass are queued and submitted together with one
+ *  multi-draw-indirect call, instead of one call each.  The
+ *  draws are only split where the bound texture changes.
+ ***********************************************************/
+void SceneManager::SetMultiDrawEnabled(bool bEnabled)
+{
+	m_bUseMultiDraw = bEnabled;
 }
 
 /***********************************************************
- *  SetShaderTexture()
+ *  SetGpuCullingEnabled()
  *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
+ *  This method is used for choosing whether the instanced
+ *  objects are culled by a compute shader instead of on the
+ *  CPU.  The CPU culling is kept when the context has no
+ *  compute shaders.  It has to be set before the scene is
+ *  prepared.
  ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
+void SceneManager::SetGpuCullingEnabled(bool bEnabled)
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+	m_bUseGpuCulling = bEnabled;
+}
 
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
+/***********************************************************
+ *  SetYardLampCount()
+ *
+ *  This method is used for setting the number of point lights
+ *  that are scattered over the yard when the scene lights are
+ *  set up.  It has to be set before the scene is prepared.
+ ***********************************************************/
+void SceneManager::SetYardLampCount(int lampCount)
+{
+	m_yardLampCount = lampCount;
 }
 
 /***********************************************************
- *  SetTextureUVScale()
+ *  SetGeneratedObjectCount()
  *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
+ *  This method is used for setting the number of generated
+ *  objects that replace the objects of the scene, so scenes
+ *  from one object to hundreds of thousands can be measured.
+ *  It has to be set before the scene is prepared.
  ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
+void SceneManager::SetGeneratedObjectCount(int objectCount)
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
+	m_generatedObjectCount = objectCount;
 }
 
 /***********************************************************
- *  SetShaderMaterial()
+ *  GetRenderItemCount()
  *
- *  This method is used for passing the material values
- *  into the shader.
+ *  This method is used for getting the number of objects
+ *  defined in the scene.
  ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
+int SceneManager::GetRenderItemCount() const
 {
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
+	return((int)m_renderItems.size());
+}
 
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.ambientColor", material.ambientColor);
-			m_pShaderManager->setFloatValue("material.ambientStrength", material.ambientStrength);
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
+/***********************************************************
+ *  SetShadowSettings()
+ *
+ *  This method is used for setting the size of the shadow
+ *  maps and the number of cascades they are split into.
+ *  Fewer cascades and smaller maps cost less frame time, at
+ *  the price of blurrier shadows.  A negative value keeps
+ *  the current setting.  The shadow maps are created again
+ *  on the next frame.
+ ***********************************************************/
+void SceneManager::SetShadowSettings(int resolution, int cascadeCount)
+{
+	if (resolution >= 0)
+	{
+		m_shadowResolution = resolution;
+	}
+	if (cascadeCount >= 0)
+	{
+		m_shadowCascadeCount = glm::min(cascadeCount, (int)ShadowCascades::MAX_CASCADES);
 	}
 }
 
+/***********************************************************
+ *  GetRenderStats()
+ *
+ *  This method is used for getting the counters of the last
+ *  rendered frame.
+ ***********************************************************/
+const SceneManager::RENDER_STATS& SceneManager::GetRenderStats() const
+{
+	return(m_renderStats);
+}
+
 /**************************************************************/
 /*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
 /*** preparing and rendering their own 3D replicated scenes.***/
@@ -395,39 +1989,41 @@ void SceneManager::SetShaderMaterial(
 ***********************************************************/
 void SceneManager::LoadSceneTextures()
 {
-	bool bReturn = false;
-
-	bReturn = CreateGLTexture(
+	// the texture files are decoded in parallel once they
+	// have all been added to the texture loader
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/green-shed.jpg",
 		"shed");
 
-	bReturn = CreateGLTexture(
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/yellow_roof.jpg",
 		"roof");
 
-	bReturn = CreateGLTexture(
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/grass.jpg",
 		"grass");
 
-	bReturn = CreateGLTexture(
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/stainless.jpg",
 		"trough");
 
-	bReturn = CreateGLTexture(
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/tractor-tire.jpg",
 		"tractor");
 
-	bReturn = CreateGLTexture(
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/tire-tread.jpg",
 		"tread");
 
-	bReturn = CreateGLTexture(
+	m_textureLoader.AddFile(
 		"C:/Users/miche/CS330Content/Projects/7-1_FinalProjectMilestones/Source/textures/red-wagon.jpg",
 		"trailer");
 	
+	LoadQueuedTextures();
+
 	// after the texture image data is loaded into memory, the
-	// loaded textures need to be bound to texture slots - there
-	// are a total of 16 available slots for scene textures
+	// loaded textures need to be bound to texture units, or
+	// packed into texture arrays when those are enabled
 	BindGLTextures();
 }
 
@@ -493,40 +2089,63 @@ void SceneManager::SetupSceneLights()
 	// been added then the display window will be black - to use the 
 	// pShaderManager->setBoolValue(g_UseLightingName, true);
 
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
+	if (NULL == m_pUniformCache)
+	{
+		return;
+	}
+
+	m_pUniformCache->SetBool(g_UseLightingName, true);
+
+	// the lights are kept in a uniform buffer, which is sent to
+	// the shader by RenderScene() - changing a light later only
+	// sends that light again
+	LightManager::LIGHT_SOURCE light;
+	// the value a light type does not use keeps this default
+	light.position = glm::vec3(0.0f, 0.0f, 0.0f);
 
 	// Overhead light
-	m_pShaderManager->setVec3Value("lightSources[0].direction", 0.0f, -1.0f, 0.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].ambientColor", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setVec3Value("lightSources[0].diffuseColor", 0.8f, 0.8f, 0.8f);
-	m_pShaderManager->setVec3Value("lightSources[0].specularColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].focalStrength", 32.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].specularIntensity", 0.05f);
+	light.type = LightManager::LIGHT_DIRECTIONAL;
+	light.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	light.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	light.diffuseColor = glm::vec3(0.8f, 0.8f, 0.8f);
+	light.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	light.focalStrength = 32.0f;
+	light.specularIntensity = 0.05f;
+	m_lightManager.AddLight(light);
 
 	// Light in front-left of scene
-	m_pShaderManager->setVec3Value("lightSources[1].position", -5.0f, 0.0f, -10.0f);
-	m_pShaderManager->setVec3Value("lightSources[1].ambientColor", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setVec3Value("lightSources[1].diffuseColor", 0.5f, 0.5f, 0.5f);
-	m_pShaderManager->setVec3Value("lightSources[1].specularColor", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setFloatValue("lightSources[1].focalStrength", 16.0f);
-	m_pShaderManager->setFloatValue("lightSources[1].specularIntensity", 0.05f);
+	light.type = LightManager::LIGHT_POINT;
+	light.position = glm::vec3(-5.0f, 0.0f, -10.0f);
+	light.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	light.diffuseColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	light.specularColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	light.focalStrength = 16.0f;
+	light.specularIntensity = 0.05f;
+	m_lightManager.AddLight(light);
 
 	// Light in front-right of scene
-	m_pShaderManager->setVec3Value("lightSources[2].position", 5.0f, 0.0f, -10.0f);
-	m_pShaderManager->setVec3Value("lightSources[2].ambientColor", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setVec3Value("lightSources[2].diffuseColor", 0.5f, 0.5f, 0.5f);
-	m_pShaderManager->setVec3Value("lightSources[2].specularColor", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setFloatValue("lightSources[2].focalStrength", 16.0f);
-	m_pShaderManager->setFloatValue("lightSources[2].specularIntensity", 0.05f);
+	light.type = LightManager::LIGHT_POINT;
+	light.position = glm::vec3(5.0f, 0.0f, -10.0f);
+	light.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	light.diffuseColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	light.specularColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	light.focalStrength = 16.0f;
+	light.specularIntensity = 0.05f;
+	m_lightManager.AddLight(light);
 
 	// Light in rear of scene
-	m_pShaderManager->setVec3Value("lightSources[3].position", 0.0f, 0.0f, 10.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].ambientColor", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setVec3Value("lightSources[3].diffuseColor", 0.5f, 0.5f, 0.5f);
-	m_pShaderManager->setVec3Value("lightSources[3].specularColor", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setFloatValue("lightSources[3].focalStrength", 16.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].specularIntensity", 0.05f);
-	
+	light.type = LightManager::LIGHT_POINT;
+	light.position = glm::vec3(0.0f, 0.0f, 10.0f);
+	light.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	light.diffuseColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	light.specularColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	light.focalStrength = 16.0f;
+	light.specularIntensity = 0.05f;
+	m_lightManager.AddLight(light);
+
+	// any number of point lights are shaded through the light
+	// clusters, each only where it reaches
+	AddYardLamps();
 }
 
 /***********************************************************
@@ -541,28 +2160,56 @@ void SceneManager::PrepareScene()
 	// load the textures for the 3D scene
 	LoadSceneTextures();
 	DefineObjectMaterials();
+	IndexObjectMaterials();
 	SetupSceneLights();
 
 	// only one instance of a particular mesh needs to be
 	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadTorusMesh();
-	m_basicMeshes->LoadPyramid4Mesh();
+	// in the rendered 3D scene, and every draw reads its
+	// placement and surface from the draw data of the frame
+	m_primitiveMeshes->LoadMeshes();
+	UploadMaterialBuffer();
+
+	// define every object in the scene a single time - the
+	// render items are walked by RenderScene() every frame
+	if (m_generatedObjectCount > 0)
+	{
+		BuildGeneratedObjects();
+	}
+	else
+	{
+		BuildSceneObjects();
+	}
+	UnloadUnusedMeshes();
+	BuildInstanceBatches();
+	BuildBoundingVolumes();
 
+	// the instanced objects are culled by a compute shader when
+	// the context runs them, and on the CPU otherwise
+	if (m_bUseGpuCulling == true)
+	{
+		if (m_gpuCulling.Initialize(g_CullingShaderName) == true)
+		{
+			m_gpuCulling.SetLodScreenSizes(g_LodScreenSizes, PrimitiveMeshes::LOD_COUNT - 1, g_LodHysteresis);
+			m_primitiveMeshes->SetIndirectRecordBuffer(m_gpuCulling.GetVisibleRecordBuffer());
+			std::cout << "INFO: culling the instanced objects on the GPU" << std::endl;
+		}
+		else
+		{
+			std::cout << "INFO: compute culling is not available, culling on the CPU" << std::endl;
+			m_bUseGpuCulling = false;
+		}
+	}
 }
 
 /***********************************************************
- *  RenderScene()
+ *  BuildSceneObjects()
  *
- *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
+ *  This method is used for defining every object in the 3D
+ *  scene once, so that the transformations, colors, textures
+ *  and materials do not need to be derived again each frame
  ***********************************************************/
-void SceneManager::RenderScene()
+void SceneManager::BuildSceneObjects()
 {
 	// declare the variables for the transformations
 	glm::vec3 scaleXYZ;
@@ -571,15 +2218,15 @@ void SceneManager::RenderScene()
 	float ZrotationDegrees = 0.0f;
 	glm::vec3 positionXYZ;
 
-	glm::mat4 scale;
-	glm::mat4 rotation;
-	glm::mat4 rotation2;
-	glm::mat4 translation;
-	glm::mat4 mode;
+	// render item indices used for attaching child objects
+	int wagonFrame = -1;
+	int wagonWheel = -1;
+	// render item index used for marking the large occluders
+	int occluder = -1;
 
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
+	/*** Set needed transformations before registering the basic    ***/
+	/*** mesh. This same ordering of code should be used for        ***/
+	/*** transforming and registering all the basic 3D shapes.      ***/
 	/******************************************************************/
 
 	// Render plane for ground
@@ -594,20 +2241,18 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	AddRenderItem(
+		MESH_PLANE,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.75, 0.75, 0.75, 1); // Grey color
-	SetShaderTexture("grass");
-	SetShaderMaterial("ground");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
+		positionXYZ,
+		glm::vec4(0.75f, 0.75f, 0.75f, 1.0f), // Grey color
+		"grass",
+		"ground");
 	/****************************************************************/
 
 	// Render background plane
@@ -622,19 +2267,20 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(0.0f, 9.0f, -10.0f);
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	occluder = AddRenderItem(
+		MESH_PLANE,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0.196078, 0.196078, 1.0, 1); // Light blue
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
+		positionXYZ,
+		glm::vec4(0.196078f, 0.196078f, 1.0f, 1.0f), // Light blue
+		"",
+		"ground");
+	// the background hides everything behind it
+	SetRenderItemOccluder(occluder);
 	/******************************************************************/
 
 	// Render box for shed
@@ -649,21 +2295,20 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(-3.0f, 2.0f, 0.0f);  // Positioned to left of origin to match scene
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	occluder = AddRenderItem(
+		MESH_BOX,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0, 1, 0, 1); // Green color
-	SetShaderTexture("shed");
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
+		positionXYZ,
+		glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), // Green color
+		"shed",
+		"metal");
+	// the shed hides the objects standing behind it
+	SetRenderItemOccluder(occluder);
 	/******************************************************************/
 
 	// Render pyramid for shed roof
@@ -678,21 +2323,18 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(-3.0f, 5.7f, 0.0f);  // Positioned above box to create roof
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	AddRenderItem(
+		MESH_PYRAMID4,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(1, 1, 0, 1); // Yellow color
-	SetShaderTexture("roof");
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPyramid4Mesh();
+		positionXYZ,
+		glm::vec4(1.0f, 1.0f, 0.0f, 1.0f), // Yellow color
+		"roof",
+		"metal");
 	/******************************************************************/
 
 	// Render torus for water tank
@@ -707,21 +2349,18 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(-6.0f, 1.0f, 5.0f); // Position to the left of shed
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	AddRenderItem(
+		MESH_TORUS,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0.5, 0.5, 0.5, 1); // Gray color
-	SetShaderTexture("trough");
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTorusMesh();
+		positionXYZ,
+		glm::vec4(0.5f, 0.5f, 0.5f, 1.0f), // Gray color
+		"trough",
+		"metal");
 	/******************************************************************/
 
 	// Render cylinder for barrel
@@ -736,20 +2375,18 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(0.0f, 0.0f, 7.5f);  // Position slightly right and in foreground of shed
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	AddRenderItem(
+		MESH_CYLINDER,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(1, 0.5, 0, 1); // Orange color
-	SetShaderMaterial("rubber");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
+		positionXYZ,
+		glm::vec4(1.0f, 0.5f, 0.0f, 1.0f), // Orange color
+		"",
+		"rubber");
 	/******************************************************************/
 
 	// Render torus for tire on top of wagon
@@ -764,21 +2401,18 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(4.8f, 2.4f, 3.5f); // Position to the right of scene and to be on top of wagon
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	AddRenderItem(
+		MESH_TORUS,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0, 0, 0, 1); // Black color
-	SetShaderTexture("tread");
-	SetShaderMaterial("rubber");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawTorusMesh();
+		positionXYZ,
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), // Black color
+		"tread",
+		"rubber");
 	/******************************************************************/
 
 	// Render box to create wagon frame
@@ -793,21 +2427,18 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(5.0f, 1.0f, 3.0f);
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	wagonFrame = AddRenderItem(
+		MESH_BOX,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(1, 0, 0, 1); // Red color
-	SetShaderTexture("trailer");
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
+		positionXYZ,
+		glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), // Red color
+		"trailer",
+		"wood");
 	/******************************************************************/
 
 	// Render cylinder for wagon wheel front-right
@@ -822,21 +2453,21 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(6.2f, 0.6f, 3.4f);  // Position under wagon
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	wagonWheel = AddRenderItem(
+		MESH_CYLINDER,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0, 0, 0, 1); // black color
-	SetShaderTexture("tread");
-	SetShaderMaterial("rubber");
+		positionXYZ,
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), // black color
+		"tread",
+		"rubber");
 
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
+	// the wheel follows the wagon frame whenever the frame is moved
+	AttachRenderItem(wagonWheel, wagonFrame);
 	/******************************************************************/
 
 	// Render cylinder for wagon wheel back-right
@@ -851,21 +2482,21 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(5.5f, 0.6f, 1.4f);  // Position under wagon
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	wagonWheel = AddRenderItem(
+		MESH_CYLINDER,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0, 0, 0, 1); // black color
-	SetShaderTexture("tread");
-	SetShaderMaterial("rubber");
+		positionXYZ,
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), // black color
+		"tread",
+		"rubber");
 
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
+	// the wheel follows the wagon frame whenever the frame is moved
+	AttachRenderItem(wagonWheel, wagonFrame);
 	/******************************************************************/
 
 	// Render cylinder for wagon wheel front-left
@@ -880,21 +2511,21 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(4.2f, 0.6f, 4.3f);  // Position under wagon
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	wagonWheel = AddRenderItem(
+		MESH_CYLINDER,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0, 0, 0, 1); // black color
-	SetShaderTexture("tread");
-	SetShaderMaterial("rubber");
+		positionXYZ,
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), // black color
+		"tread",
+		"rubber");
 
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
+	// the wheel follows the wagon frame whenever the frame is moved
+	AttachRenderItem(wagonWheel, wagonFrame);
 	/******************************************************************/
 
 	// Render cylinder for wagon wheel back-left
@@ -909,20 +2540,224 @@ void SceneManager::RenderScene()
 	// set the XYZ position for the mesh
 	positionXYZ = glm::vec3(3.5f, 0.6f, 2.2f);  // Position under wagon
 
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
+	// register the object with its transformation values, color,
+	// texture and material so it is drawn every frame
+	wagonWheel = AddRenderItem(
+		MESH_CYLINDER,
 		scaleXYZ,
 		XrotationDegrees,
 		YrotationDegrees,
 		ZrotationDegrees,
-		positionXYZ);
-
-	// set the color values into the shader
-	SetShaderColor(0, 0, 0, 1); // black color
-	SetShaderTexture("tread");
-	SetShaderMaterial("rubber");
+		positionXYZ,
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), // black color
+		"tread",
+		"rubber");
 
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
+	// the wheel follows the wagon frame whenever the frame is moved
+	AttachRenderItem(wagonWheel, wagonFrame);
 	/******************************************************************/
 }
+
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by walking
+ *  the render items that were built in PrepareScene().  The
+ *  draws are sorted by their state first, and only the state
+ *  that differs from the previous draw is sent to the shader.
+ ***********************************************************/
+void SceneManager::RenderScene()
+{
+	if (NULL == m_pUniformCache)
+	{
+		return;
+	}
+
+	// only the transforms that changed since the last frame
+	// are recalculated - a static scene does no matrix work
+	if (m_transforms.UpdateTransforms() > 0)
+	{
+		m_bInstancesChanged = true;
+		UpdateItemBounds();
+		m_boundingVolumes.Refit(m_itemBounds);
+	}
+	if (m_bInstancesChanged == true)
+	{
+		UpdateInstanceBatches();
+	}
+
+	// objects outside of the view frustum are left out of the
+	// render queue, so they cost nothing to draw
+	CullRenderItems();
+	SelectItemLods();
+
+	// the point lights are listed in the clusters of this view
+	int lightSection = -1;
+	if (NULL != m_pFrameProfiler)
+	{
+		lightSection = m_pFrameProfiler->BeginSection("Shader.Lights");
+	}
+	if (NULL != m_pViewManager)
+	{
+		GLint viewport[4] = { 0, 0, 0, 0 };
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		m_clusteredLighting.Update(
+			m_pViewManager->GetViewMatrix(),
+			m_pViewManager->GetProjectionMatrix(),
+			viewport[2],
+			viewport[3]);
+	}
+	// only the scene lights changed since the last frame are sent
+	m_lightManager.ResetUploadedBytes();
+	m_lightManager.Upload();
+	if (NULL != m_pFrameProfiler)
+	{
+		m_pFrameProfiler->EndSection(lightSection);
+	}
+	m_renderStats.lightBytesUploaded = m_lightManager.GetUploadedBytes();
+	m_renderStats.pointLights = m_clusteredLighting.GetLightCount();
+	m_renderStats.lightAssignments = m_clusteredLighting.GetAssignmentCount();
+
+	// every draw of the frame reads its record of draw data
+	// from the ring buffer, from the shadow pass on
+	m_primitiveMeshes->ResetDrawDataStats();
+	m_primitiveMeshes->BeginFrame();
+	m_pUniformCache->SetBool(m_uniforms.useInstancing, true);
+
+	// the casters are drawn into the shadow maps before any of
+	// the passes that draw to the screen
+	RenderShadowPass();
+
+	// objects hidden behind the occluders on the last frame are
+	// left out as well, after this frame's queries are issued
+	bool bOcclusion = (NULL != m_pViewManager) && (m_pViewManager->IsOcclusionCullingEnabled() == true);
+	if (bOcclusion != m_bOcclusionActive)
+	{
+		m_occlusionQueries.Reset();
+		m_bOcclusionActive = bOcclusion;
+	}
+	m_renderStats.occludedItems = 0;
+	if (bOcclusion == true)
+	{
+		m_occlusionQueries.BeginFrame();
+		RenderOcclusionQueries();
+		HideOccludedItems();
+
+		// the occluders are already in the depth buffer
+		glDepthFunc(GL_LEQUAL);
+	}
+	BuildRenderQueue();
+
+	// the shader values may have been changed outside of this
+	// method since the last frame, so nothing is assumed
+	m_shaderState.bValid = false;
+	m_primitiveMeshes->ResetDrawCallCount();
+	m_renderStats.stateChanges = 0;
+	m_renderStats.stateChangesSkipped = 0;
+	for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+	{
+		m_renderStats.lodItems[lod] = 0;
+		m_renderStats.lodTriangles[lod] = 0;
+	}
+
+	int drawSection = -1;
+	if (NULL != m_pFrameProfiler)
+	{
+		drawSection = m_pFrameProfiler->BeginSection("Scene.Draw");
+	}
+	const std::vector<RenderQueue::DRAW_COMMAND>& commands = m_renderQueue.GetCommands();
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		if (commands[i].bInstanced == true)
+		{
+			// the group is drawn with one instanced draw call for
+			// each level of detail in use, and the material of every
+			// object is selected by its index in the shader
+			const INSTANCE_BATCH& batch = m_instanceBatches[commands[i].index];
+
+			// the compute culling already wrote the commands of
+			// every level of the group, with only its visible
+			// instances, so they are drawn without touching them
+			if (m_bUseGpuCulling == true)
+			{
+				int firstCommand = commands[i].index * PrimitiveMeshes::LOD_COUNT;
+
+				ApplySurfaceState(batch.textureSlot);
+				m_primitiveMeshes->DrawIndirect(
+					m_gpuCulling.GetCommandBuffer(),
+					firstCommand,
+					PrimitiveMeshes::LOD_COUNT);
+
+				// the counts are read back from an earlier frame
+				for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+				{
+					int instanceCount = m_gpuCulling.GetVisibleInstanceCount(firstCommand + lod);
+
+					m_renderStats.lodItems[lod] += instanceCount;
+					m_renderStats.lodTriangles[lod] +=
+						instanceCount * m_primitiveMeshes->GetTriangleCount(batch.mesh, lod);
+				}
+				continue;
+			}
+
+			// only the visible instances of the group are drawn
+			for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+			{
+				m_visibleInstances[lod].clear();
+			}
+			for (size_t j = 0; j < batch.items.size(); j++)
+			{
+				if (m_itemVisible[batch.items[j]] != 0)
+				{
+					m_visibleInstances[m_renderItems[batch.items[j]].lod].push_back(batch.instances[j]);
+				}
+			}
+
+			ApplySurfaceState(batch.textureSlot);
+			for (int lod = 0; lod < PrimitiveMeshes::LOD_COUNT; lod++)
+			{
+				int instanceCount = (int)m_visibleInstances[lod].size();
+
+				if (instanceCount > 0)
+				{
+					DrawItemRecords(batch.mesh, lod, m_visibleInstances[lod].data(), instanceCount);
+					m_renderStats.lodItems[lod] += instanceCount;
+					m_renderStats.lodTriangles[lod] +=
+						instanceCount * m_primitiveMeshes->GetTriangleCount(batch.mesh, lod);
+				}
+			}
+		}
+		else
+		{
+			const RENDER_ITEM& item = m_renderItems[commands[i].index];
+			PrimitiveMeshes::INSTANCE_DATA instance;
+
+			// the model matrix is taken from the transform cache
+			GetItemDrawData(commands[i].index, instance);
+			ApplySurfaceState(item.textureSlot);
+
+			// draw the mesh with the cached transformation values
+			DrawItemRecords(item.mesh, item.lod, &instance, 1);
+			m_renderStats.lodItems[item.lod]++;
+			m_renderStats.lodTriangles[item.lod] += m_primitiveMeshes->GetTriangleCount(item.mesh, item.lod);
+		}
+	}
+	m_primitiveMeshes->SubmitQueuedRecords();
+	m_renderStats.drawCalls = m_primitiveMeshes->GetDrawCallCount();
+	m_renderStats.indirectCommands = m_primitiveMeshes->GetIndirectCommandCount();
+	if (NULL != m_pFrameProfiler)
+	{
+		m_pFrameProfiler->EndSection(drawSection);
+	}
+
+	// leave the shader ready for drawing single objects with
+	// the uniform values, and fence off the frame's draw data
+	m_pUniformCache->SetBool(m_uniforms.useInstancing, false);
+	m_primitiveMeshes->EndFrame();
+	m_renderStats.drawDataBytes = m_primitiveMeshes->GetDrawDataBytes();
+	m_renderStats.drawDataStalls = m_primitiveMeshes->GetDrawDataStallCount();
+	if (bOcclusion == true)
+	{
+		glDepthFunc(GL_LESS);
+	}
+}
\ No newline at end of file
@@ -10,9 +10,23 @@
 #pragma once
 
 #include "ShaderManager.h"
-#include "ShapeMeshes.h"
+#include "PrimitiveMeshes.h"
+#include "TransformCache.h"
+#include "RenderQueue.h"
+#include "ViewManager.h"
+#include "UniformCache.h"
+#include "TextureArrays.h"
+#include "TextureLoader.h"
+#include "BoundingVolumeHierarchy.h"
+#include "OcclusionQueries.h"
+#include "ClusteredLighting.h"
+#include "LightManager.h"
+#include "ShadowCascades.h"
+#include "FrameProfiler.h"
+#include "GpuCulling.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /***********************************************************
@@ -45,29 +59,245 @@ public:
 		std::string tag;
 	};
 
+	// one object in the retained scene, built once and
+	// drawn every frame
+	struct RENDER_ITEM
+	{
+		MESH_KIND mesh;
+		// index of the cached model matrix in the transform cache
+		int transformIndex;
+		glm::vec4 color;
+		// -1 when the object is drawn with its color
+		int textureSlot;
+		// -1 when no material is applied
+		int materialIndex;
+		glm::vec2 uvScale;
+		// true when the item is drawn by an instance batch
+		bool bInstanced;
+		// true when the item is large enough to hide other items
+		// and is drawn into the occlusion depth prepass
+		bool bOccluder;
+		// level of detail chosen from the size of the item on screen
+		int lod;
+	};
+
+	// group of render items sharing a mesh and a surface,
+	// drawn together with one instanced draw call
+	struct INSTANCE_BATCH
+	{
+		MESH_KIND mesh;
+		glm::vec4 color;
+		int textureSlot;
+		glm::vec2 uvScale;
+		// indices of the grouped render items
+		std::vector<int> items;
+		// draw data record of each grouped item
+		std::vector<PrimitiveMeshes::INSTANCE_DATA> instances;
+	};
+
+	// counters describing the last rendered frame
+	struct RENDER_STATS
+	{
+		int drawCalls;
+		// shader state values that were uploaded
+		int stateChanges;
+		// shader state values that were already set and skipped
+		int stateChangesSkipped;
+		// render items outside of the view frustum
+		int culledItems;
+		// render items inside the view frustum but hidden behind
+		// the occluders
+		int occludedItems;
+		// render items and triangles drawn at each level of detail
+		int lodItems[PrimitiveMeshes::LOD_COUNT];
+		int lodTriangles[PrimitiveMeshes::LOD_COUNT];
+		// point lights, and their entries in the light clusters
+		int pointLights;
+		int lightAssignments;
+		// bytes of scene light values sent to the light buffer
+		int lightBytesUploaded;
+		// casters drawn into all the shadow cascades, and the draw
+		// calls they took
+		int shadowCasters;
+		int shadowDrawCalls;
+		// time spent on the shadow pass by the CPU submitting it,
+		// and by the GPU rendering it
+		float shadowPassCpuMs;
+		float shadowPassGpuMs;
+		// bytes of draw data written into the ring buffer, and
+		// 1 when the frame had to wait for its region
+		int drawDataBytes;
+		int drawDataStalls;
+		// draws submitted through multi-draw-indirect calls,
+		// which count as one draw call each
+		int indirectCommands;
+	};
+
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
+	// pointer to view manager object, used for the camera
+	ViewManager* m_pViewManager;
+	// pointer to the cached uniform locations of the shader
+	UniformCache* m_pUniformCache;
+	// pointer to the profiler measuring the render passes
+	FrameProfiler* m_pFrameProfiler;
+
+	// pre-resolved handles of the uniforms set on every draw
+	struct SCENE_UNIFORMS
+	{
+		UniformCache::UNIFORM_HANDLE objectTexture;
+		UniformCache::UNIFORM_HANDLE objectTextureArray;
+		UniformCache::UNIFORM_HANDLE textureLayer;
+		UniformCache::UNIFORM_HANDLE useTexture;
+		UniformCache::UNIFORM_HANDLE useInstancing;
+		UniformCache::UNIFORM_HANDLE materialIndex;
+		UniformCache::UNIFORM_HANDLE useLighting;
+		UniformCache::UNIFORM_HANDLE view;
+		UniformCache::UNIFORM_HANDLE projection;
+	};
+	SCENE_UNIFORMS m_uniforms;
+	// pointer to the instanced basic shapes object
+	PrimitiveMeshes* m_primitiveMeshes;
+	// loaded textures info, indexed by texture slot
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// texture slot of each loaded texture tag
+	std::unordered_map<std::string, int> m_textureSlots;
+	// number of texture slots that stay bound to their own
+	// texture unit - the remaining slots share the last unit
+	int m_residentTextureUnits;
+	// true when the textures are packed into texture arrays
+	bool m_bUseTextureArrays;
+	// true when the draws are submitted with multi-draw-indirect
+	bool m_bUseMultiDraw;
+	// true when the instanced items are culled on the GPU
+	bool m_bUseGpuCulling;
+	// compute shader culling of the instanced items
+	GpuCulling m_gpuCulling;
+	// mesh buffer version the culling commands were built for
+	int m_cullingBufferVersion;
+	// texture arrays holding the loaded textures
+	TextureArrays m_textureArrays;
+	// loader decoding the texture files in parallel
+	TextureLoader m_textureLoader;
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// index of each defined material tag
+	std::unordered_map<std::string, int> m_materialIndices;
+
+	// std140 layout of one material in the material buffer
+	struct GPU_MATERIAL
+	{
+		glm::vec3 ambientColor;
+		float ambientStrength;
+		glm::vec3 diffuseColor;
+		float padding;
+		glm::vec3 specularColor;
+		float shininess;
+	};
+	// uniform buffer holding every defined material
+	GLuint m_materialBuffer;
+	// retained scene objects walked by RenderScene()
+	std::vector<RENDER_ITEM> m_renderItems;
+	// cached model matrices of the retained scene objects
+	TransformCache m_transforms;
+	// groups of render items drawn with instancing
+	std::vector<INSTANCE_BATCH> m_instanceBatches;
+	// true when the instance data needs to be refreshed
+	bool m_bInstancesChanged;
+	// sorted draw commands of the current frame
+	RenderQueue m_renderQueue;
+	// world space bounds of each render item
+	std::vector<BOUNDING_BOX> m_itemBounds;
+	// tree over the render item bounds used for culling
+	BoundingVolumeHierarchy m_boundingVolumes;
+	// view frustum of the current frame
+	Frustum m_frustum;
+	// 1 for each render item inside the view frustum
+	std::vector<char> m_itemVisible;
+	// occlusion queries of the render items
+	OcclusionQueries m_occlusionQueries;
+	// true when occlusion culling was used for the last frame
+	bool m_bOcclusionActive;
+	// visible instances of a batch, gathered for drawing at
+	// each level of detail
+	std::vector<PrimitiveMeshes::INSTANCE_DATA> m_visibleInstances[PrimitiveMeshes::LOD_COUNT];
+	// scene light sources, kept in a uniform buffer
+	LightManager m_lightManager;
+	// point lights, binned into clusters of the view every frame
+	ClusteredLighting m_clusteredLighting;
+	// number of yard lamps added to the scene lights
+	int m_yardLampCount;
+	// number of generated objects that replace the scene
+	// objects, 0 for the normal scene
+	int m_generatedObjectCount;
+	// shadow maps of the directional scene light
+	ShadowCascades m_shadowCascades;
+	// requested shadow map size and cascade count, applied to
+	// the shadow maps on the next frame
+	int m_shadowResolution;
+	int m_shadowCascadeCount;
+	// 1 for each render item casting into the current cascade
+	std::vector<char> m_shadowCasters;
+	// bounds around every render item in the scene
+	BOUNDING_BOX m_sceneBounds;
+	// counters for the last rendered frame
+	RENDER_STATS m_renderStats;
+
+	// shader state values that were last uploaded, used to skip
+	// uploads of values the shader already has
+	struct SHADER_STATE
+	{
+		bool bValid;
+		bool bUseTexture;
+		int textureSlot;
+	};
+	SHADER_STATE m_shaderState;
 
 	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
+	bool CreateGLTexture(const char* filename, const std::string& tag);
+	// create a texture from already decoded image data
+	bool UploadGLTexture(
+		const char* filename,
+		const unsigned char* image,
+		int width,
+		int height,
+		int colorChannels,
+		const std::string& tag,
+		const std::string& cachePath);
+	// create a texture from a mapped compressed cache file
+	bool UploadCachedTexture(
+		const char* filename,
+		const TextureCache* pCachedTexture,
+		const std::string& tag);
+	// register a created texture under its tag
+	void RegisterGLTexture(GLuint textureID, const std::string& tag);
+	// decode and load every texture added to the texture loader
+	void LoadQueuedTextures();
 	// bind loaded OpenGL textures to slots in memory
 	void BindGLTextures();
 	// free the loaded OpenGL textures
 	void DestroyGLTextures();
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureID(const std::string& tag);
+	int FindTextureSlot(const std::string& tag);
+	// bind a texture slot for drawing and return its texture unit
+	int BindTextureSlot(int textureSlot);
+	// select a texture slot in the shader for the next draw
+	void ApplyTextureSlot(int textureSlot);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	bool FindMaterial(const std::string& tag, OBJECT_MATERIAL& material);
+	int FindMaterialIndex(const std::string& tag);
+	// index the tags of the defined materials
+	void IndexObjectMaterials();
+
+	// calculate the model matrix from the transformation values
+	glm::mat4 ComputeModelMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
 
 	// set the transformation values 
 	// into the transform buffer
@@ -87,7 +317,7 @@ private:
 
 	// set the texture data into the shader
 	void SetShaderTexture(
-		std::string textureTag);
+		const std::string& textureTag);
 
 	// set the UV scale for the texture mapping
 	void SetTextureUVScale(
@@ -95,7 +325,82 @@ private:
 
 	// set the object material into the shader
 	void SetShaderMaterial(
-		std::string materialTag);
+		const std::string& materialTag);
+	// select an already resolved material in the shader
+	void ApplyMaterial(
+		int materialIndex);
+
+	// add an object to the retained scene
+	int AddRenderItem(
+		MESH_KIND mesh,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ,
+		glm::vec4 color,
+		const std::string& textureTag,
+		const std::string& materialTag);
+	// attach a render item so it follows a parent render item
+	bool AttachRenderItem(int childItem, int parentItem);
+	// mark a render item as a large occluder of other items
+	void SetRenderItemOccluder(int item);
+	// fill the draw data record of a render item
+	void GetItemDrawData(int item, PrimitiveMeshes::INSTANCE_DATA& instance) const;
+
+	// free the meshes that no render item draws
+	void UnloadUnusedMeshes();
+	// group the render items that can be drawn with instancing
+	void BuildInstanceBatches();
+	// refresh the instance data from the transform cache
+	void UpdateInstanceBatches();
+	// send the instanced items to the compute culling
+	void UploadGpuCullingObjects();
+	// pack all the defined materials into the material buffer
+	void UploadMaterialBuffer();
+
+	// add a point light that fades out at the passed in radius
+	int AddPointLight(
+		const glm::vec3& position,
+		float radius,
+		const glm::vec3& color);
+	// scatter the requested number of lamps over the yard
+	void AddYardLamps();
+	// lay out the requested number of generated objects
+	void BuildGeneratedObjects();
+
+	// calculate the world space bounds of the render items
+	void UpdateItemBounds();
+	// build the bounding volume tree over the render items
+	void BuildBoundingVolumes();
+	// find the render items inside the view frustum
+	void CullRenderItems();
+	// draw the occluders into the depth buffer and query which
+	// of the other render items are hidden behind them
+	void RenderOcclusionQueries();
+	// draw a box in the place of a render item's bounds
+	void DrawBoundsProxy(const BOUNDING_BOX& bounds);
+	// leave out the render items hidden in the last query results
+	void HideOccludedItems();
+	// choose the level of detail of each visible render item
+	void SelectItemLods();
+	// draw the shadow casters of every cascade into the shadow maps
+	void RenderShadowPass();
+	// draw the render items casting into one cascade
+	void RenderShadowCascade(int cascade);
+	// write and draw the records of one or more mesh copies,
+	// or queue them when multi-draw is enabled
+	void DrawItemRecords(
+		MESH_KIND mesh,
+		int lod,
+		const PrimitiveMeshes::INSTANCE_DATA* instances,
+		int instanceCount);
+
+	// fill the render queue with sorted draw commands
+	void BuildRenderQueue();
+	// set the texture of the next draw into the shader,
+	// skipping the values the shader already has
+	void ApplySurfaceState(int textureSlot);
 
 public:
 
@@ -104,6 +409,39 @@ public:
 	void PrepareScene();
 	void RenderScene();
 
+	// define the objects of the retained scene
+	void BuildSceneObjects();
+
+	// set the view manager used for the camera position
+	void SetViewManager(ViewManager* pViewManager);
+	// set the cached uniform locations used for drawing
+	void SetUniformCache(UniformCache* pUniformCache);
+	// set the profiler that measures the render passes
+	void SetFrameProfiler(FrameProfiler* pFrameProfiler);
+	// pack the textures into texture arrays - must be set
+	// before the scene is prepared
+	void SetTextureArraysEnabled(bool bEnabled);
+	// submit the draws of each pass with multi-draw-indirect
+	void SetMultiDrawEnabled(bool bEnabled);
+	// cull the instanced objects with a compute shader - must
+	// be set before the scene is prepared
+	void SetGpuCullingEnabled(bool bEnabled);
+	// set the number of point lights scattered over the yard -
+	// must be set before the scene is prepared
+	void SetYardLampCount(int lampCount);
+	// replace the scene objects with a grid of the passed in
+	// number of generated objects, for measuring scenes of any
+	// size - must be set before the scene is prepared
+	void SetGeneratedObjectCount(int objectCount);
+	// get the number of objects in the scene
+	int GetRenderItemCount() const;
+	// set the size of the shadow maps and the number of shadow
+	// cascades - a cascade count of 0 switches the shadows off,
+	// and a negative value keeps the current setting
+	void SetShadowSettings(int resolution, int cascadeCount);
+	// get the counters of the last rendered frame
+	const RENDER_STATS& GetRenderStats() const;
+
 	// loads textures from image files
 	void LoadSceneTextures();
 
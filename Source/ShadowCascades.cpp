@@ -0,0 +1,530 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowcascades.cpp
+// ============
+// render the shadows of the directional light with cascaded shadow maps
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShadowCascades.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// declaration of global variables
+namespace
+{
+	// the shadows end at this view depth, or at the far plane
+	// when it is closer
+	const float g_ShadowDistance = 60.0f;
+	// blend between logarithmic splits, which give every cascade
+	// the same texel density, and even splits, which keep the
+	// first cascade from becoming too short
+	const float g_SplitBlend = 0.75f;
+	// the radius of a cascade is rounded up to a multiple of this
+	// size, so the texel size does not change as the camera turns
+	const float g_RadiusStep = 1.0f / 16.0f;
+	// depth bias of the shadow pass, in units of the depth slope
+	// and of the smallest depth step
+	const float g_DepthBiasSlope = 1.5f;
+	const float g_DepthBiasUnits = 4.0f;
+
+	// get the normalized device depth of a view depth
+	float DepthToNdc(const glm::mat4& projection, float depth)
+	{
+		float clipZ = -projection[2][2] * depth + projection[3][2];
+		float clipW = -projection[2][3] * depth + projection[3][3];
+
+		return(clipZ / clipW);
+	}
+
+	// get the last texture unit, which is kept free for the
+	// shadow maps
+	int GetReservedTextureUnit()
+	{
+		GLint textureUnits = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+
+		return(textureUnits - 1);
+	}
+}
+
+/***********************************************************
+ *  ShadowCascades()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShadowCascades::ShadowCascades()
+{
+	m_depthTexture = 0;
+	m_framebuffer = 0;
+	m_resolution = 0;
+	m_cascadeCount = 0;
+	m_textureUnit = 0;
+	for (int c = 0; c < MAX_CASCADES; c++)
+	{
+		m_lightViews[c] = glm::mat4(1.0f);
+		m_lightProjections[c] = glm::mat4(1.0f);
+		m_splitDepths[c] = 0.0f;
+		m_texelSizes[c] = 0.0f;
+	}
+	for (int t = 0; t < TIMER_QUERY_COUNT; t++)
+	{
+		m_timerQueries[t] = 0;
+		m_bTimerIssued[t] = false;
+	}
+	m_currentTimer = 0;
+	m_passMilliseconds = 0.0f;
+	for (int i = 0; i < 4; i++)
+	{
+		m_savedViewport[i] = 0;
+	}
+	m_savedFramebuffer = 0;
+	m_pUniformCache = NULL;
+}
+
+/***********************************************************
+ *  ~ShadowCascades()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShadowCascades::~ShadowCascades()
+{
+	m_pUniformCache = NULL;
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the depth texture array
+ *  and the framebuffer that the cascades are rendered through.
+ *  Any existing shadow maps are freed first.  The texture is
+ *  bound to the last texture unit, which is kept free for it.
+ ***********************************************************/
+bool ShadowCascades::Create(int resolution, int cascadeCount)
+{
+	Destroy();
+
+	if (cascadeCount > MAX_CASCADES)
+	{
+		cascadeCount = MAX_CASCADES;
+	}
+	if ((resolution <= 0) || (cascadeCount <= 0))
+	{
+		return(true);
+	}
+
+	m_textureUnit = GetReservedTextureUnit();
+
+	glGenTextures(1, &m_depthTexture);
+	glActiveTexture(GL_TEXTURE0 + m_textureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_depthTexture);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution, cascadeCount, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+
+	// the hardware compares the depths and filters the results,
+	// and everything outside of a shadow map is lit
+	const float borderColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+	// the framebuffer only has a depth attachment, and the one
+	// the scene is drawn into is bound again afterwards
+	GLint sceneFramebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &sceneFramebuffer);
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture, 0, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)sceneFramebuffer);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Could not create the shadow map framebuffer, status:" << status << std::endl;
+		Destroy();
+		return(false);
+	}
+
+	glGenQueries(TIMER_QUERY_COUNT, m_timerQueries);
+	m_resolution = resolution;
+	m_cascadeCount = cascadeCount;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetResolution()
+ *
+ *  This method is used for getting the width and height of
+ *  each shadow map in texels.
+ ***********************************************************/
+int ShadowCascades::GetResolution() const
+{
+	return(m_resolution);
+}
+
+/***********************************************************
+ *  GetCascadeCount()
+ *
+ *  This method is used for getting the number of cascades,
+ *  which is 0 when the shadows are switched off.
+ ***********************************************************/
+int ShadowCascades::GetCascadeCount() const
+{
+	return(m_cascadeCount);
+}
+
+/***********************************************************
+ *  SetUniformCache()
+ *
+ *  This method is used for setting the cached uniform
+ *  locations of the shader, and for resolving the handles of
+ *  the shadow uniforms.  The shadow map sampler is pointed at
+ *  its reserved unit here, even when the shadows are off, so
+ *  it never shares a unit with a sampler of another type.
+ ***********************************************************/
+void ShadowCascades::SetUniformCache(UniformCache* pUniformCache)
+{
+	m_pUniformCache = pUniformCache;
+
+	if (NULL == m_pUniformCache)
+	{
+		return;
+	}
+
+	m_useShadowsHandle = m_pUniformCache->GetHandle("bUseShadows");
+	m_cascadeCountHandle = m_pUniformCache->GetHandle("shadowCascadeCount");
+	m_shadowMapHandle = m_pUniformCache->GetHandle("shadowMap");
+	for (int c = 0; c < MAX_CASCADES; c++)
+	{
+		std::string element = "[" + std::to_string(c) + "]";
+		m_splitDepthHandles[c] = m_pUniformCache->GetHandle("shadowSplitDepths" + element);
+		m_matrixHandles[c] = m_pUniformCache->GetHandle("shadowMatrices" + element);
+		m_texelSizeHandles[c] = m_pUniformCache->GetHandle("shadowTexelSizes" + element);
+	}
+
+	m_textureUnit = GetReservedTextureUnit();
+	m_pUniformCache->SetInt(m_shadowMapHandle, m_textureUnit);
+}
+
+/***********************************************************
+ *  FitCascade()
+ *
+ *  This method is used for fitting the light view and the
+ *  orthographic projection of a cascade around the slice of
+ *  the view frustum between two normalized device depths.
+ *  The projection is a square around the bounding sphere of
+ *  the slice, so its size does not change as the camera
+ *  turns, and it is moved in whole texels, so the shadow
+ *  edges do not crawl as the camera moves.  The depth range
+ *  reaches back to the scene bounds toward the light, so
+ *  casters outside of the slice still shadow it.
+ ***********************************************************/
+void ShadowCascades::FitCascade(
+	int cascade,
+	const glm::mat4& inverseViewProjection,
+	float nearNdc,
+	float farNdc,
+	const glm::vec3& lightDirection,
+	const BOUNDING_BOX& sceneBounds)
+{
+	glm::vec3 corners[8];
+	glm::vec3 center(0.0f);
+
+	for (int corner = 0; corner < 8; corner++)
+	{
+		glm::vec4 ndc(
+			(corner & 1) ? 1.0f : -1.0f,
+			(corner & 2) ? 1.0f : -1.0f,
+			(corner & 4) ? farNdc : nearNdc,
+			1.0f);
+		glm::vec4 world = inverseViewProjection * ndc;
+
+		corners[corner] = glm::vec3(world) / world.w;
+		center += corners[corner];
+	}
+	center = center / 8.0f;
+
+	float radius = 0.0f;
+	for (int corner = 0; corner < 8; corner++)
+	{
+		radius = glm::max(radius, glm::length(corners[corner] - center));
+	}
+	radius = ceilf(radius / g_RadiusStep) * g_RadiusStep;
+
+	// the up vector only has to differ from the light direction
+	glm::vec3 up(0.0f, 1.0f, 0.0f);
+	if (fabsf(lightDirection.y) > 0.99f)
+	{
+		up = glm::vec3(0.0f, 0.0f, 1.0f);
+	}
+	glm::mat4 lightView = glm::lookAt(center, center + lightDirection, up);
+
+	// everything between the light and the slice can cast
+	float nearPlane = -radius;
+	for (int corner = 0; corner < 8; corner++)
+	{
+		glm::vec3 sceneCorner(
+			(corner & 1) ? sceneBounds.maximum.x : sceneBounds.minimum.x,
+			(corner & 2) ? sceneBounds.maximum.y : sceneBounds.minimum.y,
+			(corner & 4) ? sceneBounds.maximum.z : sceneBounds.minimum.z);
+		glm::vec4 lightSpace = lightView * glm::vec4(sceneCorner, 1.0f);
+
+		nearPlane = glm::min(nearPlane, -lightSpace.z);
+	}
+	glm::mat4 lightProjection = glm::ortho(-radius, radius, -radius, radius, nearPlane, radius);
+
+	// move the projection so the world origin falls on a texel
+	float halfResolution = m_resolution * 0.5f;
+	glm::vec4 origin = lightProjection * lightView * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	float offsetX = floorf(origin.x * halfResolution + 0.5f) - origin.x * halfResolution;
+	float offsetY = floorf(origin.y * halfResolution + 0.5f) - origin.y * halfResolution;
+	lightProjection[3][0] += offsetX / halfResolution;
+	lightProjection[3][1] += offsetY / halfResolution;
+
+	m_lightViews[cascade] = lightView;
+	m_lightProjections[cascade] = lightProjection;
+	m_cascadeFrustums[cascade].ExtractPlanes(lightProjection * lightView);
+	m_texelSizes[cascade] = 2.0f * radius / m_resolution;
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used for splitting the view frustum into
+ *  the cascades, fitting each cascade to its slice, and
+ *  setting the shadow values into the shader.  The shader
+ *  chooses the cascade of a pixel by its view depth.
+ ***********************************************************/
+void ShadowCascades::Update(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	const glm::vec3& lightDirection,
+	const BOUNDING_BOX& sceneBounds)
+{
+	if ((NULL == m_pUniformCache) || (m_cascadeCount == 0))
+	{
+		Disable();
+		return;
+	}
+
+	// the near and far planes are taken from the projection, for
+	// both the perspective and the orthographic projection
+	float nearPlane = 0.0f;
+	float farPlane = 0.0f;
+	if (projection[2][3] != 0.0f)
+	{
+		nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+		farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+	}
+	else
+	{
+		nearPlane = (projection[3][2] + 1.0f) / projection[2][2];
+		farPlane = (projection[3][2] - 1.0f) / projection[2][2];
+	}
+	nearPlane = glm::max(nearPlane, 0.01f);
+	farPlane = glm::max(glm::min(farPlane, g_ShadowDistance), nearPlane + 0.01f);
+
+	glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+	glm::vec3 direction = glm::normalize(lightDirection);
+	float sliceStart = nearPlane;
+
+	for (int c = 0; c < m_cascadeCount; c++)
+	{
+		float fraction = (float)(c + 1) / m_cascadeCount;
+		float logSplit = nearPlane * powf(farPlane / nearPlane, fraction);
+		float evenSplit = nearPlane + (farPlane - nearPlane) * fraction;
+
+		m_splitDepths[c] = g_SplitBlend * logSplit + (1.0f - g_SplitBlend) * evenSplit;
+		FitCascade(
+			c,
+			inverseViewProjection,
+			DepthToNdc(projection, sliceStart),
+			DepthToNdc(projection, m_splitDepths[c]),
+			direction,
+			sceneBounds);
+		sliceStart = m_splitDepths[c];
+	}
+
+	glActiveTexture(GL_TEXTURE0 + m_textureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_depthTexture);
+
+	m_pUniformCache->SetBool(m_useShadowsHandle, true);
+	m_pUniformCache->SetInt(m_cascadeCountHandle, m_cascadeCount);
+	for (int c = 0; c < m_cascadeCount; c++)
+	{
+		m_pUniformCache->SetFloat(m_splitDepthHandles[c], m_splitDepths[c]);
+		m_pUniformCache->SetMat4(m_matrixHandles[c], m_lightProjections[c] * m_lightViews[c]);
+		m_pUniformCache->SetFloat(m_texelSizeHandles[c], m_texelSizes[c]);
+	}
+}
+
+/***********************************************************
+ *  Disable()
+ *
+ *  This method is used for stopping the shader from reading
+ *  the shadow maps, so every pixel is lit.
+ ***********************************************************/
+void ShadowCascades::Disable()
+{
+	if (NULL != m_pUniformCache)
+	{
+		m_pUniformCache->SetBool(m_useShadowsHandle, false);
+	}
+}
+
+/***********************************************************
+ *  GetLightView()
+ *
+ *  This method is used for getting the light view of a
+ *  cascade.
+ ***********************************************************/
+const glm::mat4& ShadowCascades::GetLightView(int cascade) const
+{
+	return(m_lightViews[cascade]);
+}
+
+/***********************************************************
+ *  GetLightProjection()
+ *
+ *  This method is used for getting the light projection of
+ *  a cascade.
+ ***********************************************************/
+const glm::mat4& ShadowCascades::GetLightProjection(int cascade) const
+{
+	return(m_lightProjections[cascade]);
+}
+
+/***********************************************************
+ *  GetCascadeFrustum()
+ *
+ *  This method is used for getting the volume seen by a
+ *  cascade, which holds every object that can cast a shadow
+ *  into it.
+ ***********************************************************/
+const Frustum& ShadowCascades::GetCascadeFrustum(int cascade) const
+{
+	return(m_cascadeFrustums[cascade]);
+}
+
+/***********************************************************
+ *  BeginPass()
+ *
+ *  This method is used for starting the shadow pass.  The
+ *  time of the last pass is read from its timer query when
+ *  the result has already arrived, so this never stalls, and
+ *  the GPU time of this pass is measured with the other query.
+ ***********************************************************/
+void ShadowCascades::BeginPass()
+{
+	GLuint timer = m_timerQueries[m_currentTimer];
+
+	if (m_bTimerIssued[m_currentTimer] == true)
+	{
+		GLuint available = GL_FALSE;
+
+		glGetQueryObjectuiv(timer, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == GL_TRUE)
+		{
+			GLuint64 elapsedNanoseconds = 0;
+			glGetQueryObjectui64v(timer, GL_QUERY_RESULT, &elapsedNanoseconds);
+			m_passMilliseconds = (float)(elapsedNanoseconds / 1000000.0);
+		}
+	}
+	glBeginQuery(GL_TIME_ELAPSED, timer);
+	m_bTimerIssued[m_currentTimer] = true;
+
+	glGetIntegerv(GL_VIEWPORT, m_savedViewport);
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_savedFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, m_resolution, m_resolution);
+
+	// the bias keeps the lit surfaces from shadowing themselves
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	glPolygonOffset(g_DepthBiasSlope, g_DepthBiasUnits);
+}
+
+/***********************************************************
+ *  BeginCascade()
+ *
+ *  This method is used for selecting the shadow map layer of
+ *  a cascade for the following draws, and clearing it.
+ ***********************************************************/
+void ShadowCascades::BeginCascade(int cascade)
+{
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture, 0, cascade);
+	glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+/***********************************************************
+ *  EndPass()
+ *
+ *  This method is used for ending the shadow pass, restoring
+ *  the framebuffer and the viewport the scene is drawn into.
+ ***********************************************************/
+void ShadowCascades::EndPass()
+{
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)m_savedFramebuffer);
+	glViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+
+	glEndQuery(GL_TIME_ELAPSED);
+	m_currentTimer = (m_currentTimer + 1) % TIMER_QUERY_COUNT;
+}
+
+/***********************************************************
+ *  GetPassMilliseconds()
+ *
+ *  This method is used for getting the GPU time of the last
+ *  shadow pass whose timer query has been read, which is
+ *  one or two frames behind the current frame.
+ ***********************************************************/
+float ShadowCascades::GetPassMilliseconds() const
+{
+	return(m_passMilliseconds);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for freeing the depth texture array,
+ *  the framebuffer and the timer queries.
+ ***********************************************************/
+void ShadowCascades::Destroy()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_depthTexture != 0)
+	{
+		glDeleteTextures(1, &m_depthTexture);
+		m_depthTexture = 0;
+	}
+	if (m_timerQueries[0] != 0)
+	{
+		glDeleteQueries(TIMER_QUERY_COUNT, m_timerQueries);
+		for (int t = 0; t < TIMER_QUERY_COUNT; t++)
+		{
+			m_timerQueries[t] = 0;
+			m_bTimerIssued[t] = false;
+		}
+	}
+	m_currentTimer = 0;
+	m_passMilliseconds = 0.0f;
+	m_resolution = 0;
+	m_cascadeCount = 0;
+	Disable();
+}
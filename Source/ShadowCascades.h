@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowcascades.h
+// ============
+// render the shadows of the directional light with cascaded shadow maps
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Frustum.h"
+#include "UniformCache.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  ShadowCascades
+ *
+ *  This class owns the shadow maps of the directional light.
+ *  The view frustum is cut into slices by view depth, and
+ *  each slice - a cascade - gets its own layer of a depth
+ *  texture array, rendered with an orthographic projection
+ *  fitted around the slice.  Near slices are small, so the
+ *  shadows close to the camera get the most texels.
+ ***********************************************************/
+class ShadowCascades
+{
+public:
+	// constructor
+	ShadowCascades();
+	// destructor
+	~ShadowCascades();
+
+	// largest number of cascades, which must match the define
+	// of the fragment shader
+	static const int MAX_CASCADES = 4;
+	// number of timer queries used in turn for the shadow pass
+	static const int TIMER_QUERY_COUNT = 2;
+
+private:
+	// depth texture array with one layer per cascade
+	GLuint m_depthTexture;
+	// framebuffer the cascades are rendered through
+	GLuint m_framebuffer;
+	// width and height of each shadow map in texels
+	int m_resolution;
+	// number of cascades in use
+	int m_cascadeCount;
+	// texture unit the depth texture array is bound to
+	int m_textureUnit;
+
+	// light view and projection of each cascade
+	glm::mat4 m_lightViews[MAX_CASCADES];
+	glm::mat4 m_lightProjections[MAX_CASCADES];
+	// volume seen by each cascade, used for culling the casters
+	Frustum m_cascadeFrustums[MAX_CASCADES];
+	// view depth at which each cascade ends
+	float m_splitDepths[MAX_CASCADES];
+	// world space size of one shadow map texel of each cascade
+	float m_texelSizes[MAX_CASCADES];
+
+	// timer queries measuring the GPU time of the shadow pass
+	GLuint m_timerQueries[TIMER_QUERY_COUNT];
+	bool m_bTimerIssued[TIMER_QUERY_COUNT];
+	int m_currentTimer;
+	float m_passMilliseconds;
+	// viewport and framebuffer that are restored after the
+	// shadow pass
+	GLint m_savedViewport[4];
+	GLint m_savedFramebuffer;
+
+	// pointer to the cached uniform locations of the shader
+	UniformCache* m_pUniformCache;
+	// pre-resolved handles of the shadow uniforms
+	UniformCache::UNIFORM_HANDLE m_useShadowsHandle;
+	UniformCache::UNIFORM_HANDLE m_cascadeCountHandle;
+	UniformCache::UNIFORM_HANDLE m_shadowMapHandle;
+	UniformCache::UNIFORM_HANDLE m_splitDepthHandles[MAX_CASCADES];
+	UniformCache::UNIFORM_HANDLE m_matrixHandles[MAX_CASCADES];
+	UniformCache::UNIFORM_HANDLE m_texelSizeHandles[MAX_CASCADES];
+
+	// fit the light view and projection of one cascade around
+	// a slice of the view frustum
+	void FitCascade(
+		int cascade,
+		const glm::mat4& inverseViewProjection,
+		float nearNdc,
+		float farNdc,
+		const glm::vec3& lightDirection,
+		const BOUNDING_BOX& sceneBounds);
+
+public:
+	// create the shadow maps, replacing any existing ones - a
+	// cascade count of 0 switches the shadows off
+	bool Create(int resolution, int cascadeCount);
+	// get the settings of the created shadow maps
+	int GetResolution() const;
+	int GetCascadeCount() const;
+
+	// set the cached uniform locations used for the shadow values
+	void SetUniformCache(UniformCache* pUniformCache);
+
+	// fit the cascades to the current view and set the shadow
+	// values into the shader
+	void Update(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		const glm::vec3& lightDirection,
+		const BOUNDING_BOX& sceneBounds);
+	// stop the shader from reading the shadow maps
+	void Disable();
+
+	// get the light view and projection of a cascade
+	const glm::mat4& GetLightView(int cascade) const;
+	const glm::mat4& GetLightProjection(int cascade) const;
+	// get the volume seen by a cascade
+	const Frustum& GetCascadeFrustum(int cascade) const;
+
+	// render into the shadow maps between these calls
+	void BeginPass();
+	void BeginCascade(int cascade);
+	void EndPass();
+	// get the GPU time of the last measured shadow pass
+	float GetPassMilliseconds() const;
+
+	// free the shadow maps and the timer queries
+	void Destroy();
+};
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.cpp
+// ============
+// pack the scene textures into layers of 2D texture arrays
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureArrays.h"
+
+#include <iostream>
+
+/***********************************************************
+ *  TextureArrays()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureArrays::TextureArrays()
+{
+	m_firstUnit = 0;
+}
+
+/***********************************************************
+ *  ~TextureArrays()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureArrays::~TextureArrays()
+{
+	DestroyArrays();
+}
+
+/***********************************************************
+ *  AddImage()
+ *
+ *  This method is used for adding a loaded image, which is
+ *  kept as RGBA pixels until the texture arrays are built.
+ *  The array and layer of the image are chosen here - every
+ *  image with the same size goes into the same array.
+ ***********************************************************/
+int TextureArrays::AddImage(
+	const unsigned char* image,
+	int width,
+	int height,
+	int colorChannels)
+{
+	if ((colorChannels != 3) && (colorChannels != 4))
+	{
+		std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
+		return(-1);
+	}
+
+	int arrayIndex = -1;
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		if ((m_arrays[i].width == width) && (m_arrays[i].height == height))
+		{
+			arrayIndex = (int)i;
+			break;
+		}
+	}
+	if (arrayIndex < 0)
+	{
+		TEXTURE_ARRAY textureArray;
+		textureArray.ID = 0;
+		textureArray.width = width;
+		textureArray.height = height;
+		textureArray.layerCount = 0;
+		m_arrays.push_back(textureArray);
+		arrayIndex = (int)m_arrays.size() - 1;
+	}
+
+	// all the layers of an array share one format, so RGB images
+	// are expanded to RGBA
+	PENDING_IMAGE pending;
+	pending.pixels.resize((size_t)width * height * 4);
+	for (size_t pixel = 0; pixel < (size_t)width * height; pixel++)
+	{
+		pending.pixels[pixel * 4 + 0] = image[pixel * colorChannels + 0];
+		pending.pixels[pixel * 4 + 1] = image[pixel * colorChannels + 1];
+		pending.pixels[pixel * 4 + 2] = image[pixel * colorChannels + 2];
+		pending.pixels[pixel * 4 + 3] = (colorChannels == 4) ? image[pixel * colorChannels + 3] : 255;
+	}
+	m_pendingImages.push_back(pending);
+
+	TEXTURE_LAYER textureLayer;
+	textureLayer.arrayIndex = arrayIndex;
+	textureLayer.layer = m_arrays[arrayIndex].layerCount;
+	m_arrays[arrayIndex].layerCount++;
+	m_layers.push_back(textureLayer);
+
+	return((int)m_layers.size() - 1);
+}
+
+/***********************************************************
+ *  BuildArrays()
+ *
+ *  This method is used for creating the texture arrays,
+ *  uploading the added images into their layers, and binding
+ *  each array to its own texture unit, starting at the passed
+ *  in unit.  The image pixels are freed once uploaded.
+ ***********************************************************/
+bool TextureArrays::BuildArrays(int firstUnit)
+{
+	GLint textureUnits = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+	// the very last unit holds the shadow maps
+	textureUnits--;
+
+	if (firstUnit + (int)m_arrays.size() > textureUnits)
+	{
+		std::cout << "Not enough texture units for " << m_arrays.size() << " texture array sizes" << std::endl;
+		return(false);
+	}
+
+	m_firstUnit = firstUnit;
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		TEXTURE_ARRAY& textureArray = m_arrays[i];
+
+		glGenTextures(1, &textureArray.ID);
+		glActiveTexture(GL_TEXTURE0 + m_firstUnit + (GLenum)i);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.ID);
+
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters - the mipmaps generated
+		// below are sampled for distant surfaces
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glTexImage3D(
+			GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8,
+			textureArray.width, textureArray.height, textureArray.layerCount,
+			0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	}
+
+	for (size_t i = 0; i < m_layers.size(); i++)
+	{
+		const TEXTURE_ARRAY& textureArray = m_arrays[m_layers[i].arrayIndex];
+
+		glActiveTexture(GL_TEXTURE0 + m_firstUnit + (GLenum)m_layers[i].arrayIndex);
+		glTexSubImage3D(
+			GL_TEXTURE_2D_ARRAY, 0,
+			0, 0, m_layers[i].layer,
+			textureArray.width, textureArray.height, 1,
+			GL_RGBA, GL_UNSIGNED_BYTE, m_pendingImages[i].pixels.data());
+	}
+	m_pendingImages.clear();
+
+	// generate the texture mipmaps for mapping textures to lower resolutions
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		glActiveTexture(GL_TEXTURE0 + m_firstUnit + (GLenum)i);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyArrays()
+ *
+ *  This method is used for freeing the created texture arrays
+ *  along with any images that were never uploaded.
+ ***********************************************************/
+void TextureArrays::DestroyArrays()
+{
+	for (size_t i = 0; i < m_arrays.size(); i++)
+	{
+		if (m_arrays[i].ID != 0)
+		{
+			glDeleteTextures(1, &m_arrays[i].ID);
+		}
+	}
+	m_arrays.clear();
+	m_layers.clear();
+	m_pendingImages.clear();
+}
+
+/***********************************************************
+ *  GetTextureUnit()
+ *
+ *  This method is used for getting the texture unit of the
+ *  array holding an added texture.
+ ***********************************************************/
+int TextureArrays::GetTextureUnit(int textureIndex) const
+{
+	return(m_firstUnit + m_layers[textureIndex].arrayIndex);
+}
+
+/***********************************************************
+ *  GetTextureLayer()
+ *
+ *  This method is used for getting the layer of an added
+ *  texture inside its texture array.
+ ***********************************************************/
+int TextureArrays::GetTextureLayer(int textureIndex) const
+{
+	return(m_layers[textureIndex].layer);
+}
+
+/***********************************************************
+ *  GetArrayCount()
+ *
+ *  This method is used for getting the number of created
+ *  texture arrays.
+ ***********************************************************/
+int TextureArrays::GetArrayCount() const
+{
+	return((int)m_arrays.size());
+}
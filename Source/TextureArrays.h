@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturearrays.h
+// ============
+// pack the scene textures into layers of 2D texture arrays
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  TextureArrays
+ *
+ *  This class packs loaded images of the same size into the
+ *  layers of one GL_TEXTURE_2D_ARRAY.  Each array stays bound
+ *  to its own texture unit, so a texture is selected by its
+ *  array unit and layer index instead of by rebinding, and
+ *  the number of textures is no longer limited by the number
+ *  of texture units.
+ ***********************************************************/
+class TextureArrays
+{
+public:
+	// constructor
+	TextureArrays();
+	// destructor
+	~TextureArrays();
+
+	// location of one added texture
+	struct TEXTURE_LAYER
+	{
+		// index of the texture array holding the texture
+		int arrayIndex;
+		// layer of the texture inside the array
+		int layer;
+	};
+
+private:
+	// one texture array, holding every image of one size
+	struct TEXTURE_ARRAY
+	{
+		GLuint ID;
+		int width;
+		int height;
+		int layerCount;
+	};
+
+	// RGBA pixels of an added image, kept until the arrays
+	// are built
+	struct PENDING_IMAGE
+	{
+		std::vector<unsigned char> pixels;
+	};
+
+	// created texture arrays
+	std::vector<TEXTURE_ARRAY> m_arrays;
+	// location of every added texture, in the order added
+	std::vector<TEXTURE_LAYER> m_layers;
+	// images waiting to be uploaded, in the order added
+	std::vector<PENDING_IMAGE> m_pendingImages;
+	// texture unit of the first texture array
+	int m_firstUnit;
+
+public:
+	// add an image and return its texture index
+	int AddImage(
+		const unsigned char* image,
+		int width,
+		int height,
+		int colorChannels);
+	// upload the added images and bind each array to a unit
+	bool BuildArrays(int firstUnit);
+	// free the created texture arrays
+	void DestroyArrays();
+
+	// get the texture unit and layer of an added texture
+	int GetTextureUnit(int textureIndex) const;
+	int GetTextureLayer(int textureIndex) const;
+	// get the number of created texture arrays
+	int GetArrayCount() const;
+};
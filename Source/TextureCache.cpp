@@ -0,0 +1,580 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.cpp
+// ============
+// store and load compressed textures with their full mip chain
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// declaration of the DDS file layout
+namespace
+{
+	const uint32_t g_DdsMagic = 0x20534444; // "DDS "
+	const uint32_t g_FourCCDxt1 = 0x31545844; // "DXT1"
+	const uint32_t g_FourCCDxt5 = 0x35545844; // "DXT5"
+
+	// header flags
+	const uint32_t g_DdsdCaps = 0x1;
+	const uint32_t g_DdsdHeight = 0x2;
+	const uint32_t g_DdsdWidth = 0x4;
+	const uint32_t g_DdsdPixelFormat = 0x1000;
+	const uint32_t g_DdsdMipMapCount = 0x20000;
+	const uint32_t g_DdsdLinearSize = 0x80000;
+	// pixel format and surface flags
+	const uint32_t g_DdpfFourCC = 0x4;
+	const uint32_t g_DdsCapsComplex = 0x8;
+	const uint32_t g_DdsCapsTexture = 0x1000;
+	const uint32_t g_DdsCapsMipMap = 0x400000;
+
+	struct DDS_PIXELFORMAT
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t fourCC;
+		uint32_t rgbBitCount;
+		uint32_t rBitMask;
+		uint32_t gBitMask;
+		uint32_t bBitMask;
+		uint32_t aBitMask;
+	};
+
+	struct DDS_HEADER
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t height;
+		uint32_t width;
+		uint32_t pitchOrLinearSize;
+		uint32_t depth;
+		uint32_t mipMapCount;
+		uint32_t reserved1[11];
+		DDS_PIXELFORMAT pixelFormat;
+		uint32_t caps;
+		uint32_t caps2;
+		uint32_t caps3;
+		uint32_t caps4;
+		uint32_t reserved2;
+	};
+
+	// size of one compressed level - the formats store 4x4 blocks
+	size_t CompressedLevelSize(int width, int height, size_t blockSize)
+	{
+		size_t blocksWide = (width + 3) / 4;
+		size_t blocksHigh = (height + 3) / 4;
+
+		if (blocksWide < 1)
+		{
+			blocksWide = 1;
+		}
+		if (blocksHigh < 1)
+		{
+			blocksHigh = 1;
+		}
+
+		return(blocksWide * blocksHigh * blockSize);
+	}
+
+	// number of levels in the full mip chain down to a single pixel
+	int MipLevelCount(int width, int height)
+	{
+		int levelCount = 1;
+		for (int size = (width > height) ? width : height; size > 1; size /= 2)
+		{
+			levelCount++;
+		}
+
+		return(levelCount);
+	}
+}
+
+/***********************************************************
+ *  TextureCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureCache::TextureCache()
+{
+	m_pMapped = NULL;
+	m_mappedSize = 0;
+#ifdef _WIN32
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+#endif
+	m_format = 0;
+}
+
+/***********************************************************
+ *  ~TextureCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureCache::~TextureCache()
+{
+	Close();
+}
+
+/***********************************************************
+ *  HashFile()
+ *
+ *  This method is used for calculating the 64-bit FNV-1a
+ *  hash of the contents of a source file.  Reading the file
+ *  is far cheaper than decoding it.
+ ***********************************************************/
+bool TextureCache::HashFile(const std::string& filename, uint64_t& hash)
+{
+	std::ifstream file(filename.c_str(), std::ios::binary);
+
+	if (!file)
+	{
+		return(false);
+	}
+
+	char buffer[65536];
+	hash = 14695981039346656037ULL;
+	while (file)
+	{
+		file.read(buffer, sizeof(buffer));
+		std::streamsize count = file.gcount();
+		for (std::streamsize i = 0; i < count; i++)
+		{
+			hash ^= (unsigned char)buffer[i];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetCachePath()
+ *
+ *  This method is used for getting the path of the cache
+ *  file that belongs to a source file hash.
+ ***********************************************************/
+std::string TextureCache::GetCachePath(const std::string& cacheDirectory, uint64_t hash)
+{
+	char name[32];
+
+	snprintf(name, sizeof(name), "%016llx.dds", (unsigned long long)hash);
+
+	return(cacheDirectory + "/" + name);
+}
+
+/***********************************************************
+ *  CreateCacheDirectory()
+ *
+ *  This method is used for creating the cache directory when
+ *  it does not exist yet.
+ ***********************************************************/
+void TextureCache::CreateCacheDirectory(const std::string& cacheDirectory)
+{
+#ifdef _WIN32
+	_mkdir(cacheDirectory.c_str());
+#else
+	mkdir(cacheDirectory.c_str(), 0755);
+#endif
+}
+
+/***********************************************************
+ *  GetCompressedFormat()
+ *
+ *  This method is used for getting the compressed internal
+ *  format of an image with the passed in number of channels.
+ *  Images without transparency use the smaller DXT1 format.
+ ***********************************************************/
+GLenum TextureCache::GetCompressedFormat(int colorChannels)
+{
+	if (colorChannels == 4)
+	{
+		return(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+	}
+
+	return(GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+}
+
+/***********************************************************
+ *  CompressBoundTexture()
+ *
+ *  This method is used for compressing every mipmap level of
+ *  the uncompressed texture bound to GL_TEXTURE_2D.  Each
+ *  level is read back and specified again in the compressed
+ *  format, since generating mipmaps for a texture that is
+ *  already compressed is not supported by every driver.  No
+ *  pixel buffer may be bound while the levels are copied.
+ ***********************************************************/
+bool TextureCache::CompressBoundTexture(int colorChannels)
+{
+	GLint width = 0;
+	GLint height = 0;
+
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+	if ((width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+
+	GLenum format = GetCompressedFormat(colorChannels);
+	int levelCount = MipLevelCount(width, height);
+
+	// the level 0 pixels are the largest, so the buffer is
+	// reused for every smaller level
+	std::vector<unsigned char> pixels((size_t)width * height * 4);
+	for (int level = 0; level < levelCount; level++)
+	{
+		GLint levelWidth = 0;
+		GLint levelHeight = 0;
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &levelWidth);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &levelHeight);
+		if ((levelWidth <= 0) || (levelHeight <= 0))
+		{
+			return(false);
+		}
+
+		glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glTexImage2D(GL_TEXTURE_2D, level, format, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  WriteBoundTexture()
+ *
+ *  This method is used for reading the compressed levels of
+ *  the texture bound to GL_TEXTURE_2D back from OpenGL and
+ *  writing them into a DDS file.  The file is written under a
+ *  temporary name first, so an interrupted write never leaves
+ *  a partial cache file behind.
+ ***********************************************************/
+bool TextureCache::WriteBoundTexture(const std::string& filename)
+{
+	GLint bCompressed = 0;
+	GLint format = 0;
+	GLint width = 0;
+	GLint height = 0;
+	uint32_t fourCC = 0;
+
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &bCompressed);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+
+	if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+	{
+		fourCC = g_FourCCDxt1;
+	}
+	else if (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+	{
+		fourCC = g_FourCCDxt5;
+	}
+	if ((bCompressed == 0) || (fourCC == 0) || (width <= 0) || (height <= 0))
+	{
+		return(false);
+	}
+
+	int levelCount = MipLevelCount(width, height);
+
+	std::vector<std::vector<unsigned char> > levels(levelCount);
+	for (int level = 0; level < levelCount; level++)
+	{
+		GLint levelSize = 0;
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &levelSize);
+		if (levelSize <= 0)
+		{
+			return(false);
+		}
+		levels[level].resize(levelSize);
+		glGetCompressedTexImage(GL_TEXTURE_2D, level, levels[level].data());
+	}
+
+	DDS_HEADER header;
+	memset(&header, 0, sizeof(header));
+	header.size = sizeof(DDS_HEADER);
+	header.flags = g_DdsdCaps | g_DdsdHeight | g_DdsdWidth | g_DdsdPixelFormat | g_DdsdMipMapCount | g_DdsdLinearSize;
+	header.height = (uint32_t)height;
+	header.width = (uint32_t)width;
+	header.pitchOrLinearSize = (uint32_t)levels[0].size();
+	header.mipMapCount = (uint32_t)levelCount;
+	header.pixelFormat.size = sizeof(DDS_PIXELFORMAT);
+	header.pixelFormat.flags = g_DdpfFourCC;
+	header.pixelFormat.fourCC = fourCC;
+	header.caps = g_DdsCapsTexture | g_DdsCapsMipMap | g_DdsCapsComplex;
+
+	std::string temporaryName = filename + ".tmp";
+	std::ofstream file(temporaryName.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "Could not write texture cache file:" << filename << std::endl;
+		return(false);
+	}
+
+	file.write((const char*)&g_DdsMagic, sizeof(g_DdsMagic));
+	file.write((const char*)&header, sizeof(header));
+	for (int level = 0; level < levelCount; level++)
+	{
+		file.write((const char*)levels[level].data(), levels[level].size());
+	}
+	file.close();
+
+	if ((!file) || (std::rename(temporaryName.c_str(), filename.c_str()) != 0))
+	{
+		std::remove(temporaryName.c_str());
+		std::cout << "Could not write texture cache file:" << filename << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  MapFile()
+ *
+ *  This method is used for mapping the contents of a file
+ *  into memory, so the levels are read straight from the
+ *  operating system's file cache without being copied.
+ ***********************************************************/
+bool TextureCache::MapFile(const std::string& filename)
+{
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileA(
+		filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return(false);
+	}
+
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(fileHandle, &fileSize) == FALSE) || (fileSize.QuadPart == 0))
+	{
+		CloseHandle(fileHandle);
+		return(false);
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mappingHandle == NULL)
+	{
+		CloseHandle(fileHandle);
+		return(false);
+	}
+
+	void* pView = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (pView == NULL)
+	{
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return(false);
+	}
+
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_pMapped = (const unsigned char*)pView;
+	m_mappedSize = (size_t)fileSize.QuadPart;
+#else
+	int fileDescriptor = open(filename.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return(false);
+	}
+
+	struct stat fileStatus;
+	if ((fstat(fileDescriptor, &fileStatus) != 0) || (fileStatus.st_size == 0))
+	{
+		close(fileDescriptor);
+		return(false);
+	}
+
+	void* pView = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	// the mapping stays valid after the descriptor is closed
+	close(fileDescriptor);
+	if (pView == MAP_FAILED)
+	{
+		return(false);
+	}
+
+	m_pMapped = (const unsigned char*)pView;
+	m_mappedSize = (size_t)fileStatus.st_size;
+#endif
+
+	return(true);
+}
+
+/***********************************************************
+ *  Open()
+ *
+ *  This method is used for memory-mapping a cached texture
+ *  file and finding its mipmap levels.  False is returned
+ *  when the file does not exist or is not a complete DXT1
+ *  or DXT5 DDS file.
+ ***********************************************************/
+bool TextureCache::Open(const std::string& filename)
+{
+	Close();
+
+	if (MapFile(filename) == false)
+	{
+		return(false);
+	}
+
+	uint32_t magic = 0;
+	DDS_HEADER header;
+	if (m_mappedSize < sizeof(magic) + sizeof(header))
+	{
+		Close();
+		return(false);
+	}
+	memcpy(&magic, m_pMapped, sizeof(magic));
+	memcpy(&header, m_pMapped + sizeof(magic), sizeof(header));
+
+	size_t blockSize = 0;
+	if (header.pixelFormat.fourCC == g_FourCCDxt1)
+	{
+		m_format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		blockSize = 8;
+	}
+	else if (header.pixelFormat.fourCC == g_FourCCDxt5)
+	{
+		m_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		blockSize = 16;
+	}
+	if ((magic != g_DdsMagic) || (header.size != sizeof(DDS_HEADER)) || (blockSize == 0))
+	{
+		Close();
+		return(false);
+	}
+
+	int levelCount = 1;
+	if ((header.flags & g_DdsdMipMapCount) && (header.mipMapCount > 0))
+	{
+		levelCount = (int)header.mipMapCount;
+	}
+
+	size_t offset = sizeof(magic) + sizeof(header);
+	int width = (int)header.width;
+	int height = (int)header.height;
+	for (int level = 0; level < levelCount; level++)
+	{
+		CACHED_LEVEL cachedLevel;
+		size_t levelSize = CompressedLevelSize(width, height, blockSize);
+
+		if (offset + levelSize > m_mappedSize)
+		{
+			Close();
+			return(false);
+		}
+
+		cachedLevel.width = width;
+		cachedLevel.height = height;
+		cachedLevel.data = m_pMapped + offset;
+		cachedLevel.size = (GLsizei)levelSize;
+		m_levels.push_back(cachedLevel);
+
+		offset += levelSize;
+		width = (width > 1) ? width / 2 : 1;
+		height = (height > 1) ? height / 2 : 1;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  UploadLevels()
+ *
+ *  This method is used for uploading every mipmap level of
+ *  the opened file into the texture bound to GL_TEXTURE_2D.
+ ***********************************************************/
+void TextureCache::UploadLevels() const
+{
+	for (size_t level = 0; level < m_levels.size(); level++)
+	{
+		glCompressedTexImage2D(
+			GL_TEXTURE_2D,
+			(GLint)level,
+			m_format,
+			m_levels[level].width,
+			m_levels[level].height,
+			0,
+			m_levels[level].size,
+			m_levels[level].data);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)m_levels.size() - 1);
+}
+
+/***********************************************************
+ *  Close()
+ *
+ *  This method is used for unmapping the opened file.
+ ***********************************************************/
+void TextureCache::Close()
+{
+	if (m_pMapped)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_pMapped);
+		CloseHandle((HANDLE)m_mappingHandle);
+		CloseHandle((HANDLE)m_fileHandle);
+		m_mappingHandle = NULL;
+		m_fileHandle = NULL;
+#else
+		munmap((void*)m_pMapped, m_mappedSize);
+#endif
+	}
+	m_pMapped = NULL;
+	m_mappedSize = 0;
+	m_format = 0;
+	m_levels.clear();
+}
+
+/***********************************************************
+ *  GetWidth()
+ *
+ *  This method is used for getting the width of the opened
+ *  texture.
+ ***********************************************************/
+int TextureCache::GetWidth() const
+{
+	return(m_levels.empty() ? 0 : m_levels[0].width);
+}
+
+/***********************************************************
+ *  GetHeight()
+ *
+ *  This method is used for getting the height of the opened
+ *  texture.
+ ***********************************************************/
+int TextureCache::GetHeight() const
+{
+	return(m_levels.empty() ? 0 : m_levels[0].height);
+}
+
+/***********************************************************
+ *  GetLevelCount()
+ *
+ *  This method is used for getting the number of mipmap
+ *  levels stored in the opened file.
+ ***********************************************************/
+int TextureCache::GetLevelCount() const
+{
+	return((int)m_levels.size());
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.h
+// ============
+// store and load compressed textures with their full mip chain
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TextureCache
+ *
+ *  This class reads and writes DDS files holding a texture in
+ *  a GPU-ready compressed format (DXT1 or DXT5) along with
+ *  every mipmap level.  A cached file is memory-mapped and its
+ *  levels are uploaded directly, so the source image never
+ *  needs to be decoded and no mipmaps need to be generated.
+ *  Cached files are named by a hash of the source file, so an
+ *  edited source file is cached again under a new name.
+ ***********************************************************/
+class TextureCache
+{
+public:
+	// constructor
+	TextureCache();
+	// destructor
+	~TextureCache();
+
+private:
+	// one mipmap level inside the mapped file
+	struct CACHED_LEVEL
+	{
+		int width;
+		int height;
+		const unsigned char* data;
+		GLsizei size;
+	};
+
+	// mapped contents of the opened file
+	const unsigned char* m_pMapped;
+	size_t m_mappedSize;
+#ifdef _WIN32
+	void* m_fileHandle;
+	void* m_mappingHandle;
+#endif
+	// compressed format of the opened file
+	GLenum m_format;
+	// mipmap levels of the opened file
+	std::vector<CACHED_LEVEL> m_levels;
+
+	// map a file into memory
+	bool MapFile(const std::string& filename);
+
+public:
+	// calculate the hash of a source file's contents
+	static bool HashFile(const std::string& filename, uint64_t& hash);
+	// get the path of the cache file for a source file hash
+	static std::string GetCachePath(const std::string& cacheDirectory, uint64_t hash);
+	// create the cache directory when it does not exist
+	static void CreateCacheDirectory(const std::string& cacheDirectory);
+	// get the compressed internal format used for the channels
+	static GLenum GetCompressedFormat(int colorChannels);
+	// compress every mipmap level of the bound texture
+	static bool CompressBoundTexture(int colorChannels);
+	// write the bound compressed texture and its mipmaps to a file
+	static bool WriteBoundTexture(const std::string& filename);
+
+	// memory-map a cached texture file
+	bool Open(const std::string& filename);
+	// upload every level of the opened file to the bound texture
+	void UploadLevels() const;
+	// unmap the opened file
+	void Close();
+
+	// get the size of the opened texture
+	int GetWidth() const;
+	int GetHeight() const;
+	// get the number of mipmap levels of the opened texture
+	int GetLevelCount() const;
+};
@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.cpp
+// ============
+// decode texture image files in parallel and stage them for upload
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureLoader.h"
+
+#include "stb_image.h"
+
+#include <chrono>
+#include <cstring>
+
+/***********************************************************
+ *  TextureLoader()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureLoader::TextureLoader()
+{
+	m_nextFile = 0;
+	m_returnedImages = 0;
+	m_pixelBuffer = 0;
+	m_unpackAlignment = 4;
+}
+
+/***********************************************************
+ *  ~TextureLoader()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureLoader::~TextureLoader()
+{
+	Finish();
+	DestroyPixelBuffer();
+}
+
+/***********************************************************
+ *  AddFile()
+ *
+ *  This method is used for adding an image file to be
+ *  decoded when the loader is started.
+ ***********************************************************/
+void TextureLoader::AddFile(const std::string& filename, const std::string& tag)
+{
+	IMAGE_FILE file;
+	file.filename = filename;
+	file.tag = tag;
+	m_files.push_back(file);
+}
+
+/***********************************************************
+ *  SetCacheDirectory()
+ *
+ *  This method is used for setting the directory of the
+ *  compressed texture cache.  A file found in the cache is
+ *  memory-mapped instead of being decoded, and an empty
+ *  directory turns the cache off.
+ ***********************************************************/
+void TextureLoader::SetCacheDirectory(const std::string& cacheDirectory)
+{
+	m_cacheDirectory = cacheDirectory;
+	if (m_cacheDirectory.empty() == false)
+	{
+		TextureCache::CreateCacheDirectory(m_cacheDirectory);
+	}
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for starting the worker threads, one
+ *  per hardware thread but never more than there are files.
+ ***********************************************************/
+void TextureLoader::Start()
+{
+	int workerCount = (int)std::thread::hardware_concurrency();
+
+	if (workerCount < 1)
+	{
+		workerCount = 1;
+	}
+	if (workerCount > (int)m_files.size())
+	{
+		workerCount = (int)m_files.size();
+	}
+
+	// the flip setting is shared by all the threads, so it is set
+	// once before any of them start decoding
+	stbi_set_flip_vertically_on_load(true);
+
+	m_nextFile = 0;
+	m_returnedImages = 0;
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&TextureLoader::DecodeFiles, this));
+	}
+}
+
+/***********************************************************
+ *  DecodeFiles()
+ *
+ *  This method is run by each worker thread.  It takes the
+ *  next file that no other worker has taken, maps it from the
+ *  texture cache or decodes it, and queues the result for the
+ *  OpenGL thread.
+ ***********************************************************/
+void TextureLoader::DecodeFiles()
+{
+	int fileIndex = m_nextFile++;
+
+	while (fileIndex < (int)m_files.size())
+	{
+		DECODED_IMAGE image;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		image.filename = m_files[fileIndex].filename;
+		image.tag = m_files[fileIndex].tag;
+		image.width = 0;
+		image.height = 0;
+		image.colorChannels = 0;
+		image.pixels = NULL;
+		image.pCachedTexture = NULL;
+
+		// the cache file is named by the hash of the source file
+		uint64_t hash = 0;
+		if ((m_cacheDirectory.empty() == false) &&
+			(TextureCache::HashFile(image.filename, hash) == true))
+		{
+			image.cachePath = TextureCache::GetCachePath(m_cacheDirectory, hash);
+
+			TextureCache* pCachedTexture = new TextureCache();
+			if (pCachedTexture->Open(image.cachePath) == true)
+			{
+				image.pCachedTexture = pCachedTexture;
+				image.width = pCachedTexture->GetWidth();
+				image.height = pCachedTexture->GetHeight();
+			}
+			else
+			{
+				delete pCachedTexture;
+			}
+		}
+
+		if (image.pCachedTexture == NULL)
+		{
+			image.pixels = stbi_load(
+				image.filename.c_str(),
+				&image.width,
+				&image.height,
+				&image.colorChannels,
+				0);
+		}
+
+		std::chrono::duration<double, std::milli> elapsed =
+			std::chrono::steady_clock::now() - start;
+		image.decodeMilliseconds = elapsed.count();
+
+		{
+			std::lock_guard<std::mutex> lock(m_decodedMutex);
+			m_decoded.push(image);
+		}
+		m_decodedReady.notify_one();
+
+		fileIndex = m_nextFile++;
+	}
+}
+
+/***********************************************************
+ *  GetNextImage()
+ *
+ *  This method is used for waiting until the next decoded
+ *  image is available.  Images are returned in the order they
+ *  finish decoding, and false is returned once every added
+ *  file has been returned.
+ ***********************************************************/
+bool TextureLoader::GetNextImage(DECODED_IMAGE& image)
+{
+	if (m_returnedImages >= (int)m_files.size())
+	{
+		return(false);
+	}
+
+	std::unique_lock<std::mutex> lock(m_decodedMutex);
+	while (m_decoded.empty() == true)
+	{
+		m_decodedReady.wait(lock);
+	}
+
+	image = m_decoded.front();
+	m_decoded.pop();
+	m_returnedImages++;
+
+	return(true);
+}
+
+/***********************************************************
+ *  FreeImage()
+ *
+ *  This method is used for freeing the pixels of a decoded
+ *  image once they have been uploaded.
+ ***********************************************************/
+void TextureLoader::FreeImage(DECODED_IMAGE& image)
+{
+	if (image.pixels)
+	{
+		stbi_image_free(image.pixels);
+		image.pixels = NULL;
+	}
+	if (image.pCachedTexture)
+	{
+		delete image.pCachedTexture;
+		image.pCachedTexture = NULL;
+	}
+}
+
+/***********************************************************
+ *  Finish()
+ *
+ *  This method is used for waiting for the worker threads to
+ *  end and freeing any image that was never returned.
+ ***********************************************************/
+void TextureLoader::Finish()
+{
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		m_workers[i].join();
+	}
+	m_workers.clear();
+
+	while (m_decoded.empty() == false)
+	{
+		FreeImage(m_decoded.front());
+		m_decoded.pop();
+	}
+	m_files.clear();
+	m_returnedImages = 0;
+}
+
+/***********************************************************
+ *  StagePixels()
+ *
+ *  This method is used for copying pixels into the pixel
+ *  buffer object, which is left bound so that the following
+ *  glTexImage2D() call reads from it at offset 0 instead of
+ *  from client memory.  The buffer storage is orphaned first,
+ *  so the copy never waits on a previous upload.  The rows of
+ *  the pixels are not padded, so the unpack alignment is set
+ *  to 1 - with the default of 4, an RGB image whose width is
+ *  not a multiple of 4 would be read past the buffer's end.
+ ***********************************************************/
+void TextureLoader::StagePixels(const unsigned char* pixels, size_t byteCount)
+{
+	if (m_pixelBuffer == 0)
+	{
+		glGenBuffers(1, &m_pixelBuffer);
+	}
+
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &m_unpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, byteCount, NULL, GL_STREAM_DRAW);
+
+	void* mapped = glMapBufferRange(
+		GL_PIXEL_UNPACK_BUFFER,
+		0,
+		byteCount,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (mapped)
+	{
+		memcpy(mapped, pixels, byteCount);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+	else
+	{
+		glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, byteCount, pixels);
+	}
+}
+
+/***********************************************************
+ *  EndStaging()
+ *
+ *  This method is used for unbinding the pixel buffer object
+ *  so that later uploads read from client memory again, with
+ *  the unpack alignment they had before.
+ ***********************************************************/
+void TextureLoader::EndStaging()
+{
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, m_unpackAlignment);
+}
+
+/***********************************************************
+ *  DestroyPixelBuffer()
+ *
+ *  This method is used for freeing the pixel buffer object.
+ ***********************************************************/
+void TextureLoader::DestroyPixelBuffer()
+{
+	if (m_pixelBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_pixelBuffer);
+		m_pixelBuffer = 0;
+	}
+}
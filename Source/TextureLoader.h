@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.h
+// ============
+// decode texture image files in parallel and stage them for upload
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextureCache.h"
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  TextureLoader
+ *
+ *  This class decodes the added image files on a pool of
+ *  worker threads.  Each decoded image is handed to the
+ *  OpenGL thread through a queue as soon as it is ready, so
+ *  uploading overlaps with the decoding of the other files,
+ *  and the pixels are uploaded through a pixel buffer object.
+ ***********************************************************/
+class TextureLoader
+{
+public:
+	// constructor
+	TextureLoader();
+	// destructor
+	~TextureLoader();
+
+	// one decoded image file
+	struct DECODED_IMAGE
+	{
+		std::string filename;
+		std::string tag;
+		// decoded pixels, NULL when the file could not be read
+		unsigned char* pixels;
+		int width;
+		int height;
+		int colorChannels;
+		// time spent decoding the file on its worker thread
+		double decodeMilliseconds;
+		// mapped compressed texture, used instead of the pixels
+		// when the file was found in the texture cache
+		TextureCache* pCachedTexture;
+		// cache file the uploaded texture should be written to,
+		// empty when the texture cache is not used
+		std::string cachePath;
+	};
+
+private:
+	// one added image file
+	struct IMAGE_FILE
+	{
+		std::string filename;
+		std::string tag;
+	};
+
+	// image files waiting to be decoded
+	std::vector<IMAGE_FILE> m_files;
+	// index of the next file a worker decodes
+	std::atomic<int> m_nextFile;
+	// worker threads decoding the files
+	std::vector<std::thread> m_workers;
+
+	// decoded images waiting for the OpenGL thread
+	std::queue<DECODED_IMAGE> m_decoded;
+	std::mutex m_decodedMutex;
+	std::condition_variable m_decodedReady;
+	// number of images handed to the OpenGL thread
+	int m_returnedImages;
+
+	// pixel buffer object used for streaming the uploads
+	GLuint m_pixelBuffer;
+	// unpack alignment to restore after an upload
+	GLint m_unpackAlignment;
+	// directory of the compressed texture cache, empty when
+	// the cache is not used
+	std::string m_cacheDirectory;
+
+	// decode files until none are left
+	void DecodeFiles();
+
+public:
+	// add an image file to be decoded
+	void AddFile(const std::string& filename, const std::string& tag);
+	// look for the files in a compressed texture cache first
+	void SetCacheDirectory(const std::string& cacheDirectory);
+	// start decoding the added files on the worker threads
+	void Start();
+	// wait for the next decoded image - false when every added
+	// file has already been returned
+	bool GetNextImage(DECODED_IMAGE& image);
+	// free the pixels or cached texture of a decoded image
+	void FreeImage(DECODED_IMAGE& image);
+	// wait for the worker threads and forget the added files
+	void Finish();
+
+	// copy tightly packed pixels into the pixel buffer and
+	// leave it bound for the next texture upload
+	void StagePixels(const unsigned char* pixels, size_t byteCount);
+	// unbind the pixel buffer after the upload, and restore the
+	// unpack alignment
+	void EndStaging();
+	// free the pixel buffer
+	void DestroyPixelBuffer();
+};
@@ -0,0 +1,296 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformcache.cpp
+// ============
+// cache the model matrices of the scene objects
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformCache.h"
+
+#include <glm/gtx/transform.hpp>
+
+/***********************************************************
+ *  TransformCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformCache::TransformCache()
+{
+	m_bAnyDirty = false;
+	m_lastRecomputed = 0;
+}
+
+/***********************************************************
+ *  ~TransformCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TransformCache::~TransformCache()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  ComputeMatrix()
+ *
+ *  This method is used for calculating a matrix from the
+ *  passed in transformation values.
+ ***********************************************************/
+glm::mat4 TransformCache::ComputeMatrix(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 scale;
+	glm::mat4 rotationX;
+	glm::mat4 rotationY;
+	glm::mat4 rotationZ;
+	glm::mat4 translation;
+
+	// set the scale value in the transform buffer
+	scale = glm::scale(scaleXYZ);
+	// set the rotation values in the transform buffer
+	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+	// set the translation value in the transform buffer
+	translation = glm::translate(positionXYZ);
+
+	return(translation * rotationX * rotationY * rotationZ * scale);
+}
+
+/***********************************************************
+ *  AddTransform()
+ *
+ *  This method is used for adding a transform to the cache.
+ *  The new transform is calculated on the next update.
+ ***********************************************************/
+int TransformCache::AddTransform(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	TRANSFORM_NODE node;
+
+	node.scaleXYZ = scaleXYZ;
+	node.rotationDegrees = glm::vec3(XrotationDegrees, YrotationDegrees, ZrotationDegrees);
+	node.positionXYZ = positionXYZ;
+	node.parent = -1;
+	node.parentBind = glm::mat4(1.0f);
+	node.localMatrix = glm::mat4(1.0f);
+	node.worldMatrix = glm::mat4(1.0f);
+	node.bDirty = true;
+	node.bChanged = false;
+
+	m_transforms.push_back(node);
+	m_bAnyDirty = true;
+
+	return((int)m_transforms.size() - 1);
+}
+
+/***********************************************************
+ *  SetParent()
+ *
+ *  This method is used for attaching a transform to a parent
+ *  transform so it follows the parent whenever the parent is
+ *  moved.  The current world placement of the transform is
+ *  kept.  The parent must have been added before the child.
+ ***********************************************************/
+bool TransformCache::SetParent(int index, int parent)
+{
+	if ((index < 0) || (index >= (int)m_transforms.size()) ||
+		(parent >= index))
+	{
+		return(false);
+	}
+
+	// the current world matrices are needed for keeping the
+	// child in place when it is attached
+	UpdateTransforms();
+
+	TRANSFORM_NODE& node = m_transforms[index];
+	node.parent = parent;
+	if (parent >= 0)
+	{
+		node.parentBind = glm::inverse(m_transforms[parent].worldMatrix);
+	}
+	else
+	{
+		node.parentBind = glm::mat4(1.0f);
+	}
+	MarkDirty(index);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetScale()
+ *
+ *  This method is used for changing the scale of a transform.
+ ***********************************************************/
+void TransformCache::SetScale(int index, glm::vec3 scaleXYZ)
+{
+	if ((index >= 0) && (index < (int)m_transforms.size()))
+	{
+		m_transforms[index].scaleXYZ = scaleXYZ;
+		MarkDirty(index);
+	}
+}
+
+/***********************************************************
+ *  SetRotation()
+ *
+ *  This method is used for changing the rotation of a
+ *  transform.
+ ***********************************************************/
+void TransformCache::SetRotation(
+	int index,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees)
+{
+	if ((index >= 0) && (index < (int)m_transforms.size()))
+	{
+		m_transforms[index].rotationDegrees = glm::vec3(XrotationDegrees, YrotationDegrees, ZrotationDegrees);
+		MarkDirty(index);
+	}
+}
+
+/***********************************************************
+ *  SetPosition()
+ *
+ *  This method is used for changing the position of a
+ *  transform.
+ ***********************************************************/
+void TransformCache::SetPosition(int index, glm::vec3 positionXYZ)
+{
+	if ((index >= 0) && (index < (int)m_transforms.size()))
+	{
+		m_transforms[index].positionXYZ = positionXYZ;
+		MarkDirty(index);
+	}
+}
+
+/***********************************************************
+ *  MarkDirty()
+ *
+ *  This method is used for flagging a transform so that its
+ *  matrices are recalculated on the next update.
+ ***********************************************************/
+void TransformCache::MarkDirty(int index)
+{
+	m_transforms[index].bDirty = true;
+	m_bAnyDirty = true;
+}
+
+/***********************************************************
+ *  UpdateTransforms()
+ *
+ *  This method is used for recalculating the matrices of the
+ *  transforms that have changed, along with the world matrices
+ *  of their children.  When nothing has changed, no matrix
+ *  work is done at all.  The number of recalculated world
+ *  matrices is returned.
+ ***********************************************************/
+int TransformCache::UpdateTransforms()
+{
+	m_lastRecomputed = 0;
+
+	if (m_bAnyDirty == false)
+	{
+		return(0);
+	}
+
+	for (size_t i = 0; i < m_transforms.size(); i++)
+	{
+		TRANSFORM_NODE& node = m_transforms[i];
+		bool bParentChanged = false;
+
+		if (node.parent >= 0)
+		{
+			bParentChanged = m_transforms[node.parent].bChanged;
+		}
+
+		node.bChanged = false;
+		if (node.bDirty == true)
+		{
+			node.localMatrix = ComputeMatrix(
+				node.scaleXYZ,
+				node.rotationDegrees.x,
+				node.rotationDegrees.y,
+				node.rotationDegrees.z,
+				node.positionXYZ);
+		}
+
+		if ((node.bDirty == true) || (bParentChanged == true))
+		{
+			if (node.parent >= 0)
+			{
+				node.worldMatrix = m_transforms[node.parent].worldMatrix * node.parentBind * node.localMatrix;
+			}
+			else
+			{
+				node.worldMatrix = node.localMatrix;
+			}
+			node.bDirty = false;
+			node.bChanged = true;
+			m_lastRecomputed++;
+		}
+	}
+
+	m_bAnyDirty = false;
+
+	return(m_lastRecomputed);
+}
+
+/***********************************************************
+ *  GetWorldMatrix()
+ *
+ *  This method is used for getting the calculated world
+ *  matrix of a transform.
+ ***********************************************************/
+const glm::mat4& TransformCache::GetWorldMatrix(int index) const
+{
+	return(m_transforms[index].worldMatrix);
+}
+
+/***********************************************************
+ *  GetTransformCount()
+ *
+ *  This method is used for getting the number of cached
+ *  transforms.
+ ***********************************************************/
+int TransformCache::GetTransformCount() const
+{
+	return((int)m_transforms.size());
+}
+
+/***********************************************************
+ *  GetLastRecomputedCount()
+ *
+ *  This method is used for getting the number of world
+ *  matrices recalculated by the last update.
+ ***********************************************************/
+int TransformCache::GetLastRecomputedCount() const
+{
+	return(m_lastRecomputed);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all the cached transforms.
+ ***********************************************************/
+void TransformCache::Clear()
+{
+	m_transforms.clear();
+	m_bAnyDirty = false;
+	m_lastRecomputed = 0;
+}
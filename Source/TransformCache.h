@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformcache.h
+// ============
+// cache the model matrices of the scene objects
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  TransformCache
+ *
+ *  This class contains the transformation values of the
+ *  scene objects along with their calculated matrices.  A
+ *  matrix is only recalculated when its values, or the
+ *  values of its parent, have been changed.
+ ***********************************************************/
+class TransformCache
+{
+public:
+	// constructor
+	TransformCache();
+	// destructor
+	~TransformCache();
+
+	struct TRANSFORM_NODE
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+		// index of the parent transform, -1 when there is none
+		int parent;
+		// inverse of the parent world matrix at the time the
+		// transform was attached, so attaching does not move it
+		glm::mat4 parentBind;
+		glm::mat4 localMatrix;
+		glm::mat4 worldMatrix;
+		// true when the transformation values have changed
+		bool bDirty;
+		// true when the world matrix changed in the last update
+		bool bChanged;
+	};
+
+private:
+	// cached transforms - a parent always precedes its children
+	std::vector<TRANSFORM_NODE> m_transforms;
+	// true when at least one transform needs recalculating
+	bool m_bAnyDirty;
+	// number of world matrices recalculated by the last update
+	int m_lastRecomputed;
+
+	// mark the transform as needing recalculation
+	void MarkDirty(int index);
+
+public:
+	// calculate a matrix from the transformation values
+	static glm::mat4 ComputeMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// add a transform and return its index
+	int AddTransform(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// attach a transform to a parent, keeping its world placement
+	bool SetParent(int index, int parent);
+
+	// change the transformation values of a transform
+	void SetScale(int index, glm::vec3 scaleXYZ);
+	void SetRotation(int index, float XrotationDegrees, float YrotationDegrees, float ZrotationDegrees);
+	void SetPosition(int index, glm::vec3 positionXYZ);
+
+	// recalculate the matrices of the changed transforms
+	int UpdateTransforms();
+
+	// get the calculated world matrix of a transform
+	const glm::mat4& GetWorldMatrix(int index) const;
+	// get the number of cached transforms
+	int GetTransformCount() const;
+	// get the number of matrices recalculated by the last update
+	int GetLastRecomputedCount() const;
+	// remove all the cached transforms
+	void Clear();
+};
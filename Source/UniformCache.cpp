@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformcache.cpp
+// ============
+// cache the uniform locations of a loaded shader program
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "UniformCache.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  UniformCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+UniformCache::UniformCache()
+{
+	m_programID = 0;
+	m_lookupCount = 0;
+}
+
+/***********************************************************
+ *  ~UniformCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+UniformCache::~UniformCache()
+{
+	m_locations.clear();
+}
+
+/***********************************************************
+ *  Resolve()
+ *
+ *  This method is used for looking up the locations of all
+ *  the active uniforms in the passed in shader program.  The
+ *  elements of uniform arrays are registered one by one, so
+ *  "lightSources[2].diffuseColor" and "materials[0].shininess"
+ *  can both be found by their full names.
+ ***********************************************************/
+void UniformCache::Resolve(GLuint programID)
+{
+	GLint uniformCount = 0;
+	GLint maxNameLength = 0;
+
+	m_programID = programID;
+	m_locations.clear();
+
+	glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+	glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+	std::vector<GLchar> nameBuffer(maxNameLength + 1);
+	for (GLint i = 0; i < uniformCount; i++)
+	{
+		GLsizei nameLength = 0;
+		GLint arraySize = 0;
+		GLenum type = 0;
+
+		glGetActiveUniform(programID, (GLuint)i, (GLsizei)nameBuffer.size(), &nameLength, &arraySize, &type, nameBuffer.data());
+		std::string name(nameBuffer.data(), nameLength);
+
+		// uniforms inside of uniform blocks have no location
+		GLint location = glGetUniformLocation(programID, name.c_str());
+		m_lookupCount++;
+		if (location < 0)
+		{
+			continue;
+		}
+		m_locations[name] = location;
+
+		// arrays of basic types are reported once as "name[0]",
+		// and their elements have consecutive locations
+		size_t bracket = name.rfind("[0]");
+		if ((arraySize > 1) && (bracket != std::string::npos) && (bracket + 3 == name.size()))
+		{
+			std::string baseName = name.substr(0, bracket);
+			m_locations[baseName] = location;
+			for (GLint element = 1; element < arraySize; element++)
+			{
+				m_locations[baseName + "[" + std::to_string(element) + "]"] = location + element;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  GetHandle()
+ *
+ *  This method is used for getting the pre-resolved handle
+ *  of a uniform.  Names that were not found when the program
+ *  was resolved are looked up once and remembered.
+ ***********************************************************/
+UniformCache::UNIFORM_HANDLE UniformCache::GetHandle(const std::string& name)
+{
+	UNIFORM_HANDLE handle;
+
+	std::unordered_map<std::string, GLint>::const_iterator found = m_locations.find(name);
+	if (found != m_locations.end())
+	{
+		handle.location = found->second;
+		return(handle);
+	}
+
+	// the uniform is not active in the shader, so remember
+	// that it has no location to avoid looking it up again
+	handle.location = glGetUniformLocation(m_programID, name.c_str());
+	m_lookupCount++;
+	m_locations[name] = handle.location;
+
+	return(handle);
+}
+
+/***********************************************************
+ *  SetBool()
+ *
+ *  This method is used for setting a boolean uniform value.
+ ***********************************************************/
+void UniformCache::SetBool(UNIFORM_HANDLE handle, bool value) const
+{
+	glUniform1i(handle.location, (int)value);
+}
+
+/***********************************************************
+ *  SetInt()
+ *
+ *  This method is used for setting an integer uniform value.
+ ***********************************************************/
+void UniformCache::SetInt(UNIFORM_HANDLE handle, int value) const
+{
+	glUniform1i(handle.location, value);
+}
+
+/***********************************************************
+ *  SetFloat()
+ *
+ *  This method is used for setting a float uniform value.
+ ***********************************************************/
+void UniformCache::SetFloat(UNIFORM_HANDLE handle, float value) const
+{
+	glUniform1f(handle.location, value);
+}
+
+/***********************************************************
+ *  SetVec2()
+ *
+ *  This method is used for setting a vec2 uniform value.
+ ***********************************************************/
+void UniformCache::SetVec2(UNIFORM_HANDLE handle, const glm::vec2& value) const
+{
+	glUniform2fv(handle.location, 1, glm::value_ptr(value));
+}
+
+/***********************************************************
+ *  SetVec3()
+ *
+ *  This method is used for setting a vec3 uniform value.
+ ***********************************************************/
+void UniformCache::SetVec3(UNIFORM_HANDLE handle, const glm::vec3& value) const
+{
+	glUniform3fv(handle.location, 1, glm::value_ptr(value));
+}
+
+/***********************************************************
+ *  SetVec4()
+ *
+ *  This method is used for setting a vec4 uniform value.
+ ***********************************************************/
+void UniformCache::SetVec4(UNIFORM_HANDLE handle, const glm::vec4& value) const
+{
+	glUniform4fv(handle.location, 1, glm::value_ptr(value));
+}
+
+/***********************************************************
+ *  SetMat4()
+ *
+ *  This method is used for setting a mat4 uniform value.
+ ***********************************************************/
+void UniformCache::SetMat4(UNIFORM_HANDLE handle, const glm::mat4& value) const
+{
+	glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+/***********************************************************
+ *  SetBool()
+ *
+ *  This method is used for setting a boolean uniform value
+ *  by name, from the cached locations.
+ ***********************************************************/
+void UniformCache::SetBool(const std::string& name, bool value)
+{
+	SetBool(GetHandle(name), value);
+}
+
+/***********************************************************
+ *  SetInt()
+ *
+ *  This method is used for setting an integer uniform value
+ *  by name, from the cached locations.
+ ***********************************************************/
+void UniformCache::SetInt(const std::string& name, int value)
+{
+	SetInt(GetHandle(name), value);
+}
+
+/***********************************************************
+ *  SetFloat()
+ *
+ *  This method is used for setting a float uniform value by
+ *  name, from the cached locations.
+ ***********************************************************/
+void UniformCache::SetFloat(const std::string& name, float value)
+{
+	SetFloat(GetHandle(name), value);
+}
+
+/***********************************************************
+ *  SetVec3()
+ *
+ *  This method is used for setting a vec3 uniform value by
+ *  name, from the cached locations.
+ ***********************************************************/
+void UniformCache::SetVec3(const std::string& name, const glm::vec3& value)
+{
+	SetVec3(GetHandle(name), value);
+}
+
+/***********************************************************
+ *  GetProgramID()
+ *
+ *  This method is used for getting the shader program that
+ *  the cached locations belong to.
+ ***********************************************************/
+GLuint UniformCache::GetProgramID() const
+{
+	return(m_programID);
+}
+
+/***********************************************************
+ *  GetLookupCount()
+ *
+ *  This method is used for getting the number of calls to
+ *  glGetUniformLocation() since the last reset.
+ ***********************************************************/
+int UniformCache::GetLookupCount() const
+{
+	return(m_lookupCount);
+}
+
+/***********************************************************
+ *  ResetLookupCount()
+ *
+ *  This method is used for resetting the number of calls to
+ *  glGetUniformLocation().
+ ***********************************************************/
+void UniformCache::ResetLookupCount()
+{
+	m_lookupCount = 0;
+}
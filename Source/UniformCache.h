@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////
+// uniformcache.h
+// ============
+// cache the uniform locations of a loaded shader program
+//
+//  AUTHOR: CS-330 Final Project Team / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 16th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <unordered_map>
+
+/***********************************************************
+ *  UniformCache
+ *
+ *  This class looks up the location of every active uniform
+ *  in a shader program a single time, after the shaders are
+ *  loaded.  The per-draw code then sets the uniforms through
+ *  pre-resolved handles, without any string work or calls
+ *  to glGetUniformLocation().
+ ***********************************************************/
+class UniformCache
+{
+public:
+	// constructor
+	UniformCache();
+	// destructor
+	~UniformCache();
+
+	// pre-resolved location of one uniform
+	struct UNIFORM_HANDLE
+	{
+		GLint location;
+	};
+
+private:
+	// shader program the locations belong to
+	GLuint m_programID;
+	// locations of the active uniforms, by name
+	std::unordered_map<std::string, GLint> m_locations;
+	// number of glGetUniformLocation() calls since the last reset
+	int m_lookupCount;
+
+public:
+	// look up the locations of all active uniforms in the program
+	void Resolve(GLuint programID);
+	// get the handle of a uniform, which is -1 when the uniform
+	// is not used by the shader
+	UNIFORM_HANDLE GetHandle(const std::string& name);
+
+	// set uniform values through pre-resolved handles
+	void SetBool(UNIFORM_HANDLE handle, bool value) const;
+	void SetInt(UNIFORM_HANDLE handle, int value) const;
+	void SetFloat(UNIFORM_HANDLE handle, float value) const;
+	void SetVec2(UNIFORM_HANDLE handle, const glm::vec2& value) const;
+	void SetVec3(UNIFORM_HANDLE handle, const glm::vec3& value) const;
+	void SetVec4(UNIFORM_HANDLE handle, const glm::vec4& value) const;
+	void SetMat4(UNIFORM_HANDLE handle, const glm::mat4& value) const;
+
+	// set uniform values by name, for setup code that runs once
+	void SetBool(const std::string& name, bool value);
+	void SetInt(const std::string& name, int value);
+	void SetFloat(const std::string& name, float value);
+	void SetVec3(const std::string& name, const glm::vec3& value);
+
+	// get the shader program the locations belong to
+	GLuint GetProgramID() const;
+	// get and reset the number of glGetUniformLocation() calls
+	int GetLookupCount() const;
+	void ResetLookupCount();
+};
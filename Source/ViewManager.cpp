@@ -32,10 +32,6 @@ namespace
 	float gLastY = WINDOW_HEIGHT / 2.0f;
 	bool gFirstMouse = true;
 
-	// time between current frame and last frame
-	float gDeltaTime = 0.0f; 
-	float gLastFrame = 0.0f;
-
 	// the following variable is false when orthographic projection
 	// is off and true when it is on
 	bool bOrthographicProjection = false;
@@ -51,7 +47,16 @@ ViewManager::ViewManager(
 {
 	// initialize the member variables
 	m_pShaderManager = pShaderManager;
+	m_pUniformCache = NULL;
+	m_pFrameProfiler = NULL;
+	m_viewHandle.location = -1;
+	m_projectionHandle.location = -1;
+	m_viewPositionHandle.location = -1;
 	m_pWindow = NULL;
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_bOcclusionCulling = false;
+	m_bOcclusionKeyDown = false;
 	g_pCamera = new Camera();
 	// default camera view parameters
 	g_pCamera->Position = glm::vec3(0.0f, 5.0f, 12.0f);
@@ -59,6 +64,8 @@ ViewManager::ViewManager(
 	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
 	g_pCamera->Zoom = 80;
 	g_pCamera->MovementSpeed = 20;
+	m_previousCameraPosition = g_pCamera->Position;
+	m_viewPosition = g_pCamera->Position;
 }
 
 /***********************************************************
@@ -70,6 +77,8 @@ ViewManager::~ViewManager()
 {
 	// free up allocated memory
 	m_pShaderManager = NULL;
+	m_pUniformCache = NULL;
+	m_pFrameProfiler = NULL;
 	m_pWindow = NULL;
 	if (NULL != g_pCamera)
 	{
@@ -163,10 +172,19 @@ void ViewManager::Mouse_Scroll_Wheel_Callback(GLFWwindow* window, double xoffset
  *  ProcessKeyboardEvents()
  *
  *  This method is called to process any keyboard events
- *  that may be waiting in the event queue.
+ *  that may be waiting in the event queue.  The camera moves
+ *  by its speed times the passed in step time.
  ***********************************************************/
-void ViewManager::ProcessKeyboardEvents()
+void ViewManager::ProcessKeyboardEvents(float stepSeconds)
 {
+	ProfileScope profileScope(m_pFrameProfiler, "View.Input");
+
+	// there are no keyboard events without a display window
+	if (NULL == m_pWindow)
+	{
+		return;
+	}
+
 	// close the window if the escape key has been pressed
 	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
 	{
@@ -186,41 +204,78 @@ void ViewManager::ProcessKeyboardEvents()
 		bOrthographicProjection = true;
 	}
 
+	// toggle occlusion culling once for each press of the key
+	if (glfwGetKey(m_pWindow, GLFW_KEY_C) == GLFW_PRESS)
+	{
+		if (m_bOcclusionKeyDown == false)
+		{
+			SetOcclusionCullingEnabled(!m_bOcclusionCulling);
+		}
+		m_bOcclusionKeyDown = true;
+	}
+	else
+	{
+		m_bOcclusionKeyDown = false;
+	}
+
 	// process camera zooming in and out
 	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
 	{
 		// zoom in on 3D scene
-		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
+		g_pCamera->ProcessKeyboard(FORWARD, stepSeconds);
 	}
 	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
 	{
 		// zoom out on 3D scene
-		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
+		g_pCamera->ProcessKeyboard(BACKWARD, stepSeconds);
 	}
 
 	// process camera panning left and right
 	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
 	{
 		// move left in 3D scene
-		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
+		g_pCamera->ProcessKeyboard(LEFT, stepSeconds);
 	}
 	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
 	{
 		// move right in 3D scene
-		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
+		g_pCamera->ProcessKeyboard(RIGHT, stepSeconds);
 	}
 
 	if (glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS)
 
 	{	// move up in 3D scene
-		g_pCamera->ProcessKeyboard(UP, gDeltaTime);
+		g_pCamera->ProcessKeyboard(UP, stepSeconds);
 	}
 
 	if (glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS)
 	{
 		// move down in 3D scene
-		g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);
+		g_pCamera->ProcessKeyboard(DOWN, stepSeconds);
+	}
+}
+
+/***********************************************************
+ *  UpdateCamera()
+ *
+ *  This method is used for moving the camera by one fixed
+ *  simulation step.  The main loop calls it as many times as
+ *  the elapsed time needs, so the camera moves the same at
+ *  any frame rate.  The position before the step is kept for
+ *  placing the rendered frames between the steps.
+ ***********************************************************/
+void ViewManager::UpdateCamera(float stepSeconds)
+{
+	if (NULL == g_pCamera)
+	{
+		return;
 	}
+
+	m_previousCameraPosition = g_pCamera->Position;
+
+	// process any keyboard events that may be waiting in the 
+	// event queue
+	ProcessKeyboardEvents(stepSeconds);
 }
 
 /***********************************************************
@@ -228,24 +283,21 @@ void ViewManager::ProcessKeyboardEvents()
  *
  *  This method is used for preparing the 3D scene by loading
  *  the shapes, textures in memory to support the 3D scene 
- *  rendering
+ *  rendering.  The camera is viewed from between its last
+ *  two steps, at the passed in fraction of a step that the
+ *  frame pacer has not simulated yet, so the motion stays
+ *  smooth when the frame rate and the step rate differ.
  ***********************************************************/
-void ViewManager::PrepareSceneView()
+void ViewManager::PrepareSceneView(float interpolationAlpha)
 {
 	glm::mat4 view;
 	glm::mat4 projection;
 
-	// per-frame timing
-	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
-	gLastFrame = currentFrame;
-
-	// process any keyboard events that may be waiting in the 
-	// event queue
-	ProcessKeyboardEvents();
+	// place the camera between its last two steps
+	m_viewPosition = glm::mix(m_previousCameraPosition, g_pCamera->Position, interpolationAlpha);
 
-	// get the current view matrix from the camera
-	view = g_pCamera->GetViewMatrix();
+	// get the current view matrix from the interpolated camera
+	view = glm::lookAt(m_viewPosition, m_viewPosition + g_pCamera->Front, g_pCamera->Up);
 
 	// define the current projection matrix based on projection type from inputs
 	if (bOrthographicProjection) {
@@ -262,14 +314,177 @@ void ViewManager::PrepareSceneView()
 
 	}
 
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
+	// keep the matrices for the scene code that needs them
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+
+	// the rest of the method sets the view values into the shader
+	ProfileScope profileScope(m_pFrameProfiler, "Shader.ViewUniforms");
+
+	// if the cached uniform locations are available
+	if (NULL != m_pUniformCache)
+	{
+		// set the view matrix into the shader for proper rendering
+		m_pUniformCache->SetMat4(m_viewHandle, view);
+		// set the view matrix into the shader for proper rendering
+		m_pUniformCache->SetMat4(m_projectionHandle, projection);
+		// set the view position of the camera into the shader for proper rendering
+		m_pUniformCache->SetVec3(m_viewPositionHandle, m_viewPosition);
+	}
+	// otherwise if the shader manager object is valid
+	else if (NULL != m_pShaderManager)
 	{
 		// set the view matrix into the shader for proper rendering
 		m_pShaderManager->setMat4Value(g_ViewName, view);
 		// set the view matrix into the shader for proper rendering
 		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
 		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		m_pShaderManager->setVec3Value("viewPosition", m_viewPosition);
 	}
-}
\ No newline at end of file
+}
+
+/***********************************************************
+ *  SetUniformCache()
+ *
+ *  This method is used for setting the cached uniform
+ *  locations of the shader and resolving the handles of the
+ *  view values that are set every frame.
+ ***********************************************************/
+void ViewManager::SetUniformCache(UniformCache* pUniformCache)
+{
+	m_pUniformCache = pUniformCache;
+
+	if (NULL != m_pUniformCache)
+	{
+		m_viewHandle = m_pUniformCache->GetHandle(g_ViewName);
+		m_projectionHandle = m_pUniformCache->GetHandle(g_ProjectionName);
+		m_viewPositionHandle = m_pUniformCache->GetHandle("viewPosition");
+	}
+}
+
+/***********************************************************
+ *  SetFrameProfiler()
+ *
+ *  This method is used for setting the profiler that measures
+ *  the CPU and GPU time of the view setup.
+ ***********************************************************/
+void ViewManager::SetFrameProfiler(FrameProfiler* pFrameProfiler)
+{
+	m_pFrameProfiler = pFrameProfiler;
+}
+
+/***********************************************************
+ *  GetViewMatrix()
+ *
+ *  This method is used for getting the view matrix that was
+ *  calculated for the current frame.
+ ***********************************************************/
+glm::mat4 ViewManager::GetViewMatrix() const
+{
+	return(m_viewMatrix);
+}
+
+/***********************************************************
+ *  GetProjectionMatrix()
+ *
+ *  This method is used for getting the projection matrix that
+ *  was calculated for the current frame.
+ ***********************************************************/
+glm::mat4 ViewManager::GetProjectionMatrix() const
+{
+	return(m_projectionMatrix);
+}
+
+/***********************************************************
+ *  GetCameraPosition()
+ *
+ *  This method is used for getting the position the current
+ *  frame is viewed from.
+ ***********************************************************/
+glm::vec3 ViewManager::GetCameraPosition() const
+{
+	return(m_viewPosition);
+}
+
+/***********************************************************
+ *  GetCameraTarget()
+ *
+ *  This method is used for getting the point one unit in
+ *  front of the position the current frame is viewed from,
+ *  such as for recording a camera path.
+ ***********************************************************/
+glm::vec3 ViewManager::GetCameraTarget() const
+{
+	if (NULL == g_pCamera)
+	{
+		return(m_viewPosition + glm::vec3(0.0f, 0.0f, -1.0f));
+	}
+	return(m_viewPosition + glm::normalize(g_pCamera->Front));
+}
+
+/***********************************************************
+ *  SetCameraPose()
+ *
+ *  This method is used for placing the camera at a position
+ *  and turning it to look at a target, such as for following
+ *  a scripted camera path.  The yaw and pitch are derived
+ *  from the new front vector, so later mouse movement turns
+ *  the camera on from this pose, and the camera vectors are
+ *  updated from them.  The camera does not move between the
+ *  steps, so the pose is not interpolated from the old one.
+ ***********************************************************/
+void ViewManager::SetCameraPose(const glm::vec3& position, const glm::vec3& target)
+{
+	if (NULL == g_pCamera)
+	{
+		return;
+	}
+
+	glm::vec3 front = glm::normalize(target - position);
+
+	g_pCamera->Position = position;
+	g_pCamera->Yaw = glm::degrees(atan2f(front.z, front.x));
+	g_pCamera->Pitch = glm::degrees(asinf(glm::clamp(front.y, -1.0f, 1.0f)));
+	// moving the mouse by nothing recalculates the front, right
+	// and up vectors from the yaw and pitch, with the pitch kept
+	// short of straight up or down like the mouse look
+	g_pCamera->ProcessMouseMovement(0.0f, 0.0f);
+
+	m_previousCameraPosition = position;
+	m_viewPosition = position;
+}
+
+/***********************************************************
+ *  GetDisplaySize()
+ *
+ *  This method is used for getting the width and height of
+ *  the display that the projection is made for.
+ ***********************************************************/
+void ViewManager::GetDisplaySize(int& width, int& height)
+{
+	width = WINDOW_WIDTH;
+	height = WINDOW_HEIGHT;
+}
+
+/***********************************************************
+ *  SetOcclusionCullingEnabled()
+ *
+ *  This method is used for switching the occlusion culling of
+ *  the scene on or off.
+ ***********************************************************/
+void ViewManager::SetOcclusionCullingEnabled(bool bEnabled)
+{
+	m_bOcclusionCulling = bEnabled;
+	std::cout << "INFO: occlusion culling " << (bEnabled ? "on" : "off") << std::endl;
+}
+
+/***********************************************************
+ *  IsOcclusionCullingEnabled()
+ *
+ *  This method is used for checking whether the scene hides
+ *  objects behind large occluders.
+ ***********************************************************/
+bool ViewManager::IsOcclusionCullingEnabled() const
+{
+	return(m_bOcclusionCulling);
+}
@@ -10,6 +10,8 @@
 #pragma once
 
 #include "ShaderManager.h"
+#include "UniformCache.h"
+#include "FrameProfiler.h"
 #include "camera.h"
 
 // GLFW library
@@ -33,16 +35,58 @@ public:
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
+	// pointer to the cached uniform locations of the shader
+	UniformCache* m_pUniformCache;
+	// pointer to the profiler measuring the view setup
+	FrameProfiler* m_pFrameProfiler;
+	// pre-resolved handles of the uniforms set every frame
+	UniformCache::UNIFORM_HANDLE m_viewHandle;
+	UniformCache::UNIFORM_HANDLE m_projectionHandle;
+	UniformCache::UNIFORM_HANDLE m_viewPositionHandle;
 	// active OpenGL display window
 	GLFWwindow* m_pWindow;
+	// view and projection matrices of the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	// camera position before the last simulation step, and
+	// the position the current frame is viewed from
+	glm::vec3 m_previousCameraPosition;
+	glm::vec3 m_viewPosition;
+	// true when the scene hides objects behind large occluders
+	bool m_bOcclusionCulling;
+	// true while the occlusion culling key is held down
+	bool m_bOcclusionKeyDown;
 
 	// process keyboard events for interaction with the 3D scene
-	void ProcessKeyboardEvents();
+	void ProcessKeyboardEvents(float stepSeconds);
 
 public:
 	// create the initial OpenGL display window
 	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
 	
-	// prepare the conversion from 3D object display to 2D scene display
-	void PrepareSceneView();
+	// move the camera by one fixed simulation step
+	void UpdateCamera(float stepSeconds);
+	// prepare the conversion from 3D object display to 2D scene display,
+	// placing the camera between its last two steps
+	void PrepareSceneView(float interpolationAlpha);
+
+	// set the cached uniform locations used for the view values
+	void SetUniformCache(UniformCache* pUniformCache);
+	// set the profiler that measures the view setup
+	void SetFrameProfiler(FrameProfiler* pFrameProfiler);
+
+	// get the view values calculated for the current frame
+	glm::mat4 GetViewMatrix() const;
+	glm::mat4 GetProjectionMatrix() const;
+	glm::vec3 GetCameraPosition() const;
+	// get the point a unit in front of the camera
+	glm::vec3 GetCameraTarget() const;
+	// place the camera at a position, looking at a target
+	void SetCameraPose(const glm::vec3& position, const glm::vec3& target);
+	// get the size of the display the projection is made for
+	static void GetDisplaySize(int& width, int& height);
+
+	// switch occlusion culling on or off - the C key toggles it
+	void SetOcclusionCullingEnabled(bool bEnabled);
+	bool IsOcclusionCullingEnabled() const;
 };
\ No newline at end of file
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// cullingShader.glsl
+// ============
+// cull the instanced objects against the view frustum and count the
+// visible ones into indirect draw commands
+///////////////////////////////////////////////////////////////////////////////
+
+#version 440 core
+
+// number of levels of detail, matching PrimitiveMeshes::LOD_COUNT
+#define LOD_COUNT 3
+
+layout (local_size_x = 64) in;
+
+// one culled object, with its world space bounds
+struct CullObject
+{
+	vec4 center;
+	vec4 extent;
+	uint firstCommand;
+	int lodCount;
+	int lod;
+	int padding;
+};
+
+// per-draw data record, matching PrimitiveMeshes::INSTANCE_DATA
+struct DrawRecord
+{
+	mat4 modelMatrix;
+	vec4 color;
+	vec2 uvScale;
+	int materialIndex;
+	int padding;
+};
+
+// indirect draw command, as read by glMultiDrawElementsIndirect
+struct DrawCommand
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+layout (std430, binding = 5) buffer CullObjectBuffer
+{
+	CullObject objects[];
+};
+layout (std430, binding = 6) readonly buffer RecordBuffer
+{
+	DrawRecord records[];
+};
+layout (std430, binding = 7) writeonly buffer VisibleRecordBuffer
+{
+	DrawRecord visibleRecords[];
+};
+layout (std430, binding = 8) buffer CommandBuffer
+{
+	DrawCommand commands[];
+};
+
+uniform uint objectCount;
+// planes as (normal, distance), with the normals pointing
+// into the frustum
+uniform vec4 frustumPlanes[6];
+uniform vec3 cameraPosition;
+uniform float projectionScale;
+uniform bool bPerspective = true;
+uniform float lodScreenSizes[LOD_COUNT - 1];
+uniform float lodHysteresis;
+
+// get the finest level of detail whose threshold the screen
+// size reaches
+int LodForScreenSize(float screenSize, float thresholdScale)
+{
+	for (int lod = 0; lod < LOD_COUNT - 1; lod++)
+	{
+		if (screenSize >= lodScreenSizes[lod] * thresholdScale)
+		{
+			return(lod);
+		}
+	}
+
+	return(LOD_COUNT - 1);
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+
+	if (index >= objectCount)
+	{
+		return;
+	}
+
+	vec3 center = objects[index].center.xyz;
+	vec3 extent = objects[index].extent.xyz;
+
+	// the box is outside when it is entirely behind one plane
+	for (int i = 0; i < 6; i++)
+	{
+		vec4 plane = frustumPlanes[i];
+		if (dot(plane.xyz, center) + dot(abs(plane.xyz), extent) + plane.w < 0.0f)
+		{
+			return;
+		}
+	}
+
+	// a finer level needs a size well above its threshold, and
+	// a coarser level a size well below it
+	int lod = objects[index].lod;
+	int lodCount = objects[index].lodCount;
+	if (lodCount > 1)
+	{
+		float screenSize = length(extent) * projectionScale;
+		if (bPerspective == true)
+		{
+			screenSize = screenSize / max(distance(cameraPosition, center), 0.001f);
+		}
+
+		int finerLod = LodForScreenSize(screenSize, 1.0f + lodHysteresis);
+		int coarserLod = LodForScreenSize(screenSize, 1.0f - lodHysteresis);
+		if (finerLod < lod)
+		{
+			lod = finerLod;
+		}
+		else if (coarserLod > lod)
+		{
+			lod = coarserLod;
+		}
+		lod = min(lod, lodCount - 1);
+		objects[index].lod = lod;
+	}
+	else
+	{
+		lod = 0;
+	}
+
+	// the object takes the next free record of its command
+	uint command = objects[index].firstCommand + uint(lod);
+	uint slot = atomicAdd(commands[command].instanceCount, 1u);
+	visibleRecords[commands[command].baseInstance + slot] = records[index];
+}
@@ -0,0 +1,264 @@
+///////////////////////////////////////////////////////////////////////////////
+// fragmentShader.glsl
+// ============
+// color the pixels of the 3D scene with textures, materials and lights
+///////////////////////////////////////////////////////////////////////////////
+
+#version 440 core
+
+#define MAX_LIGHTS 16
+#define MAX_MATERIALS 256
+// size of the light cluster grid, matching ClusteredLighting
+#define CLUSTER_COUNT_X 16
+#define CLUSTER_COUNT_Y 9
+#define CLUSTER_COUNT_Z 24
+// shadow cascades of the directional light, matching
+// ShadowCascades and SceneManager
+#define MAX_SHADOW_CASCADES 4
+#define SHADOW_LIGHT_INDEX 0
+
+// std140 layout shared with SceneManager::GPU_MATERIAL
+struct Material
+{
+	vec3 ambientColor;
+	float ambientStrength;
+	vec3 diffuseColor;
+	float padding;
+	vec3 specularColor;
+	float shininess;
+};
+
+// std140 layout shared with LightManager::GPU_LIGHT
+struct LightSource
+{
+	vec3 position;
+	float focalStrength;
+	// direction the light travels in, for a directional light
+	vec3 direction;
+	float specularIntensity;
+	vec3 ambientColor;
+	// 0 for a point light, 1 for a directional light
+	int type;
+	vec3 diffuseColor;
+	float padding0;
+	vec3 specularColor;
+	float padding1;
+};
+
+// std430 layout shared with ClusteredLighting::POINT_LIGHT
+struct PointLight
+{
+	vec3 position;
+	float radius;
+	vec3 ambientColor;
+	float focalStrength;
+	vec3 diffuseColor;
+	float specularIntensity;
+	vec3 specularColor;
+	float padding;
+};
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+flat in int fragmentMaterialIndex;
+flat in vec4 fragmentColor;
+flat in vec2 fragmentUVScale;
+in float fragmentViewDepth;
+
+out vec4 outFragmentColor;
+
+uniform bool bUseTexture = false;
+uniform bool bUseLighting = false;
+uniform sampler2D objectTexture;
+// textures packed into array layers, used instead of objectTexture
+uniform bool bUseTextureArray = false;
+uniform sampler2DArray objectTextureArray;
+uniform int textureLayer = 0;
+uniform vec3 viewPosition;
+
+// every defined material, uploaded once and selected by index
+layout (std140, binding = 1) uniform MaterialBlock
+{
+	Material materials[MAX_MATERIALS];
+};
+
+// scene light sources, only re-sent when they change
+layout (std140, binding = 2) uniform LightBlock
+{
+	int lightCount;
+	LightSource lightSources[MAX_LIGHTS];
+};
+
+// shadow maps of the directional light, one array layer per
+// cascade, and the view depth at which each cascade ends
+uniform bool bUseShadows = false;
+uniform int shadowCascadeCount = 0;
+uniform float shadowSplitDepths[MAX_SHADOW_CASCADES];
+uniform mat4 shadowMatrices[MAX_SHADOW_CASCADES];
+uniform float shadowTexelSizes[MAX_SHADOW_CASCADES];
+uniform sampler2DArrayShadow shadowMap;
+
+// point lights, and the range of the light index list that
+// holds the lights touching each cluster
+uniform bool bUseClusteredLights = false;
+uniform vec2 clusterTileSize;
+uniform float clusterDepthScale;
+uniform float clusterDepthBias;
+layout (std430, binding = 2) readonly buffer PointLightBuffer
+{
+	PointLight pointLights[];
+};
+layout (std430, binding = 3) readonly buffer ClusterBuffer
+{
+	uvec2 clusters[];
+};
+layout (std430, binding = 4) readonly buffer LightIndexBuffer
+{
+	uint lightIndices[];
+};
+
+vec3 CalcLightSource(LightSource light, Material surface, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection, float shadow);
+float CalcShadow(vec3 lightNormal, vec3 vertexPosition);
+vec3 CalcPointLight(PointLight light, Material surface, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection);
+
+void main()
+{
+	vec4 baseColor = fragmentColor;
+
+	if (bUseTexture == true)
+	{
+		if (bUseTextureArray == true)
+		{
+			baseColor = texture(objectTextureArray, vec3(fragmentTextureCoordinate * fragmentUVScale, textureLayer));
+		}
+		else
+		{
+			baseColor = texture(objectTexture, fragmentTextureCoordinate * fragmentUVScale);
+		}
+	}
+
+	if (bUseLighting == true)
+	{
+		Material surface = materials[clamp(fragmentMaterialIndex, 0, MAX_MATERIALS - 1)];
+
+		vec3 lightNormal = normalize(fragmentVertexNormal);
+		vec3 viewDirection = normalize(viewPosition - fragmentPosition);
+		vec3 phongResult = vec3(0.0f);
+
+		for (int i = 0; i < min(lightCount, MAX_LIGHTS); i++)
+		{
+			float shadow = 1.0f;
+			if ((i == SHADOW_LIGHT_INDEX) && (bUseShadows == true))
+			{
+				shadow = CalcShadow(lightNormal, fragmentPosition);
+			}
+			phongResult += CalcLightSource(lightSources[i], surface, lightNormal, fragmentPosition, viewDirection, shadow);
+		}
+
+		// only the point lights listed for this pixel's cluster
+		// can reach it
+		if (bUseClusteredLights == true)
+		{
+			ivec3 cluster = ivec3(
+				int(gl_FragCoord.x / clusterTileSize.x),
+				int(gl_FragCoord.y / clusterTileSize.y),
+				int(floor(log(max(fragmentViewDepth, 0.0001f)) * clusterDepthScale + clusterDepthBias)));
+			cluster = clamp(cluster, ivec3(0), ivec3(CLUSTER_COUNT_X - 1, CLUSTER_COUNT_Y - 1, CLUSTER_COUNT_Z - 1));
+			uvec2 range = clusters[(cluster.z * CLUSTER_COUNT_Y + cluster.y) * CLUSTER_COUNT_X + cluster.x];
+
+			for (uint i = 0; i < range.y; i++)
+			{
+				phongResult += CalcPointLight(pointLights[lightIndices[range.x + i]], surface, lightNormal, fragmentPosition, viewDirection);
+			}
+		}
+
+		outFragmentColor = vec4(phongResult * baseColor.xyz, baseColor.w);
+	}
+	else
+	{
+		outFragmentColor = baseColor;
+	}
+}
+
+vec3 CalcLightSource(LightSource light, Material surface, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection, float shadow)
+{
+	// ambient lighting
+	vec3 ambient = light.ambientColor * surface.ambientColor * surface.ambientStrength;
+
+	// diffuse lighting - a directional light reaches every
+	// point from the same direction
+	vec3 lightDirection = normalize(light.position - vertexPosition);
+	if (light.type == 1)
+	{
+		lightDirection = normalize(-light.direction);
+	}
+	float impact = max(dot(lightNormal, lightDirection), 0.0f);
+	vec3 diffuse = impact * light.diffuseColor * surface.diffuseColor;
+
+	// specular lighting
+	vec3 reflectDirection = reflect(-lightDirection, lightNormal);
+	float specularComponent = pow(max(dot(viewDirection, reflectDirection), 0.0f), max(light.focalStrength, 1.0f));
+	vec3 specular = light.specularIntensity * specularComponent * light.specularColor * surface.specularColor * surface.shininess;
+
+	// the ambient light still reaches the shadowed surfaces
+	return(ambient + (diffuse + specular) * shadow);
+}
+
+float CalcShadow(vec3 lightNormal, vec3 vertexPosition)
+{
+	// the first cascade that reaches past the pixel holds it
+	int cascade = 0;
+	while ((cascade < shadowCascadeCount) && (fragmentViewDepth > shadowSplitDepths[cascade]))
+	{
+		cascade++;
+	}
+	if (cascade >= shadowCascadeCount)
+	{
+		return(1.0f);
+	}
+
+	// the position is pushed out along the normal by a texel or
+	// so, which keeps a lit surface from shadowing itself
+	vec3 offsetPosition = vertexPosition + lightNormal * shadowTexelSizes[cascade] * 1.5f;
+	vec4 shadowPosition = shadowMatrices[cascade] * vec4(offsetPosition, 1.0f);
+	vec3 shadowCoordinate = (shadowPosition.xyz / shadowPosition.w) * 0.5f + 0.5f;
+	if (shadowCoordinate.z > 1.0f)
+	{
+		return(1.0f);
+	}
+
+	// the comparisons of the 3x3 texels around the pixel are
+	// averaged to soften the shadow edges
+	vec2 texelSize = 1.0f / vec2(textureSize(shadowMap, 0).xy);
+	float lit = 0.0f;
+	for (int y = -1; y <= 1; y++)
+	{
+		for (int x = -1; x <= 1; x++)
+		{
+			lit += texture(shadowMap, vec4(shadowCoordinate.xy + vec2(x, y) * texelSize, float(cascade), shadowCoordinate.z));
+		}
+	}
+
+	return(lit / 9.0f);
+}
+
+vec3 CalcPointLight(PointLight light, Material surface, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection)
+{
+	// the light fades out smoothly and reaches zero at its radius
+	float lightDistance = length(light.position - vertexPosition);
+	float falloff = clamp(1.0f - (lightDistance * lightDistance) / (light.radius * light.radius), 0.0f, 1.0f);
+	falloff = falloff * falloff;
+
+	vec3 ambient = light.ambientColor * surface.ambientColor * surface.ambientStrength;
+
+	vec3 lightDirection = normalize(light.position - vertexPosition);
+	float impact = max(dot(lightNormal, lightDirection), 0.0f);
+	vec3 diffuse = impact * light.diffuseColor * surface.diffuseColor;
+
+	vec3 reflectDirection = reflect(-lightDirection, lightNormal);
+	float specularComponent = pow(max(dot(viewDirection, reflectDirection), 0.0f), max(light.focalStrength, 1.0f));
+	vec3 specular = light.specularIntensity * specularComponent * light.specularColor * surface.specularColor * surface.shininess;
+
+	return((ambient + diffuse + specular) * falloff);
+}
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+// vertexShader.glsl
+// ============
+// transform the mesh vertices of the 3D scene
+///////////////////////////////////////////////////////////////////////////////
+
+#version 440 core
+
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+// per-draw data record, only read when instancing is enabled
+layout (location = 3) in mat4 inInstanceModel;
+layout (location = 7) in int inInstanceMaterial;
+layout (location = 8) in vec4 inInstanceColor;
+layout (location = 9) in vec2 inInstanceUVScale;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+flat out int fragmentMaterialIndex;
+flat out vec4 fragmentColor;
+flat out vec2 fragmentUVScale;
+// distance in front of the camera, used for the light clusters
+out float fragmentViewDepth;
+
+uniform bool bUseInstancing = false;
+// values used for the whole draw when instancing is disabled
+uniform int materialIndex = 0;
+uniform vec4 objectColor = vec4(1.0f);
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+	mat4 modelMatrix = model;
+
+	fragmentMaterialIndex = materialIndex;
+	fragmentColor = objectColor;
+	fragmentUVScale = UVscale;
+	if (bUseInstancing == true)
+	{
+		modelMatrix = inInstanceModel;
+		fragmentMaterialIndex = inInstanceMaterial;
+		fragmentColor = inInstanceColor;
+		fragmentUVScale = inInstanceUVScale;
+	}
+
+	// transform the vertex into clip space
+	gl_Position = projection * view * modelMatrix * vec4(inVertexPosition, 1.0f);
+
+	// world space values used for the lighting calculations
+	fragmentPosition = vec3(modelMatrix * vec4(inVertexPosition, 1.0f));
+	fragmentVertexNormal = mat3(transpose(inverse(modelMatrix))) * inVertexNormal;
+	fragmentTextureCoordinate = inTextureCoordinate;
+	fragmentViewDepth = -(view * vec4(fragmentPosition, 1.0f)).z;
+}